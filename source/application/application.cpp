@@ -5,58 +5,109 @@ namespace nes
 {
    bool Application::update()
    {
-      if (not visualiser_.update(memory_, processor_))
+      if (not visualiser_.update(memory_, processor_, predecode_index_))
          return false;
 
       if (visualiser_.tick_repeatedly())
       {
          if (not emulation_thread_.joinable())
-            emulation_thread_ = std::jthread{ std::bind_front(&Application::try_tick_repeatedly, this) };
+            emulation_thread_ = std::jthread{ std::bind_front(&Application::tick_repeatedly, this) };
       }
       else if (emulation_thread_.joinable())
-      {
-         emulation_thread_.request_stop();
-         emulation_thread_.join();
-      }
+         stop_emulation();
       else if (visualiser_.tick_once())
-         try_tick();
+         tick();
       else if (visualiser_.step())
-         try_step();
+         step();
       else if (visualiser_.reset())
          processor_.reset();
 
       if (visualiser_.load_program_requested())
-         memory_.load_program(visualiser_.program_path(), visualiser_.program_load_address());
+         load_program();
 
       return true;
    }
 
-   void Application::handle_exception(UnsupportedOpcode const& exception, std::source_location source_location) const
+   void Application::load_program()
    {
-      logger_.error(exception.what(), false, std::move(source_location));
+      // Loading writes to the memory, which drops blocks the emulation thread may be executing. Inserting a
+      // cartridge also remaps the page table, frees the devices of the one before and resets the processor.
+      stop_emulation();
+      if (visualiser_.program_path().extension() == ".nes")
+         return load_cartridge();
+
+      console_.reset();
+      auto const start{ std::chrono::steady_clock::now() };
+      predecode_index_.load_program(visualiser_.program_path(), visualiser_.program_load_address());
+      std::chrono::duration<double, std::milli> const elapsed{ std::chrono::steady_clock::now() - start };
+
+      logger_.info(std::format("indexed {} instructions {} in {:.1f} ms", predecode_index_.instructions(),
+         predecode_index_.from_cache() ? "from the cache" : "by tracing", elapsed.count()));
+   }
+
+   void Application::load_cartridge()
+   {
+      auto cartridge{ Cartridge::load(visualiser_.program_path()) };
+      if (not cartridge)
+      {
+         logger_.error(std::format("cannot load {}: {}", visualiser_.program_path().string(), cartridge.error()));
+         return;
+      }
+
+      Cartridge::Header const& header{ (*cartridge)->header() };
+      logger_.info(std::format("inserted a mapper {} cartridge with {} KiB of PRG ROM and {} KiB of CHR ROM",
+         header.mapper, header.prg_rom_size / 1024, header.chr_rom_size / 1024));
+
+      if (not console_)
+         console_.emplace(memory_);
+
+      console_->insert(std::move(*cartridge));
+      processor_.reset();
    }
 
-   void Application::try_tick() try
+   void Application::stop_emulation()
    {
-      processor_.tick();
+      // the thread is started again by the next update for as long as the processor is to tick repeatedly
+      if (not emulation_thread_.joinable())
+         return;
+
+      emulation_thread_.request_stop();
+      emulation_thread_.join();
    }
-   catch (UnsupportedOpcode const& exception)
+
+   void Application::report(HaltReason const& halt_reason) const
    {
-      handle_exception(exception);
+      std::string const message{ std::format("processor {} (0x{:02X}) at 0x{:04X}", halt_reason.description(),
+         halt_reason.opcode, halt_reason.program_counter) };
+
+      // test programs trap on purpose to signal they are done, only a jam or an unsupported opcode is a failure
+      if (halt_reason.cause == HaltReason::Cause::TRAP)
+         logger_.info(message);
+      else
+         logger_.error(message);
    }
 
-   void Application::try_tick_repeatedly(std::stop_token const& stop_token)
+   void Application::tick()
    {
-      while (not stop_token.stop_requested())
-         try_tick();
+      if (auto const completed{ processor_.tick() }; not completed)
+         report(completed.error());
    }
 
-   void Application::try_step() try
+   void Application::tick_repeatedly(std::stop_token const& stop_token)
    {
-      while (not processor_.tick());
+      // a halted processor is reported once and left alone until it is run again
+      while (not stop_token.stop_requested())
+         if (auto const cycles{ processor_.run(CYCLES_PER_RUN) }; not cycles)
+         {
+            report(cycles.error());
+            return;
+         }
    }
-   catch (UnsupportedOpcode const& exception)
+
+   void Application::step()
    {
-      handle_exception(exception);
+      // bounded like a run of the emulation thread, as a jammed processor spends all of the budget
+      if (auto const cycles{ processor_.run_until([] { return true; }, CYCLES_PER_RUN) }; not cycles)
+         report(cycles.error());
    }
 }
\ No newline at end of file
@@ -2,8 +2,9 @@
 #define APPLICATION_HPP
 
 #include "application.hpp"
-#include "exceptions/unsupported_opcode.hpp"
+#include "hardware/console/console.hpp"
 #include "hardware/memory/memory.hpp"
+#include "hardware/processor/predecode_index.hpp"
 #include "hardware/processor/processor.hpp"
 #include "services/locator.hpp"
 #include "services/visualiser/visualiser.hpp"
@@ -25,18 +26,25 @@ namespace nes
          bool update();
 
       private:
-         void handle_exception(UnsupportedOpcode const& exception,
-            std::source_location source_location = std::source_location::current()) const;
+         void report(HaltReason const& halt_reason) const;
 
-         void try_tick();
-         void try_tick_repeatedly(std::stop_token const& stop_token);
-         void try_step();
+         void tick();
+         void tick_repeatedly(std::stop_token const& stop_token);
+         void step();
+         void stop_emulation();
+         void load_program();
+         void load_cartridge();
+
+         static Cycle constexpr CYCLES_PER_RUN{ 1'000'000 };
 
          Visualiser& visualiser_{ *Locator::get<Visualiser>() };
          Logger& logger_{ *Locator::get<Logger>() };
 
          Memory memory_{};
          Processor processor_{ memory_ };
+         PredecodeIndex predecode_index_{ memory_ };
+         // only there while a cartridge is loaded, flat binaries getting all of memory
+         std::optional<Console> console_{};
          std::jthread emulation_thread_{};
    };
 }
@@ -1,14 +0,0 @@
-#include "unsupported_opcode.hpp"
-
-namespace nes
-{
-   UnsupportedOpcode::UnsupportedOpcode(ProgramCounter const program_counter, Byte const opcode, std::source_location location)
-      : EmulationException{
-         program_counter,
-         std::format("encountered an unsupported 0x{:02X} opcode at 0x{:04X}", opcode, program_counter),
-         std::move(location)
-      }
-      , opcode{ opcode }
-   {
-   }
-}
\ No newline at end of file
@@ -0,0 +1,295 @@
+#include "cartridge.hpp"
+#include "cnrom.hpp"
+#include "mmc1.hpp"
+#include "mmc3.hpp"
+#include "nrom.hpp"
+#include "uxrom.hpp"
+
+namespace nes
+{
+   std::expected<Cartridge::Header, std::string> Cartridge::parse_header(std::span<Byte const> const image)
+   {
+      std::array<Byte, 4> constexpr MAGIC{ 'N', 'E', 'S', 0x1A };
+      if (image.size() < HEADER_SIZE or not std::ranges::equal(MAGIC, image.first(MAGIC.size())))
+         return std::unexpected{ "not an iNES image" };
+
+      Byte const flags_6{ image[6] };
+      Byte const flags_7{ image[7] };
+      Header header{
+         .format{ (flags_7 & 0x0C) == 0x08 ? Format::NES_2_0 : Format::INES },
+         .mapper{ static_cast<std::uint16_t>(flags_6 >> 4 | (flags_7 & 0xF0)) },
+         .submapper{},
+         .prg_rom_size{},
+         .chr_rom_size{},
+         .prg_ram_size{},
+         .chr_ram_size{},
+         .mirroring{
+            flags_6 & 0b10'00
+               ? Mirroring::FOUR_SCREEN
+               : flags_6 & 0b00'01
+                  ? Mirroring::VERTICAL
+                  : Mirroring::HORIZONTAL
+         },
+         .battery{ static_cast<bool>(flags_6 & 0b00'10) },
+         .trainer{ static_cast<bool>(flags_6 & 0b01'00) }
+      };
+
+      if (header.format == Format::INES)
+      {
+         // old dumping tools left their signature in the unused bytes, flags 7 included
+         if (std::ranges::any_of(image.subspan(12, 4), std::identity{}))
+            header.mapper &= 0x0F;
+
+         header.prg_rom_size = image[4] * std::size_t{ 0x40'00 };
+         header.chr_rom_size = image[5] * std::size_t{ 0x20'00 };
+         header.prg_ram_size = std::max<std::size_t>(image[8], 1) * 0x20'00;
+         header.chr_ram_size = header.chr_rom_size ? 0 : 0x20'00;
+      }
+      else
+      {
+         // a most significant nibble of $F gives the size as 2^E * (MM * 2 + 1), from EEEEEEMM in the least
+         // significant byte
+         auto const rom_size{
+            [](Byte const least_significant, Byte const most_significant, std::size_t const unit) -> std::size_t
+            {
+               if (most_significant == 0x0F)
+               {
+                  // an exponent past the largest size supported is refused before it can overflow the shift
+                  std::size_t const exponent{ static_cast<std::size_t>(least_significant >> 2) };
+                  if (exponent >= std::bit_width(MAX_ROM_SIZE))
+                     return MAX_ROM_SIZE + 1;
+
+                  return (std::size_t{ 1 } << exponent) * ((least_significant & 0b11) * 2 + 1);
+               }
+
+               return (static_cast<std::size_t>(most_significant) << 8 | least_significant) * unit;
+            }
+         };
+
+         // RAM sizes are given as shift counts of 64 bytes, 0 meaning none
+         auto const ram_size{
+            [](Byte const shift) -> std::size_t
+            {
+               return shift ? std::size_t{ 64 } << shift : 0;
+            }
+         };
+
+         header.mapper |= static_cast<std::uint16_t>((image[8] & 0x0F) << 8);
+         header.submapper = static_cast<Byte>(image[8] >> 4);
+         header.prg_rom_size = rom_size(image[4], image[9] & 0x0F, 0x40'00);
+         header.chr_rom_size = rom_size(image[5], image[9] >> 4, 0x20'00);
+         header.prg_ram_size = ram_size(image[10] & 0x0F) + ram_size(image[10] >> 4);
+         header.chr_ram_size = ram_size(image[11] & 0x0F) + ram_size(image[11] >> 4);
+      }
+
+      if (header.prg_rom_size > MAX_ROM_SIZE or header.chr_rom_size > MAX_ROM_SIZE)
+         return std::unexpected{ std::format("ROM sizes above the supported {} bytes", MAX_ROM_SIZE) };
+
+      if (not header.prg_rom_size or header.prg_rom_size % Memory::PAGE_SIZE)
+         return std::unexpected{ std::format("unsupported PRG ROM size of {} bytes", header.prg_rom_size) };
+
+      if (header.chr_rom_size % CHR_SLOT_SIZE)
+         return std::unexpected{ std::format("unsupported CHR ROM size of {} bytes", header.chr_rom_size) };
+
+      // each part is checked against what is left of the image, which no sum of the sizes can wrap around
+      std::size_t left{ image.size() - HEADER_SIZE };
+      for (auto const& [part, size] : {
+         std::pair{ "trainer", header.trainer ? TRAINER_SIZE : 0 },
+         std::pair{ "PRG ROM", header.prg_rom_size },
+         std::pair{ "CHR ROM", header.chr_rom_size }
+      })
+      {
+         if (left < size)
+            return std::unexpected{ std::format("image of {} bytes too short for its {}", image.size(), part) };
+
+         left -= size;
+      }
+
+      return header;
+   }
+
+   std::expected<std::unique_ptr<Cartridge>, std::string> Cartridge::load(std::filesystem::path const& path)
+   {
+      auto image{ RomImage::open(path) };
+      if (not image)
+         return std::unexpected{ image.error() };
+
+      return load(std::move(*image));
+   }
+
+   std::expected<std::unique_ptr<Cartridge>, std::string> Cartridge::load(std::span<Byte const> const image)
+   {
+      return load(std::make_unique<RomImage const>(image));
+   }
+
+   std::expected<std::unique_ptr<Cartridge>, std::string> Cartridge::load(std::unique_ptr<RomImage const> image)
+   {
+      std::expected<Header, std::string> const header{ parse_header(image->bytes()) };
+      if (not header)
+         return std::unexpected{ header.error() };
+
+      std::unique_ptr<Cartridge> cartridge{ new Cartridge{ *header, std::move(image) } };
+      cartridge->mapper_ = make_mapper(header->mapper, *cartridge);
+      if (not cartridge->mapper_)
+         return std::unexpected{ std::format("unsupported mapper {}", header->mapper) };
+
+      return cartridge;
+   }
+
+   Cartridge::~Cartridge() noexcept
+   {
+      remove();
+   }
+
+   void Cartridge::insert(Memory& memory)
+   {
+      remove();
+      memory_ = &memory;
+
+      // without PRG RAM, nothing answers there
+      if (prg_ram_.empty())
+         memory.attach(PRG_RAM_FIRST, PRG_RAM_LAST, {});
+      else
+         memory.map(PRG_RAM_FIRST, PRG_RAM_LAST, std::span{ prg_ram_ });
+
+      // the mapper maps its banks over the device taking the writes to its registers
+      memory.attach(PRG_ROM_FIRST, PRG_ROM_LAST, {
+         .read{},
+         .write{ std::bind_front(&Mapper::write, mapper_.get()) }
+      });
+
+      mapper_->reset();
+   }
+
+   void Cartridge::remove() noexcept
+   {
+      if (not memory_)
+         return;
+
+      memory_->unmap(PRG_RAM_FIRST, PRG_ROM_LAST);
+      memory_ = nullptr;
+   }
+
+   Byte Cartridge::read_chr(Word const address) const noexcept
+   {
+      return chr_[chr_slots_[address / CHR_SLOT_SIZE % chr_slots_.size()] + address % CHR_SLOT_SIZE];
+   }
+
+   void Cartridge::write_chr(Word const address, Byte const data) noexcept
+   {
+      // CHR ROM ignores writes
+      if (header_.chr_rom_size)
+         return;
+
+      chr_ram_[chr_slots_[address / CHR_SLOT_SIZE % chr_slots_.size()] + address % CHR_SLOT_SIZE] = data;
+   }
+
+   Cartridge::Mirroring Cartridge::mirroring() const noexcept
+   {
+      return mirroring_;
+   }
+
+   void Cartridge::count_scanline() noexcept
+   {
+      mapper_->count_scanline();
+   }
+
+   bool Cartridge::irq() const noexcept
+   {
+      return mapper_->irq();
+   }
+
+   Cartridge::Header const& Cartridge::header() const noexcept
+   {
+      return header_;
+   }
+
+   std::size_t Cartridge::bank_switches() const noexcept
+   {
+      return bank_switches_;
+   }
+
+   RomImage const& Cartridge::image() const noexcept
+   {
+      return *image_;
+   }
+
+   void Cartridge::map_prg(Word const address, std::size_t const size, int const bank) noexcept
+   {
+      ++bank_switches_;
+      if (not memory_)
+         return;
+
+      std::size_t const offset{ bank_offset(bank, size, prg_rom_.size()) };
+      memory_->map(address, static_cast<Word>(address + size - 1),
+         prg_rom_.subspan(offset, std::min(size, prg_rom_.size())));
+   }
+
+   void Cartridge::map_chr(Word const address, std::size_t const size, int const bank) noexcept
+   {
+      ++bank_switches_;
+      std::size_t const offset{ bank_offset(bank, size, chr_.size()) };
+      for (std::size_t slot{}; slot < size / CHR_SLOT_SIZE; ++slot)
+         chr_slots_[(address / CHR_SLOT_SIZE + slot) % chr_slots_.size()] =
+            (offset + slot * CHR_SLOT_SIZE) % chr_.size();
+   }
+
+   void Cartridge::set_mirroring(Mirroring const mirroring) noexcept
+   {
+      // the extra nametable RAM on the cartridge is wired to the PPU for good
+      if (header_.mirroring not_eq Mirroring::FOUR_SCREEN)
+         mirroring_ = mirroring;
+   }
+
+   Cartridge::Cartridge(Header const& header, std::unique_ptr<RomImage const> image)
+      : header_{ header }
+      , image_{ std::move(image) }
+      , prg_rom_{ image_->bytes().subspan(HEADER_SIZE + (header.trainer ? TRAINER_SIZE : 0), header.prg_rom_size) }
+      , chr_ram_(header.chr_rom_size ? 0 : round_up(std::max<std::size_t>(header.chr_ram_size, 0x20'00), CHR_SLOT_SIZE))
+      , chr_{
+         // the CHR ROM follows the PRG ROM
+         header.chr_rom_size
+            ? std::span{ prg_rom_.data() + prg_rom_.size(), header.chr_rom_size }
+            : std::span<Byte const>{ chr_ram_ }
+      }
+      , prg_ram_(round_up(header.prg_ram_size, Memory::PAGE_SIZE))
+      , mirroring_{ header.mirroring }
+   {
+      map_chr(0x00'00, 0x20'00, 0);
+   }
+
+   std::unique_ptr<Mapper> Cartridge::make_mapper(std::uint16_t const mapper, Cartridge& cartridge)
+   {
+      switch (mapper)
+      {
+         case 0:
+            return std::make_unique<Nrom>(cartridge);
+
+         case 1:
+            return std::make_unique<Mmc1>(cartridge);
+
+         case 2:
+            return std::make_unique<Uxrom>(cartridge);
+
+         case 3:
+            return std::make_unique<Cnrom>(cartridge);
+
+         case 4:
+            return std::make_unique<Mmc3>(cartridge);
+
+         default:
+            return nullptr;
+      }
+   }
+
+   std::size_t Cartridge::round_up(std::size_t const size, std::size_t const unit) noexcept
+   {
+      return (size + unit - 1) / unit * unit;
+   }
+
+   std::size_t Cartridge::bank_offset(int const bank, std::size_t const size, std::size_t const memory_size) noexcept
+   {
+      auto const banks{ static_cast<int>(std::max<std::size_t>(memory_size / size, 1)) };
+      return static_cast<std::size_t>((bank % banks + banks) % banks) * size;
+   }
+}
\ No newline at end of file
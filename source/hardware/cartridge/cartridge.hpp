@@ -0,0 +1,122 @@
+#ifndef CARTRIDGE_HPP
+#define CARTRIDGE_HPP
+
+#include "hardware/memory/memory.hpp"
+#include "hardware/memory/rom_image.hpp"
+#include "hardware/types.hpp"
+#include "mapper.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   // A cartridge from an iNES or NES 2.0 image. Inserted, its PRG RAM is at $6000-$7FFF and its PRG ROM banks at
+   // $8000-$FFFF, both straight in the page table of the memory, while the writes to $8000-$FFFF go to its mapper.
+   // The CHR banks are seen through eight 1 KiB slots, which is where the PPU reads its pattern tables from. The ROMs
+   // are never copied out of the image, so the page table points into the image file where it is mapped.
+   class Cartridge final
+   {
+      public:
+         enum class Format
+         {
+            INES,
+            NES_2_0
+         };
+
+         enum class Mirroring
+         {
+            HORIZONTAL,
+            VERTICAL,
+            SINGLE_SCREEN_LOWER,
+            SINGLE_SCREEN_UPPER,
+            FOUR_SCREEN
+         };
+
+         struct Header final
+         {
+            Format format;
+            std::uint16_t mapper;
+            Byte submapper;
+            std::size_t prg_rom_size;
+            std::size_t chr_rom_size;
+            std::size_t prg_ram_size;
+            std::size_t chr_ram_size;
+            Mirroring mirroring;
+            bool battery;
+            bool trainer;
+         };
+
+         static std::size_t constexpr HEADER_SIZE{ 16 };
+         static std::size_t constexpr TRAINER_SIZE{ 512 };
+         static std::size_t constexpr CHR_SLOT_SIZE{ 0x04'00 };
+         // above anything the header gives without its exponent form, and small enough for bank counts to fit an int
+         static std::size_t constexpr MAX_ROM_SIZE{ 0x04'00'00'00 };
+         static Word constexpr PRG_RAM_FIRST{ 0x60'00 };
+         static Word constexpr PRG_RAM_LAST{ 0x7F'FF };
+         static Word constexpr PRG_ROM_FIRST{ 0x80'00 };
+         static Word constexpr PRG_ROM_LAST{ 0xFF'FF };
+
+         [[nodiscard]] static std::expected<Header, std::string> parse_header(std::span<Byte const> image);
+         [[nodiscard]] static std::expected<std::unique_ptr<Cartridge>, std::string> load(
+            std::filesystem::path const& path);
+         // copies the image
+         [[nodiscard]] static std::expected<std::unique_ptr<Cartridge>, std::string> load(
+            std::span<Byte const> image);
+
+         Cartridge(Cartridge const&) = delete;
+         Cartridge(Cartridge&&) = delete;
+
+         ~Cartridge() noexcept;
+
+         Cartridge& operator=(Cartridge const&) = delete;
+         Cartridge& operator=(Cartridge&&) = delete;
+
+         // maps the cartridge into the memory and resets the mapper; the cartridge has to be removed (or destroyed)
+         // before the memory is
+         void insert(Memory& memory);
+         // maps the RAM at its own addresses back where the cartridge was
+         void remove() noexcept;
+
+         // the pattern tables at $0000-$1FFF of the PPU
+         [[nodiscard]] Byte read_chr(Word address) const noexcept;
+         void write_chr(Word address, Byte data) noexcept;
+         [[nodiscard]] Mirroring mirroring() const noexcept;
+         void count_scanline() noexcept;
+         [[nodiscard]] bool irq() const noexcept;
+
+         [[nodiscard]] Header const& header() const noexcept;
+         [[nodiscard]] std::size_t bank_switches() const noexcept;
+         [[nodiscard]] RomImage const& image() const noexcept;
+
+         // For mappers. Banks are numbered by their size, counted from the end when negative, and wrap around the
+         // memory there is, which is what leaving the upper bits of a bank register unconnected does.
+         void map_prg(Word address, std::size_t size, int bank) noexcept;
+         void map_chr(Word address, std::size_t size, int bank) noexcept;
+         void set_mirroring(Mirroring mirroring) noexcept;
+
+      private:
+         Cartridge(Header const& header, std::unique_ptr<RomImage const> image);
+
+         [[nodiscard]] static std::expected<std::unique_ptr<Cartridge>, std::string> load(
+            std::unique_ptr<RomImage const> image);
+         [[nodiscard]] static std::unique_ptr<Mapper> make_mapper(std::uint16_t mapper, Cartridge& cartridge);
+         [[nodiscard]] static std::size_t round_up(std::size_t size, std::size_t unit) noexcept;
+         [[nodiscard]] static std::size_t bank_offset(int bank, std::size_t size, std::size_t memory_size) noexcept;
+
+         Header const header_;
+         std::unique_ptr<RomImage const> const image_;
+         std::span<Byte const> const prg_rom_;
+         std::vector<Byte> chr_ram_{};
+         // the CHR ROM in the image, or the CHR RAM of cartridges without
+         std::span<Byte const> const chr_;
+         std::vector<Byte> prg_ram_{};
+         std::unique_ptr<Mapper> mapper_{};
+
+         Memory* memory_{};
+         // where in the CHR memory each slot starts
+         std::array<std::size_t, 8> chr_slots_{};
+         Mirroring mirroring_;
+         std::size_t bank_switches_{};
+   };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,22 @@
+#include "cnrom.hpp"
+#include "cartridge.hpp"
+
+namespace nes
+{
+   Cnrom::Cnrom(Cartridge& cartridge) noexcept
+      : Mapper{ cartridge }
+   {
+   }
+
+   void Cnrom::reset() noexcept
+   {
+      cartridge_.map_prg(0x80'00, 0x40'00, 0);
+      cartridge_.map_prg(0xC0'00, 0x40'00, -1);
+      cartridge_.map_chr(0x00'00, 0x20'00, 0);
+   }
+
+   void Cnrom::write(Word, Byte const data) noexcept
+   {
+      cartridge_.map_chr(0x00'00, 0x20'00, data);
+   }
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#ifndef CNROM_HPP
+#define CNROM_HPP
+
+#include "hardware/types.hpp"
+#include "mapper.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   // CNROM: fixed PRG ROM like NROM, with the 8 KiB CHR bank picked by writes to $8000-$FFFF.
+   class Cnrom final : public Mapper
+   {
+      public:
+         explicit Cnrom(Cartridge& cartridge) noexcept;
+         Cnrom(Cnrom const&) = delete;
+         Cnrom(Cnrom&&) = delete;
+
+         virtual ~Cnrom() noexcept override = default;
+
+         Cnrom& operator=(Cnrom const&) = delete;
+         Cnrom& operator=(Cnrom&&) = delete;
+
+         virtual void reset() noexcept override;
+         virtual void write(Word address, Byte data) noexcept override;
+   };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,18 @@
+#include "mapper.hpp"
+
+namespace nes
+{
+   Mapper::Mapper(Cartridge& cartridge) noexcept
+      : cartridge_{ cartridge }
+   {
+   }
+
+   void Mapper::count_scanline() noexcept
+   {
+   }
+
+   bool Mapper::irq() const noexcept
+   {
+      return false;
+   }
+}
\ No newline at end of file
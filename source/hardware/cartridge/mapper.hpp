@@ -0,0 +1,37 @@
+#ifndef MAPPER_HPP
+#define MAPPER_HPP
+
+#include "hardware/types.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   class Cartridge;
+
+   // The bank switching hardware of a cartridge. A mapper decides which PRG and CHR banks are where by pointing the
+   // slots of the cartridge at them, which never copies a bank; its registers take the writes to $8000-$FFFF.
+   class Mapper
+   {
+      public:
+         explicit Mapper(Cartridge& cartridge) noexcept;
+         Mapper(Mapper const&) = delete;
+         Mapper(Mapper&&) = delete;
+
+         virtual ~Mapper() noexcept = default;
+
+         Mapper& operator=(Mapper const&) = delete;
+         Mapper& operator=(Mapper&&) = delete;
+
+         // puts the registers and the banks in their power-up state
+         virtual void reset() noexcept = 0;
+         virtual void write(Word address, Byte data) noexcept = 0;
+         // the PPU finished rendering a scanline, which is what mappers with an IRQ counter count
+         virtual void count_scanline() noexcept;
+         [[nodiscard]] virtual bool irq() const noexcept;
+
+      protected:
+         Cartridge& cartridge_;
+   };
+}
+
+#endif
\ No newline at end of file
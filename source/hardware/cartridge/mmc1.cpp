@@ -0,0 +1,98 @@
+#include "mmc1.hpp"
+#include "cartridge.hpp"
+
+namespace nes
+{
+   Mmc1::Mmc1(Cartridge& cartridge) noexcept
+      : Mapper{ cartridge }
+   {
+   }
+
+   void Mmc1::reset() noexcept
+   {
+      // the last PRG bank is fixed at $C000 from power-up on
+      shift_ = 0;
+      shift_count_ = 0;
+      control_ = 0b0'11'00;
+      chr_bank_0_ = 0;
+      chr_bank_1_ = 0;
+      prg_bank_ = 0;
+      update();
+   }
+
+   void Mmc1::write(Word const address, Byte const data) noexcept
+   {
+      // a write with bit 7 set empties the shift register and fixes the last PRG bank at $C000
+      if (data & 0x80)
+      {
+         shift_ = 0;
+         shift_count_ = 0;
+         control_ |= 0b0'11'00;
+         return update();
+      }
+
+      shift_ = static_cast<Byte>(shift_ >> 1 | (data & 1) << 4);
+      if (++shift_count_ < 5)
+         return;
+
+      switch (address >> 13 & 0b11)
+      {
+         case 0:
+            control_ = shift_;
+            break;
+
+         case 1:
+            chr_bank_0_ = shift_;
+            break;
+
+         case 2:
+            chr_bank_1_ = shift_;
+            break;
+
+         default:
+            prg_bank_ = shift_;
+      }
+
+      shift_ = 0;
+      shift_count_ = 0;
+      update();
+   }
+
+   void Mmc1::update() noexcept
+   {
+      std::array constexpr MIRRORINGS{
+         Cartridge::Mirroring::SINGLE_SCREEN_LOWER,
+         Cartridge::Mirroring::SINGLE_SCREEN_UPPER,
+         Cartridge::Mirroring::VERTICAL,
+         Cartridge::Mirroring::HORIZONTAL
+      };
+      cartridge_.set_mirroring(MIRRORINGS[control_ & 0b11]);
+
+      // bit 4 of the PRG bank register enables the PRG RAM, which is left enabled
+      int const prg_bank{ prg_bank_ & 0x0F };
+      switch (control_ >> 2 & 0b11)
+      {
+         case 0:
+         case 1:
+            cartridge_.map_prg(0x80'00, 0x80'00, prg_bank >> 1);
+            break;
+
+         case 2:
+            cartridge_.map_prg(0x80'00, 0x40'00, 0);
+            cartridge_.map_prg(0xC0'00, 0x40'00, prg_bank);
+            break;
+
+         default:
+            cartridge_.map_prg(0x80'00, 0x40'00, prg_bank);
+            cartridge_.map_prg(0xC0'00, 0x40'00, -1);
+      }
+
+      if (control_ & 0b1'00'00)
+      {
+         cartridge_.map_chr(0x00'00, 0x10'00, chr_bank_0_);
+         cartridge_.map_chr(0x10'00, 0x10'00, chr_bank_1_);
+      }
+      else
+         cartridge_.map_chr(0x00'00, 0x20'00, chr_bank_0_ >> 1);
+   }
+}
\ No newline at end of file
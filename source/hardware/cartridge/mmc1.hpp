@@ -0,0 +1,40 @@
+#ifndef MMC1_HPP
+#define MMC1_HPP
+
+#include "hardware/types.hpp"
+#include "mapper.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   // MMC1 (SxROM). Registers are written a bit at a time through a shift register, the fifth write to $8000-$FFFF
+   // passing the collected bits to the register its address selects. PRG banks are 16 or 32 KiB, CHR banks 4 or 8
+   // KiB. Writes on consecutive cycles are not told apart, so both writes of a read-modify-write instruction count.
+   class Mmc1 final : public Mapper
+   {
+      public:
+         explicit Mmc1(Cartridge& cartridge) noexcept;
+         Mmc1(Mmc1 const&) = delete;
+         Mmc1(Mmc1&&) = delete;
+
+         virtual ~Mmc1() noexcept override = default;
+
+         Mmc1& operator=(Mmc1 const&) = delete;
+         Mmc1& operator=(Mmc1&&) = delete;
+
+         virtual void reset() noexcept override;
+         virtual void write(Word address, Byte data) noexcept override;
+
+      private:
+         void update() noexcept;
+
+         Byte shift_{};
+         Byte shift_count_{};
+         Byte control_{};
+         Byte chr_bank_0_{};
+         Byte chr_bank_1_{};
+         Byte prg_bank_{};
+   };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "mmc3.hpp"
+#include "cartridge.hpp"
+
+namespace nes
+{
+   Mmc3::Mmc3(Cartridge& cartridge) noexcept
+      : Mapper{ cartridge }
+   {
+   }
+
+   void Mmc3::reset() noexcept
+   {
+      bank_select_ = 0;
+      banks_ = { 0, 2, 4, 5, 6, 7, 0, 1 };
+      irq_latch_ = 0;
+      irq_counter_ = 0;
+      irq_reload_ = false;
+      irq_enabled_ = false;
+      irq_ = false;
+
+      cartridge_.map_prg(0xE0'00, 0x20'00, -1);
+      update_prg();
+      update_chr();
+   }
+
+   void Mmc3::write(Word const address, Byte const data) noexcept
+   {
+      // the registers come in pairs, told apart by A0, mirrored throughout each 8 KiB
+      bool const odd{ static_cast<bool>(address & 1) };
+      switch (address >> 13 & 0b11)
+      {
+         case 0:
+            if (odd)
+            {
+               // only the bank the register is for moves, which keeps per-scanline switches cheap
+               std::size_t const bank{ bank_select_ & 0b1'11u };
+               banks_[bank] = data;
+               return update_bank(bank);
+            }
+            else
+            {
+               auto const changed{ static_cast<Byte>(std::exchange(bank_select_, data) ^ data) };
+               if (changed & 0x40)
+                  update_prg();
+
+               if (changed & 0x80)
+                  update_chr();
+            }
+            return;
+
+         case 1:
+            // the PRG RAM protection in the odd register is left alone, keeping the RAM writable
+            if (not odd)
+               cartridge_.set_mirroring(data & 1 ? Cartridge::Mirroring::HORIZONTAL : Cartridge::Mirroring::VERTICAL);
+            return;
+
+         case 2:
+            if (odd)
+            {
+               irq_counter_ = 0;
+               irq_reload_ = true;
+            }
+            else
+               irq_latch_ = data;
+            return;
+
+         default:
+            irq_enabled_ = odd;
+            if (not odd)
+               irq_ = false;
+      }
+   }
+
+   void Mmc3::count_scanline() noexcept
+   {
+      if (not irq_counter_ or irq_reload_)
+      {
+         irq_counter_ = irq_latch_;
+         irq_reload_ = false;
+      }
+      else
+         --irq_counter_;
+
+      if (not irq_counter_ and irq_enabled_)
+         irq_ = true;
+   }
+
+   bool Mmc3::irq() const noexcept
+   {
+      return irq_;
+   }
+
+   void Mmc3::update_prg() noexcept
+   {
+      // the second to last bank is fixed where R6 is not
+      cartridge_.map_prg(bank_select_ & 0x40 ? 0x80'00 : 0xC0'00, 0x20'00, -2);
+      update_bank(6);
+      update_bank(7);
+   }
+
+   void Mmc3::update_chr() noexcept
+   {
+      for (std::size_t bank{}; bank < 6; ++bank)
+         update_bank(bank);
+   }
+
+   void Mmc3::update_bank(std::size_t const bank) noexcept
+   {
+      if (bank == 6)
+         return cartridge_.map_prg(bank_select_ & 0x40 ? 0xC0'00 : 0x80'00, 0x20'00, banks_[6]);
+
+      if (bank == 7)
+         return cartridge_.map_prg(0xA0'00, 0x20'00, banks_[7]);
+
+      // R0 and R1 pick 2 KiB banks, ignoring their lowest bit, R2 to R5 1 KiB ones, the halves being swapped by $8000
+      Word const inverted{ static_cast<Word>(bank_select_ & 0x80 ? 0x10'00 : 0x00'00) };
+      if (bank < 2)
+         return cartridge_.map_chr(static_cast<Word>(bank * 0x08'00 ^ inverted), 0x08'00, banks_[bank] >> 1);
+
+      cartridge_.map_chr(static_cast<Word>((0x10'00 + (bank - 2) * 0x04'00) ^ inverted), 0x04'00, banks_[bank]);
+   }
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef MMC3_HPP
+#define MMC3_HPP
+
+#include "hardware/types.hpp"
+#include "mapper.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   // MMC3 (TxROM). Eight bank registers, selected through $8000 and written through $8001, pick two 8 KiB PRG banks
+   // and six CHR banks; $8000 also picks which PRG bank slot the second to last bank is fixed in and which CHR half
+   // gets the 2 KiB banks. The IRQ counter counts scanlines down from the latch, raising the IRQ at zero if enabled.
+   class Mmc3 final : public Mapper
+   {
+      public:
+         explicit Mmc3(Cartridge& cartridge) noexcept;
+         Mmc3(Mmc3 const&) = delete;
+         Mmc3(Mmc3&&) = delete;
+
+         virtual ~Mmc3() noexcept override = default;
+
+         Mmc3& operator=(Mmc3 const&) = delete;
+         Mmc3& operator=(Mmc3&&) = delete;
+
+         virtual void reset() noexcept override;
+         virtual void write(Word address, Byte data) noexcept override;
+         virtual void count_scanline() noexcept override;
+         [[nodiscard]] virtual bool irq() const noexcept override;
+
+      private:
+         void update_prg() noexcept;
+         void update_chr() noexcept;
+         void update_bank(std::size_t bank) noexcept;
+
+         Byte bank_select_{};
+         std::array<Byte, 8> banks_{};
+         Byte irq_latch_{};
+         Byte irq_counter_{};
+         bool irq_reload_{};
+         bool irq_enabled_{};
+         bool irq_{};
+   };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,21 @@
+#include "nrom.hpp"
+#include "cartridge.hpp"
+
+namespace nes
+{
+   Nrom::Nrom(Cartridge& cartridge) noexcept
+      : Mapper{ cartridge }
+   {
+   }
+
+   void Nrom::reset() noexcept
+   {
+      cartridge_.map_prg(0x80'00, 0x40'00, 0);
+      cartridge_.map_prg(0xC0'00, 0x40'00, -1);
+      cartridge_.map_chr(0x00'00, 0x20'00, 0);
+   }
+
+   void Nrom::write(Word, Byte) noexcept
+   {
+   }
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#ifndef NROM_HPP
+#define NROM_HPP
+
+#include "hardware/types.hpp"
+#include "mapper.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   // The boards without bank switching: 16 or 32 KiB of PRG ROM, a single 16 KiB bank being mirrored, and 8 KiB of
+   // CHR.
+   class Nrom final : public Mapper
+   {
+      public:
+         explicit Nrom(Cartridge& cartridge) noexcept;
+         Nrom(Nrom const&) = delete;
+         Nrom(Nrom&&) = delete;
+
+         virtual ~Nrom() noexcept override = default;
+
+         Nrom& operator=(Nrom const&) = delete;
+         Nrom& operator=(Nrom&&) = delete;
+
+         virtual void reset() noexcept override;
+         virtual void write(Word address, Byte data) noexcept override;
+   };
+}
+
+#endif
\ No newline at end of file
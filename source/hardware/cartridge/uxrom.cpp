@@ -0,0 +1,22 @@
+#include "uxrom.hpp"
+#include "cartridge.hpp"
+
+namespace nes
+{
+   Uxrom::Uxrom(Cartridge& cartridge) noexcept
+      : Mapper{ cartridge }
+   {
+   }
+
+   void Uxrom::reset() noexcept
+   {
+      cartridge_.map_prg(0x80'00, 0x40'00, 0);
+      cartridge_.map_prg(0xC0'00, 0x40'00, -1);
+      cartridge_.map_chr(0x00'00, 0x20'00, 0);
+   }
+
+   void Uxrom::write(Word, Byte const data) noexcept
+   {
+      cartridge_.map_prg(0x80'00, 0x40'00, data);
+   }
+}
\ No newline at end of file
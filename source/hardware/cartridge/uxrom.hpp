@@ -0,0 +1,29 @@
+#ifndef UXROM_HPP
+#define UXROM_HPP
+
+#include "hardware/types.hpp"
+#include "mapper.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   // UNROM and UOROM: writes to $8000-$FFFF pick the 16 KiB PRG bank at $8000, the last bank is fixed at $C000
+   // and the 8 KiB of CHR is usually RAM.
+   class Uxrom final : public Mapper
+   {
+      public:
+         explicit Uxrom(Cartridge& cartridge) noexcept;
+         Uxrom(Uxrom const&) = delete;
+         Uxrom(Uxrom&&) = delete;
+
+         virtual ~Uxrom() noexcept override = default;
+
+         Uxrom& operator=(Uxrom const&) = delete;
+         Uxrom& operator=(Uxrom&&) = delete;
+
+         virtual void reset() noexcept override;
+         virtual void write(Word address, Byte data) noexcept override;
+   };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,33 @@
+#include "console.hpp"
+
+namespace nes
+{
+   Console::Console(Memory& memory) noexcept
+      : memory_{ memory }
+   {
+      memory_.map(INTERNAL_RAM_FIRST, INTERNAL_RAM_LAST, std::span<Byte>{ internal_ram_ });
+   }
+
+   Console::~Console() noexcept
+   {
+      eject();
+      memory_.unmap(INTERNAL_RAM_FIRST, INTERNAL_RAM_LAST);
+   }
+
+   void Console::insert(std::unique_ptr<Cartridge> cartridge)
+   {
+      eject();
+      cartridge_ = std::move(cartridge);
+      cartridge_->insert(memory_);
+   }
+
+   void Console::eject() noexcept
+   {
+      cartridge_.reset();
+   }
+
+   Cartridge* Console::cartridge() const noexcept
+   {
+      return cartridge_.get();
+   }
+}
\ No newline at end of file
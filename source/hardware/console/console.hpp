@@ -0,0 +1,43 @@
+#ifndef CONSOLE_HPP
+#define CONSOLE_HPP
+
+#include "hardware/cartridge/cartridge.hpp"
+#include "hardware/memory/memory.hpp"
+#include "hardware/types.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   // The memory map of the 2A03 in an NES: the 2 KiB of internal RAM mirrored through $0000-$1FFF and the cartridge
+   // from $6000 on. The PPU and APU registers in between are not modelled yet, so those addresses stay plain RAM.
+   // The console has to be destroyed before the memory is.
+   class Console final
+   {
+      public:
+         static Word constexpr INTERNAL_RAM_FIRST{ 0x00'00 };
+         static Word constexpr INTERNAL_RAM_LAST{ 0x1F'FF };
+         static std::size_t constexpr INTERNAL_RAM_SIZE{ 0x08'00 };
+
+         explicit Console(Memory& memory) noexcept;
+         Console(Console const&) = delete;
+         Console(Console&&) = delete;
+
+         ~Console() noexcept;
+
+         Console& operator=(Console const&) = delete;
+         Console& operator=(Console&&) = delete;
+
+         // replaces the cartridge in the slot, if any
+         void insert(std::unique_ptr<Cartridge> cartridge);
+         void eject() noexcept;
+
+         [[nodiscard]] Cartridge* cartridge() const noexcept;
+
+      private:
+         Memory& memory_;
+         std::array<Byte, INTERNAL_RAM_SIZE> internal_ram_{};
+         std::unique_ptr<Cartridge> cartridge_{};
+   };
+}
+
+#endif
\ No newline at end of file
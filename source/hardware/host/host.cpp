@@ -0,0 +1,177 @@
+#include "host.hpp"
+
+namespace nes
+{
+   Host::Host(Cycle const quantum) noexcept
+      : quantum_{ std::max<Cycle>(quantum, 1) }
+   {
+   }
+
+   Host::~Host() noexcept
+   {
+      for (std::unique_ptr<Bus> const& bus : buses_)
+         bus->memory.remove_watcher(bus->watcher);
+   }
+
+   Processor* Host::add_processor(Memory& memory, Processor::Core const core)
+   {
+      auto bus{ std::ranges::find(buses_, &memory, [](std::unique_ptr<Bus> const& bus) { return &bus->memory; }) };
+      bool const first_on_memory{ bus == buses_.end() };
+      if (not first_on_memory and (*bus)->participants.size() >= MAX_PROCESSORS_PER_MEMORY)
+         return nullptr;
+
+      bool const caching{ core == Processor::Core::PREDECODED or core == Processor::Core::RECOMPILED };
+      if (memory.free_watchers() < static_cast<std::size_t>(first_on_memory) + caching)
+         return nullptr;
+
+      if (first_on_memory)
+      {
+         auto& new_bus{
+            *buses_.emplace_back(std::make_unique<Bus>(Bus{
+               .memory{ memory },
+               .watcher{},
+               .participants{},
+               .outbox{}
+            }))
+         };
+
+         // there is a free watcher, as checked above
+         new_bus.watcher = *memory.add_watcher(
+            [this, &new_bus](Word const first, Word const last) noexcept
+            {
+               if (not delivering_)
+                  for (std::size_t address{ first }; address <= last; ++address)
+                     new_bus.outbox.set(address);
+            });
+
+         for (Region const& mailbox : mailboxes_)
+            memory.watch(new_bus.watcher, mailbox.first, mailbox.last, true);
+
+         bus = buses_.end() - 1;
+      }
+
+      Processor& processor{ *processors_.emplace_back(std::make_unique<Processor>(memory, core)) };
+      (*bus)->participants.push_back({
+         .processor{ &processor },
+         .index{ processors_.size() - 1 },
+         .joined{ cycle_ - processor.cycle() }
+      });
+      return &processor;
+   }
+
+   void Host::add_mailbox(Word const first, Word const last) noexcept
+   {
+      mailboxes_.push_back({ .first{ first }, .last{ last } });
+      for (std::unique_ptr<Bus> const& bus : buses_)
+         bus->memory.watch(bus->watcher, first, last, true);
+   }
+
+   std::vector<Host::ProcessorResult> Host::run(Cycle const budget)
+   {
+      // the cycles each processor starts at, until it is done
+      std::vector<ProcessorResult> results(processors_.size());
+      for (std::size_t index{}; index < processors_.size(); ++index)
+         results[index].cycles = processors_[index]->cycle();
+
+      Cycle const quanta{ (budget + quantum_ - 1) / quantum_ };
+      if (not parallel())
+         for (Cycle quantum{}; quantum < quanta; ++quantum)
+         {
+            for (std::unique_ptr<Bus> const& bus : buses_)
+               run_quantum(*bus, cycle_ + quantum_, results);
+
+            deliver_mail();
+            cycle_ += quantum_;
+         }
+      else
+      {
+         // the mail is delivered while every bus waits at the end of the quantum
+         std::barrier synchronisation{
+            static_cast<std::ptrdiff_t>(buses_.size()),
+            [this]() noexcept
+            {
+               deliver_mail();
+               cycle_ += quantum_;
+            }
+         };
+
+         auto const run_bus{
+            [this, quanta, &synchronisation, &results](Bus& bus)
+            {
+               for (Cycle quantum{}; quantum < quanta; ++quantum)
+               {
+                  run_quantum(bus, cycle_ + quantum_, results);
+                  synchronisation.arrive_and_wait();
+               }
+            }
+         };
+
+         std::vector<std::jthread> threads{};
+         for (auto bus{ buses_.begin() + 1 }; bus not_eq buses_.end(); ++bus)
+            threads.emplace_back(run_bus, std::ref(**bus));
+
+         run_bus(*buses_.front());
+      }
+
+      for (std::size_t index{}; index < processors_.size(); ++index)
+         results[index].cycles = processors_[index]->cycle() - results[index].cycles;
+
+      return results;
+   }
+
+   Cycle Host::cycle() const noexcept
+   {
+      return cycle_;
+   }
+
+   Cycle Host::quantum() const noexcept
+   {
+      return quantum_;
+   }
+
+   std::size_t Host::processor_count() const noexcept
+   {
+      return processors_.size();
+   }
+
+   Processor& Host::processor(std::size_t const index) const noexcept
+   {
+      return *processors_[index];
+   }
+
+   bool Host::parallel() const noexcept
+   {
+      return buses_.size() > 1;
+   }
+
+   void Host::run_quantum(Bus& bus, Cycle const end, std::span<ProcessorResult> const results) const
+   {
+      // processors are run up to the end of the quantum, which makes up for the part of an instruction the
+      // instruction-based cores ran past the previous one; each bus only touches the results of its own processors
+      for (Participant const& participant : bus.participants)
+         if (Cycle const target{ end - participant.joined }; participant.processor->cycle() < target)
+         {
+            auto const cycles{ participant.processor->run(target - participant.processor->cycle()) };
+            results[participant.index].halt_reason = cycles ? std::nullopt : std::optional{ cycles.error() };
+         }
+   }
+
+   void Host::deliver_mail() noexcept
+   {
+      delivering_ = true;
+      for (std::unique_ptr<Bus> const& sender : buses_)
+      {
+         for (Region const& mailbox : mailboxes_)
+            for (std::size_t address{ mailbox.first }; address <= mailbox.last; ++address)
+               if (sender->outbox[address])
+                  for (std::unique_ptr<Bus> const& receiver : buses_)
+                     if (receiver not_eq sender)
+                        receiver->memory.write(static_cast<Word>(address),
+                           sender->memory.read(static_cast<Word>(address)));
+
+         sender->outbox.reset();
+      }
+
+      delivering_ = false;
+   }
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#ifndef HOST_HPP
+#define HOST_HPP
+
+#include "hardware/memory/memory.hpp"
+#include "hardware/processor/halt_reason.hpp"
+#include "hardware/processor/processor.hpp"
+#include "hardware/types.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   // Runs several processors in quanta of a common clock. Processors on the same memory take turns within a quantum,
+   // in the order they were added. Memories only share the mailbox regions; what was written to those during a
+   // quantum is passed on to the other memories at its end, in the order the memories were first added. Each memory
+   // runs on a thread of its own when there are several, which the outcome does not depend on.
+   // The host watches each memory for its mailboxes, and the predecoded and recompiled cores each watch it for their
+   // block cache, out of the Memory::MAX_WATCHERS watchers a memory has. A memory therefore takes at most
+   // MAX_PROCESSORS_PER_MEMORY processors, fewer when those cores or anything else watches it.
+   // The memories have to outlive the host.
+   class Host final
+   {
+      public:
+         static Cycle constexpr DEFAULT_QUANTUM{ 1'024 };
+         static std::size_t constexpr MAX_PROCESSORS_PER_MEMORY{ Memory::MAX_WATCHERS - 1 };
+
+         struct ProcessorResult final
+         {
+            Cycle cycles;
+            std::optional<HaltReason> halt_reason;
+         };
+
+         explicit Host(Cycle quantum = DEFAULT_QUANTUM) noexcept;
+         Host(Host const&) = delete;
+         Host(Host&&) = delete;
+
+         ~Host() noexcept;
+
+         Host& operator=(Host const&) = delete;
+         Host& operator=(Host&&) = delete;
+
+         // The processor joins the common clock at its current cycle. Returns nullptr, adding nothing, when the memory
+         // has no room left for the processor or the watchers it needs.
+         Processor* add_processor(Memory& memory, Processor::Core core = Processor::Core::CYCLE_STEPPED);
+         void add_mailbox(Word first, Word last) noexcept;
+
+         // Runs every processor for the budget rounded up to whole quanta, which the clock of the host advances by.
+         // Returns the cycles each processor ran, in the order they were added, and why it was halted at the end of
+         // its last quantum, if it was; halted processors spend their quanta like Processor::run does.
+         std::vector<ProcessorResult> run(Cycle budget);
+
+         [[nodiscard]] Cycle cycle() const noexcept;
+         [[nodiscard]] Cycle quantum() const noexcept;
+         [[nodiscard]] std::size_t processor_count() const noexcept;
+         [[nodiscard]] Processor& processor(std::size_t index) const noexcept;
+         [[nodiscard]] bool parallel() const noexcept;
+
+      private:
+         struct Region final
+         {
+            Word first;
+            Word last;
+         };
+
+         struct Participant final
+         {
+            Processor* processor;
+            // where the processor is in the order they were added
+            std::size_t index;
+            // the cycle of the host the processor joined at
+            Cycle joined;
+         };
+
+         // a memory, the processors running on it and the mailbox writes it made during the current quantum
+         struct Bus final
+         {
+            Memory& memory;
+            Memory::WatcherId watcher;
+            std::vector<Participant> participants;
+            // the addresses written, marked by a watcher of the memory, which must not allocate
+            std::bitset<std::numeric_limits<ProgramCounter>::max() + 1> outbox;
+         };
+
+         void run_quantum(Bus& bus, Cycle end, std::span<ProcessorResult> results) const;
+         void deliver_mail() noexcept;
+
+         Cycle const quantum_;
+         Cycle cycle_{};
+         std::vector<std::unique_ptr<Processor>> processors_{};
+         std::vector<std::unique_ptr<Bus>> buses_{};
+         std::vector<Region> mailboxes_{};
+         bool delivering_{};
+   };
+}
+
+#endif
\ No newline at end of file
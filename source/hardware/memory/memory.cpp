@@ -1,25 +1,345 @@
 #include "memory.hpp"
+#include "rom_image.hpp"
+#include "utility/runtime_assert.hpp"
 
 namespace nes
 {
-   void Memory::load_program(std::filesystem::path const& path, Word const load_address) noexcept
+   Memory::Memory() noexcept
    {
-      std::ifstream in{ path.c_str(), std::ios::binary };
-      in.read(reinterpret_cast<char*>(&data_[load_address]), data_.size() - load_address);
+      unmap(0x00'00, 0xFF'FF);
    }
 
-   void Memory::write(Word const address, Byte const data) noexcept
+   std::size_t Memory::load_program(std::filesystem::path const& path, Word const load_address) noexcept
    {
-      data_[address] = data;
-   }
+      // the image is mapped where the host can, leaving the copy into the memory the only one made
+      auto const image{ RomImage::open(path) };
+      if (not image)
+         return 0;
 
-   Byte Memory::read(Word const address) const noexcept
-   {
-      return data_[address];
+      std::span const program{ (*image)->bytes().first(std::min((*image)->bytes().size(),
+         data_.size() - load_address)) };
+      if (program.empty())
+         return 0;
+
+      for (std::size_t offset{}; offset < program.size(); ++offset)
+      {
+         std::size_t const address{ load_address + offset };
+         if (Byte* const page{ pages_[address / PAGE_SIZE].write })
+            page[address % PAGE_SIZE] = program[offset];
+      }
+
+      auto const last{ static_cast<Word>(load_address + program.size() - 1) };
+      dirty(load_address, last);
+      notify_watchers(std::numeric_limits<std::uint8_t>::max(), load_address, last);
+
+      // what was loaded into mirrored RAM shows up at its mirrors too
+      for (std::size_t page{ load_address / PAGE_SIZE }; page <= last / PAGE_SIZE; ++page)
+         if (mirrored_pages_[page])
+            for_each_mirror(page,
+               [this, page](std::size_t const mirror)
+               {
+                  if (mirror not_eq page)
+                     notify_watchers(std::numeric_limits<std::uint8_t>::max(), static_cast<Word>(mirror * PAGE_SIZE),
+                        static_cast<Word>((mirror + 1) * PAGE_SIZE - 1));
+               });
+
+      return program.size();
    }
 
    std::size_t Memory::size() const noexcept
    {
       return data_.size();
    }
+
+   void Memory::map(Word const first, Word const last, std::span<Byte> const ram) noexcept
+   {
+      runtime_assert(not ram.empty() and ram.size() % PAGE_SIZE == 0, "mapped memory must consist of whole pages");
+
+      bool changed{};
+      for (std::size_t page{ first / PAGE_SIZE }; page <= last / PAGE_SIZE; ++page)
+      {
+         Byte* const data{ ram.data() + (page - first / PAGE_SIZE) * PAGE_SIZE % ram.size() };
+         changed |= remap(page, data, data, pages_[page].device);
+      }
+
+      // switching to the bank that is mapped already is free
+      if (changed)
+         remapped(first / PAGE_SIZE, last / PAGE_SIZE, true);
+   }
+
+   void Memory::map(Word const first, Word const last, std::span<Byte const> const rom) noexcept
+   {
+      runtime_assert(not rom.empty() and rom.size() % PAGE_SIZE == 0, "mapped memory must consist of whole pages");
+
+      bool changed{};
+      for (std::size_t page{ first / PAGE_SIZE }; page <= last / PAGE_SIZE; ++page)
+      {
+         Byte const* const data{ rom.data() + (page - first / PAGE_SIZE) * PAGE_SIZE % rom.size() };
+         changed |= remap(page, data, nullptr, pages_[page].device);
+      }
+
+      if (changed)
+         remapped(first / PAGE_SIZE, last / PAGE_SIZE, true);
+   }
+
+   void Memory::unmap(Word const first, Word const last) noexcept
+   {
+      for (std::size_t page{ first / PAGE_SIZE }; page <= last / PAGE_SIZE; ++page)
+         remap(page, &data_[page * PAGE_SIZE], &data_[page * PAGE_SIZE], nullptr);
+
+      remapped(first / PAGE_SIZE, last / PAGE_SIZE, true);
+   }
+
+   void Memory::attach(Word const first, Word const last, Device device)
+   {
+      Device const& attached{
+         *devices_.emplace_back(AttachedDevice{
+            .device{ std::make_unique<Device const>(std::move(device)) },
+            .pages{}
+         }).device
+      };
+      for (std::size_t page{ first / PAGE_SIZE }; page <= last / PAGE_SIZE; ++page)
+         remap(page, nullptr, nullptr, &attached);
+
+      remapped(first / PAGE_SIZE, last / PAGE_SIZE, false);
+   }
+
+   bool Memory::flat() const noexcept
+   {
+      return not remapped_page_count_;
+   }
+
+   bool Memory::writable(Word const address) const noexcept
+   {
+      return pages_[address / PAGE_SIZE].write;
+   }
+
+   bool Memory::mirror(Word const address) const noexcept
+   {
+      std::size_t const page{ address / PAGE_SIZE };
+      if (not mirrored_pages_[page])
+         return false;
+
+      return std::ranges::any_of(std::span{ pages_ }.first(page),
+         [this, page](Page const& lower) { return lower.write == pages_[page].write; });
+   }
+
+   void Memory::set_side_effect_free(Word const first, Word const last, bool const side_effect_free) noexcept
+   {
+      for (std::size_t page{ first / PAGE_SIZE }; page <= last / PAGE_SIZE; ++page)
+         read_side_effects_[page] = not side_effect_free;
+   }
+
+   bool Memory::side_effect_free(Word const address) const noexcept
+   {
+      return not read_side_effects_[address / PAGE_SIZE];
+   }
+
+   std::optional<Memory::WatcherId> Memory::add_watcher(Watcher watcher) noexcept
+   {
+      auto const free_slot{ std::ranges::find_if(watchers_, std::logical_not{}) };
+      if (free_slot == watchers_.end())
+         return std::nullopt;
+
+      *free_slot = std::move(watcher);
+      return static_cast<WatcherId>(free_slot - watchers_.begin());
+   }
+
+   void Memory::remove_watcher(WatcherId const watcher) noexcept
+   {
+      watch(watcher, 0x0000, static_cast<Word>(data_.size() - 1), false);
+      watchers_[watcher] = nullptr;
+   }
+
+   void Memory::watch(WatcherId const watcher, Word const first, Word const last, bool const watched) noexcept
+   {
+      auto const mask{ static_cast<std::uint8_t>(1 << watcher) };
+      for (std::size_t address{ first }; address <= last; ++address)
+         watched
+            ? watchers_by_address_[address] |= mask
+            : watchers_by_address_[address] &= ~mask;
+
+      // only writes to mirrored pages have more to tell than the watchers of the address written
+      for (std::size_t page{ first / PAGE_SIZE }; page <= last / PAGE_SIZE; ++page)
+         if (mirrored_pages_[page])
+            gather_watchers(page);
+         else
+            for (std::size_t address{ std::max<std::size_t>(first, page * PAGE_SIZE) };
+               address <= std::min<std::size_t>(last, (page + 1) * PAGE_SIZE - 1); ++address)
+               write_watchers_by_address_[address] = watchers_by_address_[address];
+   }
+
+   std::size_t Memory::free_watchers() const noexcept
+   {
+      return static_cast<std::size_t>(std::ranges::count_if(watchers_, std::logical_not{}));
+   }
+
+   std::optional<Memory::DirtyCursorId> Memory::add_dirty_cursor() noexcept
+   {
+      auto const free_slot{ std::ranges::find_if(dirty_cursors_, std::logical_not{}) };
+      if (free_slot == dirty_cursors_.end())
+         return std::nullopt;
+
+      free_slot->emplace().fill(std::numeric_limits<std::uint64_t>::max());
+      return static_cast<DirtyCursorId>(free_slot - dirty_cursors_.begin());
+   }
+
+   void Memory::remove_dirty_cursor(DirtyCursorId const cursor) noexcept
+   {
+      dirty_cursors_[cursor].reset();
+   }
+
+   Memory::DirtyPages Memory::take_dirty_pages(DirtyCursorId const cursor) noexcept
+   {
+      runtime_assert(dirty_cursors_[cursor].has_value(), "taking the dirty pages of a removed cursor");
+
+      // hand what was written since any cursor was last taken to all of them
+      for (std::optional<PageBitmap>& other : dirty_cursors_)
+         if (other)
+            for (std::size_t word{}; word < dirty_pages_.size(); ++word)
+               (*other)[word] |= dirty_pages_[word];
+
+      dirty_pages_.fill(0);
+
+      DirtyPages pages{};
+      for (std::size_t word{}; word < dirty_pages_.size(); ++word)
+         for (std::uint64_t bits{ std::exchange((*dirty_cursors_[cursor])[word], 0) }; bits; bits &= bits - 1)
+            pages.set(word * 64 + static_cast<std::size_t>(std::countr_zero(bits)));
+
+      return pages;
+   }
+
+   Byte Memory::read_device(Page const& page, Word const address) const noexcept
+   {
+      // with nothing driving the data bus, it keeps the high byte of the address the processor put out last
+      if (not page.device or not page.device->read)
+         return static_cast<Byte>(address >> 8);
+
+      return page.device->read(address);
+   }
+
+   void Memory::write_device(Page const& page, Word const address, Byte const data) const noexcept
+   {
+      // writes to ROM that no device takes are lost
+      if (page.device and page.device->write)
+         page.device->write(address, data);
+   }
+
+   bool Memory::remap(std::size_t const page, Byte const* const read, Byte* const write,
+      Device const* const device) noexcept
+   {
+      Page& entry{ pages_[page] };
+      if (entry.read == read and entry.write == write and entry.device == device)
+         return false;
+
+      if (entry.device not_eq device)
+      {
+         auto const attached{
+            [this](Device const* const attached_device)
+            {
+               return std::ranges::find(devices_, attached_device,
+                  [](AttachedDevice const& candidate) { return candidate.device.get(); });
+            }
+         };
+
+         if (device)
+            ++attached(device)->pages;
+
+         // a device no page is attached to anymore is done with
+         if (entry.device)
+            if (auto const detached{ attached(entry.device) }; not --detached->pages)
+               devices_.erase(detached);
+      }
+
+      entry = {
+         .read{ read },
+         .write{ write },
+         .device{ device }
+      };
+
+      bool const remapped{ read not_eq &data_[page * PAGE_SIZE] or write not_eq read };
+      remapped_page_count_ += remapped - remapped_pages_[page];
+      remapped_pages_[page] = remapped;
+      return true;
+   }
+
+   void Memory::remapped(std::size_t const first_page, std::size_t const last_page,
+      bool const side_effect_free) noexcept
+   {
+      for (std::size_t page{ first_page }; page <= last_page; ++page)
+         read_side_effects_[page] = not side_effect_free;
+
+      // what the processor finds at the addresses has changed, which caches of decoded code must know about
+      auto const first{ static_cast<Word>(first_page * PAGE_SIZE) };
+      auto const last{ static_cast<Word>((last_page + 1) * PAGE_SIZE - 1) };
+      for (std::size_t page{ first_page }; page <= last_page; ++page)
+         gather_watchers(page);
+
+      dirty(first, last);
+      notify_watchers(std::numeric_limits<std::uint8_t>::max(), first, last);
+   }
+
+   void Memory::notify_watchers(std::uint8_t watchers, Word const first, Word const last) const noexcept
+   {
+      for (WatcherId watcher{}; watchers; ++watcher, watchers >>= 1)
+         if (watchers & 1 and watchers_[watcher])
+            watchers_[watcher](first, last);
+   }
+
+   void Memory::notify_write(Word const address) const noexcept
+   {
+      if (not mirrored_pages_[address / PAGE_SIZE]) [[likely]]
+         return notify_watchers(watchers_by_address_[address], address, address);
+
+      for_each_mirror(address / PAGE_SIZE,
+         [this, address](std::size_t const mirror)
+         {
+            auto const mirrored{ static_cast<Word>(mirror * PAGE_SIZE + address % PAGE_SIZE) };
+            if (std::uint8_t const watchers{ watchers_by_address_[mirrored] })
+               notify_watchers(watchers, mirrored, mirrored);
+         });
+   }
+
+   template <typename Function>
+   void Memory::for_each_mirror(std::size_t const page, Function&& function) const noexcept
+   {
+      // mirrors are whole pages, as mapped memory consists of them
+      Byte const* const write{ pages_[page].write };
+      if (not write)
+         return function(page);
+
+      for (std::size_t mirror{}; mirror < PAGES; ++mirror)
+         if (pages_[mirror].write == write)
+            function(mirror);
+   }
+
+   void Memory::gather_watchers(std::size_t const page) noexcept
+   {
+      std::array<std::size_t, PAGES> mirrors{};
+      std::size_t count{};
+      for_each_mirror(page,
+         [&mirrors, &count](std::size_t const mirror)
+         {
+            mirrors[count++] = mirror;
+         });
+
+      for (std::size_t offset{}; offset < PAGE_SIZE; ++offset)
+      {
+         std::uint8_t watchers{};
+         for (std::size_t mirror{}; mirror < count; ++mirror)
+            watchers |= watchers_by_address_[mirrors[mirror] * PAGE_SIZE + offset];
+
+         for (std::size_t mirror{}; mirror < count; ++mirror)
+            write_watchers_by_address_[mirrors[mirror] * PAGE_SIZE + offset] = watchers;
+      }
+
+      for (std::size_t mirror{}; mirror < count; ++mirror)
+         mirrored_pages_[mirrors[mirror]] = count > 1;
+   }
+
+   void Memory::dirty(Word const first, Word const last) noexcept
+   {
+      for (std::size_t page{ first / PAGE_SIZE }; page <= last / PAGE_SIZE; ++page)
+         dirty_pages_[page / 64] |= std::uint64_t{ 1 } << page % 64;
+   }
 }
\ No newline at end of file
@@ -6,10 +6,40 @@
 
 namespace nes
 {
+   // The address space as the processor sees it, one page table entry per 256-byte page. An entry points straight at
+   // the host memory behind the page, RAM or ROM, or hands its accesses to the device attached to it. Every page maps
+   // the RAM at its own address until something else is mapped there.
    class Memory final
    {
+      friend class Recompiler;
+
       public:
-         Memory() noexcept = default;
+         // Watchers are told about writes to the addresses they watch (and about every program load and change of
+         // the page table), which is what caches of decoded code rely on to stay coherent with self-modifying
+         // programs. A write through a mirror is told about at every address mirroring the one written as well.
+         using Watcher = std::function<void(Word first, Word last)>;
+         using WatcherId = std::size_t;
+
+         // Cursors each see which pages were written (or had their mapping changed, or a program loaded into them)
+         // since they were last taken, so consumers like memory views, savestate deltas and state hashes only look at
+         // those. Unlike watchers, a write through a mirror dirties only the page written, not the ones it mirrors.
+         using DirtyCursorId = std::size_t;
+
+         // a memory-mapped device, told the full address of every access to the pages it is attached to
+         struct Device final
+         {
+            std::function<Byte(Word address)> read;
+            std::function<void(Word address, Byte data)> write;
+         };
+
+         static std::size_t constexpr MAX_WATCHERS{ 8 };
+         static std::size_t constexpr PAGE_SIZE{ 0x01'00 };
+         static std::size_t constexpr PAGES{ (std::numeric_limits<ProgramCounter>::max() + 1) / PAGE_SIZE };
+         static std::size_t constexpr MAX_DIRTY_CURSORS{ 8 };
+
+         using DirtyPages = std::bitset<PAGES>;
+
+         Memory() noexcept;
          Memory(Memory const&) = delete;
          Memory(Memory&&) = delete;
 
@@ -18,15 +48,122 @@ namespace nes
          Memory& operator=(Memory const&) = delete;
          Memory& operator=(Memory&&) = delete;
 
-         void load_program(std::filesystem::path const& path, Word load_address = 0x0000) noexcept;
+         // copies the program into the writable memory from the load address on and returns how many bytes were
+         // loaded; the parts of the program landing on ROM or devices are dropped
+         std::size_t load_program(std::filesystem::path const& path, Word load_address = 0x0000) noexcept;
+
+         void write(Word const address, Byte const data) noexcept
+         {
+            Page const& page{ pages_[address / PAGE_SIZE] };
+            if (not page.write) [[unlikely]]
+               return write_device(page, address, data);
+
+            page.write[address % PAGE_SIZE] = data;
+            dirty_pages_[address / PAGE_SIZE / 64] |= std::uint64_t{ 1 } << address / PAGE_SIZE % 64;
+            if (write_watchers_by_address_[address]) [[unlikely]]
+               notify_write(address);
+         }
+
+         [[nodiscard]] Byte read(Word const address) const noexcept
+         {
+            Page const& page{ pages_[address / PAGE_SIZE] };
+            if (not page.read) [[unlikely]]
+               return read_device(page, address);
 
-         void write(Word address, Byte data) noexcept;
-         [[nodiscard]] Byte read(Word address) const noexcept;
+            return page.read[address % PAGE_SIZE];
+         }
 
          [[nodiscard]] std::size_t size() const noexcept;
 
+         // The pages spanning the addresses map the host memory, repeated for as long as the range is longer than
+         // the memory is, which mirrors it. Pages mapping ROM leave the writes to the device attached to them, if
+         // any, so a cartridge can have its registers where its ROM is read from. The size of the host memory must be
+         // a multiple of the page size, and the memory must outlive the mapping.
+         void map(Word first, Word last, std::span<Byte> ram) noexcept;
+         void map(Word first, Word last, std::span<Byte const> rom) noexcept;
+         // maps the pages spanning the addresses back to the RAM at their own addresses, with no device attached
+         void unmap(Word first, Word last) noexcept;
+         // The device handles every access to the pages spanning the addresses, until memory is mapped over it. It is
+         // freed once no page is attached to it anymore, which its own handlers must therefore not bring about.
+         void attach(Word first, Word last, Device device);
+         // whether every page maps the RAM at its own address, which code addressing memory directly relies on
+         [[nodiscard]] bool flat() const noexcept;
+         // whether writes to the page holding the address go to RAM, rather than to a device or nowhere
+         [[nodiscard]] bool writable(Word address) const noexcept;
+         // whether the page holding the address maps RAM that a page below it maps as well
+         [[nodiscard]] bool mirror(Word address) const noexcept;
+
+         // Reading plain memory has no side effects, so the processor may skip the reads it throws away. Regions that
+         // react to being read, like I/O registers, declare otherwise, for every page they touch. Attaching a device
+         // declares so, mapping memory the opposite.
+         void set_side_effect_free(Word first, Word last, bool side_effect_free) noexcept;
+         [[nodiscard]] bool side_effect_free(Word address) const noexcept;
+
+         // there are MAX_WATCHERS slots for watchers, so adding one fails once they are all taken
+         [[nodiscard]] std::optional<WatcherId> add_watcher(Watcher watcher) noexcept;
+         void remove_watcher(WatcherId watcher) noexcept;
+         void watch(WatcherId watcher, Word first, Word last, bool watched) noexcept;
+         [[nodiscard]] std::size_t free_watchers() const noexcept;
+
+         // A new cursor has not seen anything yet, so every page is dirty to it. Like adding a watcher, adding a cursor
+         // fails once all MAX_DIRTY_CURSORS slots are taken.
+         [[nodiscard]] std::optional<DirtyCursorId> add_dirty_cursor() noexcept;
+         void remove_dirty_cursor(DirtyCursorId cursor) noexcept;
+         // the pages dirtied since the cursor was last taken, which leaves it clean
+         [[nodiscard]] DirtyPages take_dirty_pages(DirtyCursorId cursor) noexcept;
+
       private:
+         struct Page final
+         {
+            Byte const* read;
+            Byte* write;
+            Device const* device;
+         };
+
+         struct AttachedDevice final
+         {
+            std::unique_ptr<Device const> device;
+            // how many pages are attached to the device
+            std::size_t pages;
+         };
+
+         [[nodiscard]] Byte read_device(Page const& page, Word address) const noexcept;
+         void write_device(Page const& page, Word address, Byte data) const noexcept;
+         // points the page at other memory, returning whether that changed anything
+         bool remap(std::size_t page, Byte const* read, Byte* write, Device const* device) noexcept;
+         // brings the rest up to date with pages the page table has just changed for
+         void remapped(std::size_t first_page, std::size_t last_page, bool side_effect_free) noexcept;
+         void notify_watchers(std::uint8_t watchers, Word first, Word last) const noexcept;
+         // tells the watchers of the address and of the addresses mirroring it about a write there
+         void notify_write(Word address) const noexcept;
+         // calls the function with every page mapping the same RAM as the page, the page itself included
+         template <typename Function>
+         void for_each_mirror(std::size_t page, Function&& function) const noexcept;
+         // brings the watchers a write to the page and its mirrors has to tell up to date
+         void gather_watchers(std::size_t page) noexcept;
+         void dirty(Word first, Word last) noexcept;
+
          std::array<Byte, std::numeric_limits<ProgramCounter>::max() + 1> data_{};
+         std::array<Page, PAGES> pages_{};
+         // kept where the page table can point at them for as long as pages are attached to them
+         std::vector<AttachedDevice> devices_{};
+         // the pages mapping other than the RAM at their own address
+         std::array<bool, PAGES> remapped_pages_{};
+         std::size_t remapped_page_count_{};
+
+         std::array<std::uint8_t, std::numeric_limits<ProgramCounter>::max() + 1> watchers_by_address_{};
+         // The watchers of each address and of the addresses mirroring it, which is what a write there checks. After
+         // a remapping it may still hold watchers of pages that stopped mirroring it, which only costs a slower write.
+         std::array<std::uint8_t, std::numeric_limits<ProgramCounter>::max() + 1> write_watchers_by_address_{};
+         std::array<bool, PAGES> mirrored_pages_{};
+         std::array<Watcher, MAX_WATCHERS> watchers_{};
+         std::array<bool, PAGES> read_side_effects_{};
+
+         // A write only sets its bit here. The cursors take these over when one of them is taken, so no write pays
+         // for how many cursors there are.
+         using PageBitmap = std::array<std::uint64_t, PAGES / 64>;
+         PageBitmap dirty_pages_{};
+         std::array<std::optional<PageBitmap>, MAX_DIRTY_CURSORS> dirty_cursors_{};
    };
 }
 
@@ -0,0 +1,68 @@
+#include "rom_image.hpp"
+
+namespace nes
+{
+   std::expected<std::unique_ptr<RomImage const>, std::string> RomImage::open(std::filesystem::path const& path)
+   {
+      #if (defined(__unix__) or defined(__APPLE__)) and not defined(__EMSCRIPTEN__)
+      int const file{ ::open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+      if (file < 0)
+         return std::unexpected{ std::format("cannot open {}", path.string()) };
+
+      // the mapping keeps the file referenced, so the descriptor is done with either way
+      struct stat status{};
+      void* mapping{ MAP_FAILED };
+      if (fstat(file, &status) == 0 and S_ISREG(status.st_mode) and status.st_size > 0)
+         mapping = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+      close(file);
+      if (mapping not_eq MAP_FAILED)
+         return std::unique_ptr<RomImage const>{
+            new RomImage{ static_cast<Byte const*>(mapping), static_cast<std::size_t>(status.st_size) }
+         };
+      #endif
+
+      // empty files and whatever cannot be mapped, pipes included, are read instead
+      std::ifstream in{ path, std::ios::binary };
+      if (not in)
+         return std::unexpected{ std::format("cannot open {}", path.string()) };
+
+      std::vector<Byte> bytes{ std::istreambuf_iterator<char>{ in }, std::istreambuf_iterator<char>{} };
+      return std::unique_ptr<RomImage const>{ new RomImage{ std::move(bytes) } };
+   }
+
+   RomImage::RomImage(std::span<Byte const> const bytes)
+      : RomImage{ std::vector<Byte>{ bytes.begin(), bytes.end() } }
+   {
+   }
+
+   RomImage::~RomImage() noexcept
+   {
+      #if (defined(__unix__) or defined(__APPLE__)) and not defined(__EMSCRIPTEN__)
+      if (mapped_)
+         munmap(const_cast<Byte*>(bytes_.data()), bytes_.size());
+      #endif
+   }
+
+   std::span<Byte const> RomImage::bytes() const noexcept
+   {
+      return bytes_;
+   }
+
+   bool RomImage::mapped() const noexcept
+   {
+      return mapped_;
+   }
+
+   RomImage::RomImage(std::vector<Byte> bytes) noexcept
+      : copy_{ std::move(bytes) }
+      , bytes_{ copy_ }
+   {
+   }
+
+   RomImage::RomImage(Byte const* const mapping, std::size_t const size) noexcept
+      : bytes_{ mapping, size }
+      , mapped_{ true }
+   {
+   }
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef ROM_IMAGE_HPP
+#define ROM_IMAGE_HPP
+
+#include "hardware/types.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   // The bytes of an image file, read-only. Where the host has mmap, the file is mapped rather than read, so nothing
+   // is copied and every image of the same file, in this process or any other, shares the page cache pages behind
+   // it. Elsewhere, like in the browser, the file is read into memory of its own.
+   class RomImage final
+   {
+      public:
+         [[nodiscard]] static std::expected<std::unique_ptr<RomImage const>, std::string> open(
+            std::filesystem::path const& path);
+
+         // an image of bytes already in memory, which are copied
+         explicit RomImage(std::span<Byte const> bytes);
+         RomImage(RomImage const&) = delete;
+         RomImage(RomImage&&) = delete;
+
+         ~RomImage() noexcept;
+
+         RomImage& operator=(RomImage const&) = delete;
+         RomImage& operator=(RomImage&&) = delete;
+
+         // stay where they are for as long as the image lives
+         [[nodiscard]] std::span<Byte const> bytes() const noexcept;
+         // whether the bytes are the file mapped into memory rather than a copy of it
+         [[nodiscard]] bool mapped() const noexcept;
+
+      private:
+         explicit RomImage(std::vector<Byte> bytes) noexcept;
+         RomImage(Byte const* mapping, std::size_t size) noexcept;
+
+         std::vector<Byte> const copy_{};
+         std::span<Byte const> const bytes_;
+         bool const mapped_{};
+   };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,24 @@
+#ifndef ADDRESSING_MODE_HPP
+#define ADDRESSING_MODE_HPP
+
+namespace nes
+{
+   enum class AddressingMode
+   {
+      IMPLIED,
+      ACCUMULATOR,
+      IMMEDIATE,
+      ZERO_PAGE,
+      ZERO_PAGE_X,
+      ZERO_PAGE_Y,
+      RELATIVE,
+      ABSOLUTE,
+      ABSOLUTE_X,
+      ABSOLUTE_Y,
+      INDIRECT,
+      X_INDIRECT,
+      INDIRECT_Y
+   };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef BINARY_HPP
+#define BINARY_HPP
+
+#include "hardware/types.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   // What the ALU leaves behind outside of decimal mode, shared by everything that executes it. Z and N follow from
+   // the result, and only adding and subtracting change V.
+   struct BinaryResult final
+   {
+      Byte result;
+      bool carry;
+      bool overflow;
+   };
+
+   [[nodiscard]] constexpr BinaryResult add_binary(Byte const accumulator, Byte const value, bool const carry) noexcept
+   {
+      // C set if there was a carry-out, V if there was a signed overflow
+      int const result{ accumulator + value + carry };
+      return { static_cast<Byte>(result), result > 0xFF, ((accumulator ^ result) & (value ^ result) & 0x80) != 0 };
+   }
+
+   [[nodiscard]] constexpr BinaryResult subtract_binary(Byte const accumulator, Byte const value,
+      bool const carry) noexcept
+   {
+      // C set if there was no borrow, V if there was a signed overflow
+      int const result{ accumulator - value - not carry };
+      return { static_cast<Byte>(result), result >= 0, ((accumulator ^ value) & (accumulator ^ result) & 0x80) != 0 };
+   }
+
+   // CMP, CPX and CPY subtract without a borrow and only keep the flags
+   [[nodiscard]] constexpr BinaryResult compare_binary(Byte const left, Byte const right) noexcept
+   {
+      return { static_cast<Byte>(left - right), left >= right, false };
+   }
+
+   // ASL shifts in a zero and ROL the carry, C getting the bit shifted out
+   [[nodiscard]] constexpr BinaryResult shift_left(Byte const value, bool const carry) noexcept
+   {
+      return { static_cast<Byte>(value << 1 | carry), (value & 0x80) != 0, false };
+   }
+
+   // LSR shifts in a zero and ROR the carry, C getting the bit shifted out
+   [[nodiscard]] constexpr BinaryResult shift_right(Byte const value, bool const carry) noexcept
+   {
+      return { static_cast<Byte>(value >> 1 | carry << 7), (value & 0x01) != 0, false };
+   }
+}
+
+#endif
@@ -0,0 +1,160 @@
+#include "block_cache.hpp"
+#include "utility/runtime_assert.hpp"
+
+namespace nes
+{
+   BlockCache::BlockCache(Memory& memory) noexcept
+      : memory_{ memory }
+   {
+   }
+
+   BlockCache::~BlockCache() noexcept
+   {
+      disable();
+   }
+
+   bool BlockCache::enable() noexcept
+   {
+      if (not watcher_)
+         watcher_ = memory_.add_watcher(std::bind_front(&BlockCache::invalidate, this));
+
+      return enabled();
+   }
+
+   void BlockCache::disable() noexcept
+   {
+      if (not watcher_)
+         return;
+
+      // nothing tells the cache about writes from here on, so none of the blocks can be trusted anymore
+      memory_.remove_watcher(*watcher_);
+      watcher_.reset();
+      blocks_.clear();
+      for (std::vector<Word>& entries : entries_by_page_)
+         entries.clear();
+
+      retired_blocks_.clear();
+      ++generation_;
+   }
+
+   bool BlockCache::enabled() const noexcept
+   {
+      return watcher_.has_value();
+   }
+
+   BlockCache::Block const* BlockCache::find(Word const address) noexcept
+   {
+      retired_blocks_.clear();
+
+      auto const block{ blocks_.find(address) };
+      if (block == blocks_.end())
+      {
+         ++misses_;
+         return nullptr;
+      }
+
+      ++hits_;
+      return &block->second;
+   }
+
+   BlockCache::Block const& BlockCache::insert(Word const address, std::vector<PredecodedInstruction> instructions)
+   {
+      runtime_assert(enabled(), "blocks can only be inserted into an enabled block cache");
+
+      std::size_t length{};
+      for (PredecodedInstruction const& instruction : instructions)
+         length += instruction.length;
+
+      auto const [block, did_insert]{
+         blocks_.insert_or_assign(address, Block{
+            .first{ address },
+            .last{ static_cast<Word>(address + length - 1) },
+            .serial{ inserted_blocks_++ },
+            .instructions{ std::move(instructions) }
+         })
+      };
+
+      if (did_insert)
+         for (std::size_t page{ page_of(block->second.first) }; page <= page_of(block->second.last); ++page)
+            entries_by_page_[page].push_back(address);
+
+      retired_blocks_.reserve(retired_blocks_.size() + blocks_.size());
+
+      watch(block->second, true);
+      return block->second;
+   }
+
+   std::size_t BlockCache::generation() const noexcept
+   {
+      return generation_;
+   }
+
+   std::size_t BlockCache::hits() const noexcept
+   {
+      return hits_;
+   }
+
+   std::size_t BlockCache::misses() const noexcept
+   {
+      return misses_;
+   }
+
+   std::size_t BlockCache::invalidations() const noexcept
+   {
+      return invalidations_;
+   }
+
+   void BlockCache::invalidate(Word const first, Word const last) noexcept
+   {
+      std::size_t first_touched_page{ std::numeric_limits<std::size_t>::max() };
+      std::size_t last_touched_page{};
+
+      for (std::size_t page{ page_of(first) }; page <= page_of(last); ++page)
+      {
+         std::vector<Word> const& entries{ entries_by_page_[page] };
+         for (std::size_t index{}; index < entries.size();)
+         {
+            auto const block{ blocks_.find(entries[index]) };
+            if (block->second.last < first or block->second.first > last)
+            {
+               ++index;
+               continue;
+            }
+
+            // removing the entry from every page it is listed on also removes it from the one being walked
+            std::size_t const first_page{ page_of(block->second.first) };
+            std::size_t const last_page{ page_of(block->second.last) };
+            for (std::size_t block_page{ first_page }; block_page <= last_page; ++block_page)
+               std::erase(entries_by_page_[block_page], block->first);
+
+            first_touched_page = std::min(first_touched_page, first_page);
+            last_touched_page = std::max(last_touched_page, last_page);
+
+            watch(block->second, false);
+            retired_blocks_.push_back(std::move(block->second));
+            blocks_.erase(block);
+            ++invalidations_;
+         }
+      }
+
+      if (first_touched_page > last_touched_page)
+         return;
+
+      // blocks may overlap, so restore what unwatching the dropped ones cleared from the surviving ones
+      for (std::size_t page{ first_touched_page }; page <= last_touched_page; ++page)
+         for (Word const entry : entries_by_page_[page])
+            watch(blocks_.at(entry), true);
+
+      ++generation_;
+   }
+
+   std::size_t BlockCache::page_of(Word const address) noexcept
+   {
+      return address >> 8u;
+   }
+
+   void BlockCache::watch(Block const& block, bool const watched) noexcept
+   {
+      memory_.watch(*watcher_, block.first, block.last, watched);
+   }
+}
\ No newline at end of file
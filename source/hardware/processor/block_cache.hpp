@@ -0,0 +1,73 @@
+#ifndef BLOCK_CACHE_HPP
+#define BLOCK_CACHE_HPP
+
+#include "hardware/memory/memory.hpp"
+#include "pch.hpp"
+#include "predecoded_instruction.hpp"
+
+namespace nes
+{
+   // Straight-line runs of predecoded instructions keyed by the address they start at. The cache watches the bytes
+   // every block was decoded from and drops exactly the blocks a write (or a program load) touches. It only holds a
+   // watcher of the memory, and blocks, while it is enabled.
+   class BlockCache final
+   {
+      public:
+         struct Block final
+         {
+            Word first;
+            Word last;
+            std::size_t serial;
+            std::vector<PredecodedInstruction> instructions;
+         };
+
+         explicit BlockCache(Memory& memory) noexcept;
+         BlockCache(BlockCache const&) = delete;
+         BlockCache(BlockCache&&) = delete;
+
+         ~BlockCache() noexcept;
+
+         BlockCache& operator=(BlockCache const&) = delete;
+         BlockCache& operator=(BlockCache&&) = delete;
+
+         // takes a watcher of the memory if it has none yet, returning whether it has one
+         [[nodiscard]] bool enable() noexcept;
+         // drops every block and hands the watcher back
+         void disable() noexcept;
+         [[nodiscard]] bool enabled() const noexcept;
+
+         [[nodiscard]] Block const* find(Word address) noexcept;
+         Block const& insert(Word address, std::vector<PredecodedInstruction> instructions);
+
+         // changes whenever blocks are dropped; a block being executed must be abandoned once it does
+         [[nodiscard]] std::size_t generation() const noexcept;
+
+         [[nodiscard]] std::size_t hits() const noexcept;
+         [[nodiscard]] std::size_t misses() const noexcept;
+         [[nodiscard]] std::size_t invalidations() const noexcept;
+
+      private:
+         // runs as a watcher of the memory, whose writes cannot fail, so it never allocates
+         void invalidate(Word first, Word last) noexcept;
+         [[nodiscard]] static std::size_t page_of(Word address) noexcept;
+         void watch(Block const& block, bool watched) noexcept;
+
+         Memory& memory_;
+         std::optional<Memory::WatcherId> watcher_{};
+
+         std::unordered_map<Word, Block> blocks_{};
+         std::array<std::vector<Word>, 256> entries_by_page_{};
+
+         // Dropped blocks are kept alive until the next lookup, as one of them may still be executing. Inserting a
+         // block makes room for every block there is to be dropped, so dropping one never allocates.
+         std::vector<Block> retired_blocks_{};
+
+         std::size_t generation_{};
+         std::size_t inserted_blocks_{};
+         std::size_t hits_{};
+         std::size_t misses_{};
+         std::size_t invalidations_{};
+   };
+}
+
+#endif
\ No newline at end of file
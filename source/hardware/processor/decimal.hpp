@@ -0,0 +1,72 @@
+#ifndef DECIMAL_HPP
+#define DECIMAL_HPP
+
+#include "hardware/types.hpp"
+#include "pch.hpp"
+#include "variant.hpp"
+
+namespace nes
+{
+   // What ADC and SBC leave behind in decimal mode, shared by everything that executes them
+   struct DecimalResult final
+   {
+      Byte result;
+      bool carry;
+      bool overflow;
+      bool zero;
+      bool negative;
+   };
+
+   [[nodiscard]] constexpr DecimalResult add_decimal(Byte const accumulator, Byte const value,
+      bool const carry) noexcept
+   {
+      // add digit by digit, adjusting a digit that went past 9
+      int low{ (accumulator & 0x0F) + (value & 0x0F) + carry };
+      if (low > 0x09)
+         low += 0x06;
+
+      int high{ (accumulator >> 4) + (value >> 4) + (low > 0x0F) };
+      auto const unadjusted{ static_cast<Byte>(high << 4 | (low & 0x0F)) };
+
+      // V set if there was a signed overflow before adjusting the high digit
+      bool const overflow{ ((accumulator ^ unadjusted) & (value ^ unadjusted) & 0x80) != 0 };
+
+      if (high > 0x09)
+         high += 0x06;
+
+      auto const result{ static_cast<Byte>(high << 4 | (low & 0x0F)) };
+      if constexpr (Variant::DECIMAL_FLAGS_FROM_BINARY)
+         return { result, high > 0x0F, overflow, not static_cast<Byte>(accumulator + value + carry),
+            (unadjusted & 0x80) != 0 };
+      else
+         return { result, high > 0x0F, overflow, not result, (result & 0x80) != 0 };
+   }
+
+   [[nodiscard]] constexpr DecimalResult subtract_decimal(Byte const accumulator, Byte const value,
+      bool const carry) noexcept
+   {
+      bool const borrow{ not carry };
+
+      // subtract digit by digit, adjusting a digit that went below 0
+      int low{ (accumulator & 0x0F) - (value & 0x0F) - borrow };
+      int high{ (accumulator >> 4) - (value >> 4) - (low < 0) };
+      if (low < 0)
+         low -= 0x06;
+
+      if (high < 0)
+         high -= 0x06;
+
+      auto const binary{ accumulator - value - borrow };
+
+      // C set if there was no borrow, V if there was a signed overflow
+      bool const overflow{ ((accumulator ^ value) & (accumulator ^ binary) & 0x80) != 0 };
+
+      auto const result{ static_cast<Byte>(high << 4 | (low & 0x0F)) };
+      if constexpr (Variant::DECIMAL_FLAGS_FROM_BINARY)
+         return { result, binary >= 0, overflow, not static_cast<Byte>(binary), (binary & 0x80) != 0 };
+      else
+         return { result, binary >= 0, overflow, not result, (result & 0x80) != 0 };
+   }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "disassembler.hpp"
+#include "opcode_info.hpp"
+
+namespace nes
+{
+   std::string Disassembler::disassemble(Memory const& memory, Word const address)
+   {
+      OpcodeInfo const& info{ OPCODE_INFOS[memory.read(address)] };
+      Byte const low{ memory.read(static_cast<Word>(address + 1)) };
+      auto const word{ static_cast<Word>(memory.read(static_cast<Word>(address + 2)) << 8 | low) };
+
+      switch (info.mode)
+      {
+         case AddressingMode::IMPLIED:
+            return std::string{ info.mnemonic };
+
+         case AddressingMode::ACCUMULATOR:
+            return std::format("{} A", info.mnemonic);
+
+         case AddressingMode::IMMEDIATE:
+            return std::format("{} #${:02X}", info.mnemonic, low);
+
+         case AddressingMode::ZERO_PAGE:
+            return std::format("{} ${:02X}", info.mnemonic, low);
+
+         case AddressingMode::ZERO_PAGE_X:
+            return std::format("{} ${:02X},X", info.mnemonic, low);
+
+         case AddressingMode::ZERO_PAGE_Y:
+            return std::format("{} ${:02X},Y", info.mnemonic, low);
+
+         case AddressingMode::RELATIVE:
+            return std::format("{} ${:04X}", info.mnemonic,
+               static_cast<Word>(address + info.length + static_cast<SignedByte>(low)));
+
+         case AddressingMode::ABSOLUTE:
+            return std::format("{} ${:04X}", info.mnemonic, word);
+
+         case AddressingMode::ABSOLUTE_X:
+            return std::format("{} ${:04X},X", info.mnemonic, word);
+
+         case AddressingMode::ABSOLUTE_Y:
+            return std::format("{} ${:04X},Y", info.mnemonic, word);
+
+         case AddressingMode::INDIRECT:
+            return std::format("{} (${:04X})", info.mnemonic, word);
+
+         case AddressingMode::X_INDIRECT:
+            return std::format("{} (${:02X},X)", info.mnemonic, low);
+
+         default:
+            return std::format("{} (${:02X}),Y", info.mnemonic, low);
+      }
+   }
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#ifndef DISASSEMBLER_HPP
+#define DISASSEMBLER_HPP
+
+#include "hardware/memory/memory.hpp"
+#include "hardware/types.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   // Renders instructions in memory as assembly, e.g. "LDA $1234,X", driven by the opcode metadata table
+   class Disassembler final
+   {
+      public:
+         Disassembler() = delete;
+
+         [[nodiscard]] static std::string disassemble(Memory const& memory, Word address);
+   };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "frame_pool.hpp"
+
+namespace nes
+{
+   FramePool::FramePool() noexcept
+   {
+      for (Block& block : blocks_)
+      {
+         block.owner = this;
+         block.next_free = std::exchange(free_list_, &block);
+      }
+   }
+
+   void* FramePool::allocate(std::size_t const size)
+   {
+      if (size <= BLOCK_SIZE and free_list_) [[likely]]
+         return std::exchange(free_list_, free_list_->next_free)->frame;
+
+      // the slab is exhausted or the frame does not fit in a block; fall back to the heap
+      ++heap_allocations_;
+      void* const memory{ ::operator new(std::max(sizeof(Block), offsetof(Block, frame) + size)) };
+      Block* const block{ ::new(memory) Block{} };
+      return block->frame;
+   }
+
+   void FramePool::deallocate(void* const frame) noexcept
+   {
+      Block* const block{ block_from_frame(frame) };
+      if (FramePool* const owner{ block->owner }) [[likely]]
+         block->next_free = std::exchange(owner->free_list_, block);
+      else
+         ::operator delete(block);
+   }
+
+   std::size_t FramePool::heap_allocations() const noexcept
+   {
+      return heap_allocations_;
+   }
+
+   FramePool::Block* FramePool::block_from_frame(void* const frame) noexcept
+   {
+      return reinterpret_cast<Block*>(static_cast<std::byte*>(frame) - offsetof(Block, frame));
+   }
+}
\ No newline at end of file
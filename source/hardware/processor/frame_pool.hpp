@@ -0,0 +1,47 @@
+#ifndef FRAME_POOL_HPP
+#define FRAME_POOL_HPP
+
+#include "pch.hpp"
+
+namespace nes
+{
+   // Fixed-size slab the processor's instruction coroutine frames are carved out of. At most a couple of
+   // instructions are alive at once (the current one and the one a branch prefetched), so a handful of
+   // blocks covers steady-state emulation; anything beyond that falls back to the heap and is counted.
+   class FramePool final
+   {
+      public:
+         static std::size_t constexpr BLOCK_SIZE{ 256 };
+         static std::size_t constexpr BLOCK_COUNT{ 4 };
+
+         FramePool() noexcept;
+         FramePool(FramePool const&) = delete;
+         FramePool(FramePool&&) = delete;
+
+         ~FramePool() noexcept = default;
+
+         FramePool& operator=(FramePool const&) = delete;
+         FramePool& operator=(FramePool&&) = delete;
+
+         [[nodiscard]] void* allocate(std::size_t size);
+         static void deallocate(void* frame) noexcept;
+
+         [[nodiscard]] std::size_t heap_allocations() const noexcept;
+
+      private:
+         struct Block final
+         {
+            FramePool* owner;
+            Block* next_free;
+            alignas(std::max_align_t) std::byte frame[BLOCK_SIZE];
+         };
+
+         [[nodiscard]] static Block* block_from_frame(void* frame) noexcept;
+
+         std::array<Block, BLOCK_COUNT> blocks_;
+         Block* free_list_{};
+         std::size_t heap_allocations_{};
+   };
+}
+
+#endif
\ No newline at end of file
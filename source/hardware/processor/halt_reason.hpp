@@ -0,0 +1,43 @@
+#ifndef HALT_REASON_HPP
+#define HALT_REASON_HPP
+
+#include "hardware/types.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   // Why the processor cannot make progress any more, and the instruction it got stuck at
+   struct HaltReason final
+   {
+      enum class Cause
+      {
+         // a jump or taken branch to its own address, which nothing short of a reset can leave
+         TRAP,
+         // one of the opcodes that lock the processor up until it is reset
+         JAM,
+         // an opcode none of the cores implements, which freezes the processor like a JAM
+         UNSUPPORTED_OPCODE
+      };
+
+      [[nodiscard]] constexpr std::string_view description() const noexcept
+      {
+         switch (cause)
+         {
+            case Cause::TRAP:
+               return "trapped";
+
+            case Cause::JAM:
+               return "jammed";
+
+            default:
+               return "encountered an unsupported opcode";
+         }
+      }
+
+      Cause cause;
+      Word program_counter;
+      Byte opcode;
+   };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "hook_registry.hpp"
+
+namespace nes
+{
+   HookRegistry::Hook& HookRegistry::add(std::string name, Word const entry_point, std::span<Byte const> const code,
+      Routine routine)
+   {
+      entry_points_[entry_point] = true;
+      return hooks_.insert_or_assign(entry_point, Hook{
+         .name{ std::move(name) },
+         .entry_point{ entry_point },
+         .length{ code.size() },
+         .fingerprint{ fingerprint(code) },
+         .routine{ std::move(routine) },
+         .calls{},
+         .verifications{},
+         .mismatches{}
+      }).first->second;
+   }
+
+   void HookRegistry::remove(Word const entry_point) noexcept
+   {
+      entry_points_[entry_point] = false;
+      hooks_.erase(entry_point);
+   }
+
+   void HookRegistry::set_verifying(bool const verifying) noexcept
+   {
+      verifying_ = verifying;
+   }
+
+   HookRegistry::Hook* HookRegistry::find(Memory const& memory, Word const entry_point) noexcept
+   {
+      if (not entry_points_[entry_point])
+         return nullptr;
+
+      Hook& hook{ hooks_.find(entry_point)->second };
+      if (fingerprint(memory, entry_point, hook.length) not_eq hook.fingerprint)
+         return nullptr;
+
+      return &hook;
+   }
+
+   bool HookRegistry::verifying() const noexcept
+   {
+      return verifying_;
+   }
+
+   std::unordered_map<Word, HookRegistry::Hook> const& HookRegistry::hooks() const noexcept
+   {
+      return hooks_;
+   }
+
+   std::uint32_t HookRegistry::fingerprint(std::span<Byte const> const code) noexcept
+   {
+      std::uint32_t fingerprint{ FINGERPRINT_BASIS };
+      for (Byte const byte : code)
+         fingerprint = (fingerprint ^ byte) * FINGERPRINT_PRIME;
+
+      return fingerprint;
+   }
+
+   std::uint32_t HookRegistry::fingerprint(Memory const& memory, Word const first, std::size_t const length) noexcept
+   {
+      std::uint32_t fingerprint{ FINGERPRINT_BASIS };
+      for (std::size_t offset{}; offset < length; ++offset)
+         fingerprint = (fingerprint ^ memory.read(static_cast<Word>(first + offset))) * FINGERPRINT_PRIME;
+
+      return fingerprint;
+   }
+}
\ No newline at end of file
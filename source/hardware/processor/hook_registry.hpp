@@ -0,0 +1,78 @@
+#ifndef HOOK_REGISTRY_HPP
+#define HOOK_REGISTRY_HPP
+
+#include "hardware/memory/memory.hpp"
+#include "hardware/types.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   // Native implementations of guest subroutines, keyed by their entry point and a fingerprint of their code. A
+   // processor the registry is installed in runs the implementation in place of the subroutine when it reaches the
+   // entry point at an instruction boundary, as it does after a JSR, and the code there still has the fingerprint.
+   // The processor then returns from the subroutine like its RTS would.
+   // When verifying, the processor interprets the subroutine anyway and compares where it returns with what the
+   // implementation did to a copy of the registers and memory.
+   class HookRegistry final
+   {
+      public:
+         struct Registers final
+         {
+            Accumulator accumulator;
+            Index x;
+            Index y;
+            StackPointer stack_pointer;
+            ProcessorStatus processor_status;
+         };
+
+         // applies the effects of the subroutine up to its RTS, the return itself excluded, and returns the cycles the
+         // subroutine takes up to and including its RTS
+         using Routine = std::function<Cycle(Registers& registers, Memory& memory)>;
+
+         struct Hook final
+         {
+            std::string name;
+            Word entry_point;
+            std::size_t length;
+            std::uint32_t fingerprint;
+            Routine routine;
+
+            std::size_t calls;
+            std::size_t verifications;
+            std::size_t mismatches;
+         };
+
+         HookRegistry() = default;
+         HookRegistry(HookRegistry const&) = delete;
+         HookRegistry(HookRegistry&&) = delete;
+
+         ~HookRegistry() noexcept = default;
+
+         HookRegistry& operator=(HookRegistry const&) = delete;
+         HookRegistry& operator=(HookRegistry&&) = delete;
+
+         // the code is what the subroutine looks like from its entry point on, replacing any hook at the entry point
+         Hook& add(std::string name, Word entry_point, std::span<Byte const> code, Routine routine);
+         void remove(Word entry_point) noexcept;
+         void set_verifying(bool verifying) noexcept;
+
+         // the hook at the entry point, provided the code in memory still has its fingerprint
+         [[nodiscard]] Hook* find(Memory const& memory, Word entry_point) noexcept;
+         [[nodiscard]] bool verifying() const noexcept;
+         [[nodiscard]] std::unordered_map<Word, Hook> const& hooks() const noexcept;
+
+         [[nodiscard]] static std::uint32_t fingerprint(std::span<Byte const> code) noexcept;
+         [[nodiscard]] static std::uint32_t fingerprint(Memory const& memory, Word first, std::size_t length) noexcept;
+
+      private:
+         // FNV-1a
+         static std::uint32_t constexpr FINGERPRINT_BASIS{ 0x81'1C'9D'C5 };
+         static std::uint32_t constexpr FINGERPRINT_PRIME{ 0x01'00'01'93 };
+
+         std::unordered_map<Word, Hook> hooks_{};
+         std::vector<bool> entry_points_ = std::vector<bool>(std::numeric_limits<Word>::max() + 1);
+         bool verifying_{};
+   };
+}
+
+#endif
\ No newline at end of file
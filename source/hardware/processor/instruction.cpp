@@ -24,15 +24,21 @@ namespace nes
       return *this;
    }
 
-   bool Instruction::tick() const
+   bool Instruction::tick()
    {
       handle_.resume();
-      return handle_.done();
+      if (not handle_.done())
+         return false;
+
+      auto const successor{ std::exchange(handle_.promise().successor, nullptr) };
+      destroy_handle();
+      handle_ = successor;
+      return true;
    }
 
-   std::optional<Instruction>&& Instruction::prefetched_instruction() const
+   Instruction::operator bool() const noexcept
    {
-      return std::move(handle_.promise().prefetched_instruction);
+      return static_cast<bool>(handle_);
    }
 
    void Instruction::destroy_handle() const
@@ -41,6 +47,11 @@ namespace nes
          handle_.destroy();
    }
 
+   void Instruction::promise_type::operator delete(void* const frame) noexcept
+   {
+      FramePool::deallocate(frame);
+   }
+
    std::suspend_always Instruction::promise_type::initial_suspend() noexcept
    {
       return {};
@@ -55,9 +66,13 @@ namespace nes
    {
    }
 
-   void Instruction::promise_type::return_value(std::optional<Instruction> instruction)
+   void Instruction::promise_type::return_value(std::nullopt_t) noexcept
+   {
+   }
+
+   void Instruction::promise_type::return_value(Instruction successor) noexcept
    {
-      prefetched_instruction = std::move(instruction);
+      this->successor = std::exchange(successor.handle_, nullptr);
    }
 
    Instruction Instruction::promise_type::get_return_object()
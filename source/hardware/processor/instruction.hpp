@@ -1,6 +1,7 @@
 #ifndef INSTRUCTION_HPP
 #define INSTRUCTION_HPP
 
+#include "frame_pool.hpp"
 #include "pch.hpp"
 
 namespace nes
@@ -10,6 +11,7 @@ namespace nes
       public:
          struct promise_type;
 
+         Instruction() noexcept = default;
          explicit Instruction(std::coroutine_handle<promise_type> handle);
          Instruction(Instruction const&) = delete;
          Instruction(Instruction&& other) noexcept;
@@ -19,25 +21,38 @@ namespace nes
          Instruction& operator=(Instruction const&) = delete;
          Instruction& operator=(Instruction&& other) noexcept;
 
-         [[nodiscard]] bool tick() const;
-         [[nodiscard]] std::optional<Instruction>&& prefetched_instruction() const;
+         // runs the next cycle; once the instruction is done, it is replaced in place by the successor it handed over
+         [[nodiscard]] bool tick();
+
+         [[nodiscard]] explicit operator bool() const noexcept;
 
       private:
          void destroy_handle() const;
 
-         std::coroutine_handle<promise_type> handle_;
+         std::coroutine_handle<promise_type> handle_{};
    };
 
    struct Instruction::promise_type
    {
+      // instructions are always member coroutines of their owner, which is passed first and provides the frame pool
+      template <typename Owner, typename... Arguments>
+      static void* operator new(std::size_t const size, Owner& owner, Arguments const&...)
+      {
+         return owner.frame_pool_.allocate(size);
+      }
+
+      static void operator delete(void* frame) noexcept;
+
       static std::suspend_always initial_suspend() noexcept;
       static std::suspend_always final_suspend() noexcept;
       static void unhandled_exception();
-      void return_value(std::optional<Instruction> instruction);
+      static void return_value(std::nullopt_t) noexcept;
+      void return_value(Instruction successor) noexcept;
 
       Instruction get_return_object();
 
-      std::optional<Instruction> prefetched_instruction{};
+      // the instruction a branch prefetched, owned by the promise until the branch is done
+      std::coroutine_handle<promise_type> successor{};
    };
 }
 
@@ -0,0 +1,606 @@
+#include "processor.hpp"
+#include "profiler.hpp"
+
+namespace nes
+{
+   void Processor::step()
+   {
+      if (hooks_ and run_hook())
+         return;
+
+      PredecodedInstruction const instruction{ predecode(program_counter) };
+      if (cycle_ < cycle_limit_)
+         skip_idle_loop(program_counter, static_cast<Opcode>(instruction.opcode));
+
+      execute(instruction);
+   }
+
+   void Processor::run_predecoded(Cycle const budget)
+   {
+      Cycle const start{ cycle_ };
+      // run_until tests its predicate after every instruction, which whole translations and fused sequences skip over
+      bool const per_instruction{ static_cast<bool>(stop_predicate_.holds) };
+      while (cycle_ - start < budget)
+      {
+         if (hooks_ and run_hook())
+         {
+            if (stop_requested())
+               return;
+
+            continue;
+         }
+
+         if (not per_instruction and static_translation_
+            and static_translation_->run(*this, budget - (cycle_ - start)))
+            continue;
+
+         BlockCache::Block const* block{ block_cache_.find(program_counter) };
+         if (not block)
+         {
+            std::vector instructions{ predecode_block(program_counter) };
+            if (instructions.empty())
+            {
+               step();
+               if (stop_requested())
+                  return;
+
+               continue;
+            }
+
+            block = &block_cache_.insert(program_counter, std::move(instructions));
+         }
+
+         // only block heads are probed, which is where the loops skipped start
+         if (cycle_ < cycle_limit_)
+            skip_idle_loop(program_counter, static_cast<Opcode>(block->instructions.front().opcode));
+
+         if (not per_instruction and core_ == Core::RECOMPILED
+            and recompiler_.run(*block, *this, budget - (cycle_ - start)))
+            continue;
+
+         // a write to any decoded byte (the block's own included) invalidates it, so stop executing it right away
+         std::size_t const generation{ block_cache_.generation() };
+         std::vector<PredecodedInstruction> const& instructions{ block->instructions };
+         for (std::size_t index{}; index < instructions.size();)
+         {
+            PredecodedInstruction const& instruction{ instructions[index] };
+            if (fusion_ and not per_instruction and instruction.fused_handler)
+            {
+               instruction.fused_handler(*this, &instruction);
+               index += instruction.fused_count;
+               ++fusions_;
+            }
+            else
+            {
+               execute(instruction);
+               ++index;
+            }
+
+            if (stop_requested())
+               return;
+
+            if (cycle_ - start >= budget or block_cache_.generation() != generation)
+               break;
+         }
+      }
+   }
+
+   PredecodedInstruction Processor::predecode(Word const address) const noexcept
+   {
+      PredecodedInstruction instruction{ PREDECODED_INSTRUCTIONS[memory_.read(address)] };
+      if (instruction.length > 1)
+         instruction.operand = memory_.read(static_cast<Word>(address + 1));
+      if (instruction.length > 2)
+         instruction.operand = assign_high_byte(instruction.operand, memory_.read(static_cast<Word>(address + 2)));
+
+      return instruction;
+   }
+
+   std::vector<PredecodedInstruction> Processor::predecode_block(Word const address) const
+   {
+      std::vector<PredecodedInstruction> instructions{};
+      std::size_t next_address{ address };
+      while (instructions.size() < MAX_BLOCK_INSTRUCTIONS)
+      {
+         PredecodedInstruction const instruction{ predecode(static_cast<Word>(next_address)) };
+
+         // blocks never wrap around the end of the address space
+         next_address += instruction.length;
+         if (next_address > std::numeric_limits<Word>::max() + 1)
+            break;
+
+         instructions.push_back(instruction);
+         if (ends_block(static_cast<Opcode>(instruction.opcode)))
+            break;
+      }
+
+      fuse(instructions, address);
+      return instructions;
+   }
+
+   void Processor::execute(PredecodedInstruction const& instruction)
+   {
+      current_opcode_ = static_cast<Opcode>(instruction.opcode);
+      if (profiler_)
+         profiler_->record(instruction.opcode);
+
+      program_counter += instruction.length;
+      instruction.handler(*this, instruction.operand);
+   }
+
+   template <Byte OPCODE>
+   constexpr PredecodedInstruction Processor::predecoded_instruction() noexcept
+   {
+      OpcodeInfo constexpr INFO{ OPCODE_INFOS[OPCODE] };
+      return {
+         .handler{ predecoded_handler<OPCODE>() },
+         .operand{},
+         .opcode{ OPCODE },
+         // an unsupported opcode halts once it is fetched
+         .length{ INFO.official ? INFO.length : Byte{ 1 } },
+         .fused_handler{},
+         .fused_count{}
+      };
+   }
+
+   template <Byte OPCODE>
+   constexpr PredecodedInstruction::Handler Processor::predecoded_handler() noexcept
+   {
+      OpcodeInfo constexpr INFO{ OPCODE_INFOS[OPCODE] };
+      if constexpr (not INFO.official)
+         return &handle<&Processor::execute_unsupported>;
+      else if constexpr (INFO.mode == AddressingMode::RELATIVE)
+         return &handle<&Processor::execute_relative<branch_operation(INFO.mnemonic), OPCODE>>;
+      else if constexpr (read_operation(INFO.mnemonic) not_eq nullptr)
+         return &handle<&Processor::execute_read<read_operation(INFO.mnemonic), OPCODE>>;
+      else if constexpr (modify_operation(INFO.mnemonic) not_eq nullptr)
+         return &handle<&Processor::execute_modify<modify_operation(INFO.mnemonic), OPCODE>>;
+      else if constexpr (write_operation(INFO.mnemonic) not_eq nullptr)
+         return &handle<&Processor::execute_write<write_operation(INFO.mnemonic), OPCODE>>;
+      else
+         return implied_predecoded_handler(INFO);
+   }
+
+   constexpr PredecodedInstruction::Handler Processor::implied_predecoded_handler(OpcodeInfo const& info) noexcept
+   {
+      if (info.mnemonic == "BRK")
+         return &handle<&Processor::execute_BRK>;
+      if (info.mnemonic == "PHP")
+         return &handle<&Processor::execute_PHP>;
+      if (info.mnemonic == "CLC")
+         return &handle<&Processor::execute_flag<ProcessorStatusFlag::C, false>>;
+      if (info.mnemonic == "JSR")
+         return &handle<&Processor::execute_JSR>;
+      if (info.mnemonic == "PLP")
+         return &handle<&Processor::execute_PLP>;
+      if (info.mnemonic == "SEC")
+         return &handle<&Processor::execute_flag<ProcessorStatusFlag::C, true>>;
+      if (info.mnemonic == "RTI")
+         return &handle<&Processor::execute_RTI>;
+      if (info.mnemonic == "PHA")
+         return &handle<&Processor::execute_PHA>;
+      if (info.mnemonic == "JMP" and info.mode == AddressingMode::ABSOLUTE)
+         return &handle<&Processor::execute_JMP_absolute>;
+      if (info.mnemonic == "CLI")
+         return &handle<&Processor::execute_flag<ProcessorStatusFlag::I, false>>;
+      if (info.mnemonic == "RTS")
+         return &handle<&Processor::execute_RTS>;
+      if (info.mnemonic == "PLA")
+         return &handle<&Processor::execute_PLA>;
+      if (info.mnemonic == "JMP" and info.mode == AddressingMode::INDIRECT)
+         return &handle<&Processor::execute_JMP_indirect>;
+      if (info.mnemonic == "SEI")
+         return &handle<&Processor::execute_flag<ProcessorStatusFlag::I, true>>;
+      if (info.mnemonic == "DEY")
+         return &handle<&Processor::execute_decrement<&Processor::y_>>;
+      if (info.mnemonic == "TXA")
+         return &handle<&Processor::execute_transfer<&Processor::x_, &Processor::accumulator_>>;
+      if (info.mnemonic == "TYA")
+         return &handle<&Processor::execute_transfer<&Processor::y_, &Processor::accumulator_>>;
+      if (info.mnemonic == "TXS")
+         return &handle<&Processor::execute_TXS>;
+      if (info.mnemonic == "TAY")
+         return &handle<&Processor::execute_transfer<&Processor::accumulator_, &Processor::y_>>;
+      if (info.mnemonic == "TAX")
+         return &handle<&Processor::execute_transfer<&Processor::accumulator_, &Processor::x_>>;
+      if (info.mnemonic == "CLV")
+         return &handle<&Processor::execute_flag<ProcessorStatusFlag::V, false>>;
+      if (info.mnemonic == "TSX")
+         return &handle<&Processor::execute_transfer<&Processor::stack_pointer_, &Processor::x_>>;
+      if (info.mnemonic == "INY")
+         return &handle<&Processor::execute_increment<&Processor::y_>>;
+      if (info.mnemonic == "DEX")
+         return &handle<&Processor::execute_decrement<&Processor::x_>>;
+      if (info.mnemonic == "CLD")
+         return &handle<&Processor::execute_flag<ProcessorStatusFlag::D, false>>;
+      if (info.mnemonic == "INX")
+         return &handle<&Processor::execute_increment<&Processor::x_>>;
+      if (info.mnemonic == "NOP")
+         return &handle<&Processor::execute_NOP>;
+      if (info.mnemonic == "SED")
+         return &handle<&Processor::execute_flag<ProcessorStatusFlag::D, true>>;
+
+      return &handle<&Processor::execute_unsupported>;
+   }
+
+   constexpr std::array<PredecodedInstruction, 256> Processor::PREDECODED_INSTRUCTIONS{
+      []<std::size_t... OPCODES>(std::index_sequence<OPCODES...>)
+      {
+         return std::array<PredecodedInstruction, 256>{ predecoded_instruction<OPCODES>()... };
+      }(std::make_index_sequence<256>{})
+   };
+
+   bool Processor::ends_block(Opcode const opcode) noexcept
+   {
+      switch (opcode)
+      {
+         case Opcode::BRK_IMPLIED:
+         case Opcode::BPL_RELATIVE:
+         case Opcode::JSR_ABSOLUTE:
+         case Opcode::BMI_RELATIVE:
+         case Opcode::RTI_IMPLIED:
+         case Opcode::JMP_ABSOLUTE:
+         case Opcode::BVC_RELATIVE:
+         case Opcode::RTS_IMPLIED:
+         case Opcode::JMP_INDIRECT:
+         case Opcode::BVS_RELATIVE:
+         case Opcode::BCC_RELATIVE:
+         case Opcode::BCS_RELATIVE:
+         case Opcode::BNE_RELATIVE:
+         case Opcode::BEQ_RELATIVE:
+            return true;
+
+         default:
+            return not OPCODE_INFOS[static_cast<Byte>(opcode)].official;
+      }
+   }
+
+   void Processor::fuse(std::vector<PredecodedInstruction>& instructions, Word const address) noexcept
+   {
+      // the sequences most frequent within the blocks of the functional test, and idioms common in other programs;
+      // only the last instruction of a sequence may write anywhere but the stack
+      static std::array<Fusion, 26> constexpr FUSIONS{
+         fusion<Opcode::INY_IMPLIED, Opcode::CPY_IMMEDIATE, Opcode::BNE_RELATIVE>(),
+         fusion<Opcode::INX_IMPLIED, Opcode::CPX_IMMEDIATE, Opcode::BNE_RELATIVE>(),
+         fusion<Opcode::PHP_IMPLIED, Opcode::CMP_ZERO_PAGE, Opcode::BNE_RELATIVE>(),
+         fusion<Opcode::PLA_IMPLIED, Opcode::AND_IMMEDIATE, Opcode::CMP_ZERO_PAGE>(),
+         fusion<Opcode::CMP_ZERO_PAGE, Opcode::BNE_RELATIVE>(),
+         fusion<Opcode::CMP_IMMEDIATE, Opcode::BNE_RELATIVE>(),
+         fusion<Opcode::CMP_IMMEDIATE, Opcode::BEQ_RELATIVE>(),
+         fusion<Opcode::PLA_IMPLIED, Opcode::AND_IMMEDIATE>(),
+         fusion<Opcode::AND_IMMEDIATE, Opcode::CMP_ZERO_PAGE>(),
+         fusion<Opcode::PHP_IMPLIED, Opcode::LDA_ZERO_PAGE>(),
+         fusion<Opcode::PHP_IMPLIED, Opcode::CMP_ZERO_PAGE>(),
+         fusion<Opcode::PLP_IMPLIED, Opcode::PHP_IMPLIED>(),
+         fusion<Opcode::LDA_IMMEDIATE, Opcode::STA_ZERO_PAGE>(),
+         fusion<Opcode::LDA_IMMEDIATE, Opcode::STA_ABSOLUTE>(),
+         fusion<Opcode::LDA_ZERO_PAGE, Opcode::STA_ZERO_PAGE>(),
+         fusion<Opcode::LDA_ZERO_PAGE, Opcode::STA_ABSOLUTE>(),
+         fusion<Opcode::LDA_ABSOLUTE, Opcode::STA_ZERO_PAGE>(),
+         fusion<Opcode::LDA_ABSOLUTE, Opcode::STA_ABSOLUTE>(),
+         fusion<Opcode::LDA_INDIRECT_Y, Opcode::STA_INDIRECT_Y>(),
+         fusion<Opcode::CLC_IMPLIED, Opcode::ADC_IMMEDIATE>(),
+         fusion<Opcode::CLC_IMPLIED, Opcode::ADC_ZERO_PAGE>(),
+         fusion<Opcode::CLC_IMPLIED, Opcode::ADC_ABSOLUTE>(),
+         fusion<Opcode::SEC_IMPLIED, Opcode::SBC_IMMEDIATE_E9>(),
+         fusion<Opcode::DEX_IMPLIED, Opcode::BNE_RELATIVE>(),
+         fusion<Opcode::DEY_IMPLIED, Opcode::BNE_RELATIVE>(),
+         fusion<Opcode::INY_IMPLIED, Opcode::BNE_RELATIVE>()
+      };
+
+      Word first{ address };
+      for (std::size_t index{}; index < instructions.size();)
+      {
+         auto const matches{
+            [&instructions, index](Fusion const& fusion)
+            {
+               if (index + fusion.count > instructions.size())
+                  return false;
+
+               for (std::size_t offset{}; offset < fusion.count; ++offset)
+                  if (instructions[index + offset].opcode not_eq static_cast<Byte>(fusion.opcodes[offset]))
+                     return false;
+
+               return true;
+            }
+         };
+
+         std::size_t length{};
+         auto const fusion{ std::ranges::find_if(FUSIONS, matches) };
+         if (fusion not_eq FUSIONS.end())
+            for (std::size_t offset{}; offset < fusion->count; ++offset)
+               length += instructions[index + offset].length;
+
+         // a push at the start of a sequence that lies on the stack page could change the rest of it
+         bool const on_stack_page{ first <= 0x01'FF and first + length > 0x01'00 };
+         if (fusion == FUSIONS.end() or on_stack_page)
+         {
+            first += instructions[index].length;
+            ++index;
+            continue;
+         }
+
+         instructions[index].fused_handler = fusion->handler;
+         instructions[index].fused_count = fusion->count;
+         first += static_cast<Word>(length);
+         index += fusion->count;
+      }
+   }
+
+   template <Processor::Opcode OPCODE>
+   void Processor::execute(PredecodedInstruction const& instruction)
+   {
+      current_opcode_ = OPCODE;
+      if (profiler_)
+         profiler_->record(static_cast<Byte>(OPCODE));
+
+      program_counter += instruction.length;
+      PredecodedInstruction::Handler constexpr HANDLER{ predecoded_handler<static_cast<Byte>(OPCODE)>() };
+      HANDLER(*this, instruction.operand);
+   }
+
+   template <AddressingMode MODE>
+   Word Processor::effective_address(Word const operand, bool const always_fix) noexcept
+   {
+      if constexpr (MODE == AddressingMode::ZERO_PAGE or MODE == AddressingMode::ABSOLUTE)
+         return operand;
+      else if constexpr (MODE == AddressingMode::ZERO_PAGE_X or MODE == AddressingMode::ZERO_PAGE_Y)
+      {
+         // the processor reads the zero page address while it adds the index to it
+         dummy_read(operand);
+         return static_cast<Byte>(operand + (MODE == AddressingMode::ZERO_PAGE_X ? x_ : y_));
+      }
+      else if constexpr (MODE == AddressingMode::ABSOLUTE_X or MODE == AddressingMode::ABSOLUTE_Y)
+      {
+         auto const [low_byte, overflow]{
+            add_with_overflow(Processor::low_byte(operand), MODE == AddressingMode::ABSOLUTE_X ? x_ : y_)
+         };
+
+         // read from the unfixed address and spend a cycle fixing the high byte (+), which the timing of the
+         // instructions that always fix it already counts
+         Word const effective_address{ assign_low_byte(operand, low_byte) };
+         if (not overflow and not always_fix)
+            return effective_address;
+
+         dummy_read(effective_address);
+         cycle_ += not always_fix;
+         return assign_high_byte(effective_address, high_byte(operand) + overflow);
+      }
+      else if constexpr (MODE == AddressingMode::X_INDIRECT)
+      {
+         auto pointer_address{ static_cast<Byte>(operand) };
+         // the processor reads the pointer address while it adds X to it
+         dummy_read(pointer_address);
+         pointer_address += x_;
+
+         Byte const effective_address_low{ memory_.read(pointer_address) };
+         ++pointer_address;
+         return assemble_word(memory_.read(pointer_address), effective_address_low);
+      }
+      else
+      {
+         static_assert(MODE == AddressingMode::INDIRECT_Y);
+
+         auto pointer_address{ static_cast<Byte>(operand) };
+         Byte const effective_address_low{ memory_.read(pointer_address) };
+         ++pointer_address;
+         Byte const effective_address_high{ memory_.read(pointer_address) };
+         auto const [low_byte, overflow]{ add_with_overflow(effective_address_low, y_) };
+
+         // read from the unfixed address and spend a cycle fixing the high byte (+), which the timing of the
+         // instructions that always fix it already counts
+         Word const effective_address{ assemble_word(effective_address_high, low_byte) };
+         if (not overflow and not always_fix)
+            return effective_address;
+
+         dummy_read(effective_address);
+         cycle_ += not always_fix;
+         return assign_high_byte(effective_address, effective_address_high + overflow);
+      }
+   }
+
+   template <Processor::BranchOperation OPERATION, Byte OPCODE>
+   void Processor::execute_relative(Word const operand) noexcept
+   {
+      cycle_ += OPCODE_INFOS[OPCODE].cycles;
+      if (not std::invoke(OPERATION, this))
+         return;
+
+      // read the opcode following the branch, add operand to PCL
+      dummy_read(program_counter);
+      auto const [program_counter_low, overflow]{
+         add_with_overflow(low_byte(program_counter), static_cast<SignedByte>(operand))
+      };
+      program_counter = assign_low_byte(program_counter, program_counter_low);
+      ++cycle_;
+
+      // read the opcode at the unfixed address, fix PCH (+)
+      if (overflow)
+      {
+         dummy_read(program_counter);
+         program_counter = assign_high_byte(program_counter, static_cast<Byte>(high_byte(program_counter) + overflow));
+         ++cycle_;
+      }
+   }
+
+   template <Processor::ReadOperation OPERATION, Byte OPCODE>
+   void Processor::execute_read(Word const operand) noexcept
+   {
+      AddressingMode constexpr MODE{ OPCODE_INFOS[OPCODE].mode };
+      if constexpr (MODE == AddressingMode::IMMEDIATE)
+         std::invoke(OPERATION, this, low_byte(operand));
+      else
+         std::invoke(OPERATION, this, memory_.read(effective_address<MODE>(operand, false)));
+
+      cycle_ += OPCODE_INFOS[OPCODE].cycles;
+   }
+
+   template <Processor::ModifyOperation OPERATION, Byte OPCODE>
+   void Processor::execute_modify(Word const operand) noexcept
+   {
+      AddressingMode constexpr MODE{ OPCODE_INFOS[OPCODE].mode };
+      if constexpr (MODE == AddressingMode::ACCUMULATOR)
+         accumulator_ = std::invoke(OPERATION, this, accumulator_);
+      else
+      {
+         Word const address{ effective_address<MODE>(operand, true) };
+         Byte const value{ memory_.read(address) };
+         memory_.write(address, value);
+         memory_.write(address, std::invoke(OPERATION, this, value));
+      }
+
+      cycle_ += OPCODE_INFOS[OPCODE].cycles;
+   }
+
+   template <Processor::WriteOperation OPERATION, Byte OPCODE>
+   void Processor::execute_write(Word const operand) noexcept
+   {
+      memory_.write(effective_address<OPCODE_INFOS[OPCODE].mode>(operand, true), std::invoke(OPERATION, this));
+      cycle_ += OPCODE_INFOS[OPCODE].cycles;
+   }
+
+   template <Processor::ProcessorStatusFlag FLAG, bool SET>
+   void Processor::execute_flag(Word) noexcept
+   {
+      change_processor_status_flag(FLAG, SET);
+      cycle_ += 2;
+   }
+
+   template <Byte Processor::* SOURCE, Byte Processor::* TARGET>
+   void Processor::execute_transfer(Word) noexcept
+   {
+      update_zero_and_negative_flag(this->*TARGET = this->*SOURCE);
+      cycle_ += 2;
+   }
+
+   template <Byte Processor::* REGISTER>
+   void Processor::execute_increment(Word) noexcept
+   {
+      update_zero_and_negative_flag(++(this->*REGISTER));
+      cycle_ += 2;
+   }
+
+   template <Byte Processor::* REGISTER>
+   void Processor::execute_decrement(Word) noexcept
+   {
+      update_zero_and_negative_flag(--(this->*REGISTER));
+      cycle_ += 2;
+   }
+
+   void Processor::execute_TXS(Word) noexcept
+   {
+      stack_pointer_ = x_;
+      cycle_ += 2;
+   }
+
+   void Processor::execute_NOP(Word) noexcept
+   {
+      cycle_ += 2;
+   }
+
+   void Processor::execute_BRK(Word) noexcept
+   {
+      // the padding byte was fetched as the operand
+      change_processor_status_flag(ProcessorStatusFlag::B, true);
+      write_to_stack(high_byte(program_counter));
+      --stack_pointer_;
+      write_to_stack(low_byte(program_counter));
+      --stack_pointer_;
+      resolve_processor_status();
+      write_to_stack(processor_status_);
+      --stack_pointer_;
+
+      Byte const program_counter_low{ memory_.read(IRQ_LOW) };
+      program_counter = assemble_word(memory_.read(IRQ_HIGH), program_counter_low);
+      change_processor_status_flag(ProcessorStatusFlag::I, true);
+      cycle_ += 7;
+   }
+
+   void Processor::execute_PHP(Word) noexcept
+   {
+      dummy_read(program_counter);
+      change_processor_status_flag(ProcessorStatusFlag::B, true);
+      change_processor_status_flag(ProcessorStatusFlag::_, true);
+      resolve_processor_status();
+      write_to_stack(processor_status_);
+      --stack_pointer_;
+      cycle_ += 3;
+   }
+
+   void Processor::execute_JSR(Word const operand) noexcept
+   {
+      // the pushed return address points at the last byte of the JSR
+      Word const return_address{ static_cast<Word>(program_counter - 1) };
+      write_to_stack(high_byte(return_address));
+      --stack_pointer_;
+      write_to_stack(low_byte(return_address));
+      --stack_pointer_;
+      program_counter = operand;
+      cycle_ += 6;
+   }
+
+   void Processor::execute_PLP(Word) noexcept
+   {
+      dummy_read(program_counter);
+      ++stack_pointer_;
+      pull_processor_status();
+      cycle_ += 4;
+   }
+
+   void Processor::execute_RTI(Word) noexcept
+   {
+      dummy_read(program_counter);
+      ++stack_pointer_;
+      pull_processor_status();
+      ++stack_pointer_;
+      Byte const program_counter_low{ read_from_stack() };
+      ++stack_pointer_;
+      program_counter = assemble_word(read_from_stack(), program_counter_low);
+      cycle_ += 6;
+   }
+
+   void Processor::execute_PHA(Word) noexcept
+   {
+      dummy_read(program_counter);
+      write_to_stack(accumulator_);
+      --stack_pointer_;
+      cycle_ += 3;
+   }
+
+   void Processor::execute_JMP_absolute(Word const operand) noexcept
+   {
+      program_counter = operand;
+      cycle_ += 3;
+   }
+
+   void Processor::execute_RTS(Word) noexcept
+   {
+      dummy_read(program_counter);
+      ++stack_pointer_;
+      Byte const program_counter_low{ read_from_stack() };
+      ++stack_pointer_;
+      program_counter = assemble_word(read_from_stack(), program_counter_low) + 1;
+      cycle_ += 6;
+   }
+
+   void Processor::execute_PLA(Word) noexcept
+   {
+      dummy_read(program_counter);
+      ++stack_pointer_;
+      update_zero_and_negative_flag(accumulator_ = read_from_stack());
+      cycle_ += 4;
+   }
+
+   void Processor::execute_JMP_indirect(Word const operand) noexcept
+   {
+      Byte const low_address{ memory_.read(operand) };
+      Byte const high_address{ memory_.read(indirect_jump_high_address(operand)) };
+      program_counter = assemble_word(high_address, low_address);
+      cycle_ += 5;
+   }
+
+   void Processor::execute_unsupported(Word) noexcept
+   {
+      freeze();
+   }
+}
\ No newline at end of file
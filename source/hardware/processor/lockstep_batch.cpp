@@ -0,0 +1,715 @@
+#include "lockstep_batch.hpp"
+#include "decimal.hpp"
+#include "opcode_info.hpp"
+#include "processor.hpp"
+#include "variant.hpp"
+
+namespace nes
+{
+   LockstepBatch::LockstepBatch()
+      : memories_(LANES * MEMORY_SIZE)
+   {
+   }
+
+   std::span<Byte, LockstepBatch::MEMORY_SIZE> LockstepBatch::memory(std::size_t const lane) noexcept
+   {
+      return std::span<Byte, MEMORY_SIZE>{ memories_.data() + lane * MEMORY_SIZE, MEMORY_SIZE };
+   }
+
+   std::span<Byte const, LockstepBatch::MEMORY_SIZE> LockstepBatch::memory(std::size_t const lane) const noexcept
+   {
+      return std::span<Byte const, MEMORY_SIZE>{ memories_.data() + lane * MEMORY_SIZE, MEMORY_SIZE };
+   }
+
+   void LockstepBatch::load(std::size_t const lane, LaneState const& state) noexcept
+   {
+      program_counters_[lane] = state.program_counter;
+      accumulators_[lane] = state.accumulator;
+      xs_[lane] = state.x;
+      ys_[lane] = state.y;
+      stack_pointers_[lane] = state.stack_pointer;
+      processor_statuses_[lane] = state.processor_status;
+      halt_reasons_[lane].reset();
+   }
+
+   void LockstepBatch::reset(std::size_t const lane) noexcept
+   {
+      load(lane, { .program_counter{ read_word(lane, Processor::RESET_LOW, Processor::RESET_HIGH) } });
+   }
+
+   std::array<LockstepBatch::LaneResult, LockstepBatch::LANES> LockstepBatch::run(Cycle const budget) noexcept
+   {
+      Lanes<Cycle> const start{ cycles_ };
+      for (std::size_t lane{}; lane < LANES; ++lane)
+         cycle_limits_[lane] = cycles_[lane] + budget;
+
+      auto const running{
+         [this](std::size_t const lane)
+         {
+            return not halt_reasons_[lane] and cycles_[lane] < cycle_limits_[lane];
+         }
+      };
+
+      while (true)
+      {
+         // The lane at the lowest address leads. Lanes that branched past code the others still run wait at its end
+         // for them, and lanes leaving a loop wait for those still in it, so they meet at the same opcodes again.
+         std::optional<std::size_t> leader{};
+         for (std::size_t lane{}; lane < LANES; ++lane)
+            if (running(lane) and (not leader or program_counters_[lane] < program_counters_[*leader]))
+               leader = lane;
+
+         if (not leader)
+            break;
+
+         Byte const opcode{ at(*leader, program_counters_[*leader]) };
+         Mask mask{};
+         for (std::size_t lane{}; lane < LANES; ++lane)
+            mask[lane] = running(lane) and at(lane, program_counters_[lane]) == opcode;
+
+         execute(opcode, mask);
+      }
+
+      std::array<LaneResult, LANES> results{};
+      for (std::size_t lane{}; lane < LANES; ++lane)
+         results[lane] = { .cycles{ cycles_[lane] - start[lane] }, .halt_reason{ halt_reasons_[lane] } };
+
+      return results;
+   }
+
+   LockstepBatch::LaneState LockstepBatch::state(std::size_t const lane) const noexcept
+   {
+      return {
+         .program_counter{ program_counters_[lane] },
+         .accumulator{ accumulators_[lane] },
+         .x{ xs_[lane] },
+         .y{ ys_[lane] },
+         .stack_pointer{ stack_pointers_[lane] },
+         .processor_status{ processor_statuses_[lane] }
+      };
+   }
+
+   Cycle LockstepBatch::cycle(std::size_t const lane) const noexcept
+   {
+      return cycles_[lane];
+   }
+
+   std::optional<HaltReason> const& LockstepBatch::halt_reason(std::size_t const lane) const noexcept
+   {
+      return halt_reasons_[lane];
+   }
+
+   std::size_t LockstepBatch::steps() const noexcept
+   {
+      return steps_;
+   }
+
+   std::size_t LockstepBatch::instructions() const noexcept
+   {
+      return instructions_;
+   }
+
+   void LockstepBatch::execute(Byte const opcode, Mask const& mask) noexcept
+   {
+      ++steps_;
+      instructions_ += static_cast<std::size_t>(std::ranges::count(mask, true));
+
+      OpcodeInfo const& info{ OPCODE_INFOS[opcode] };
+      Operation const operation{ OPERATIONS[opcode] };
+      if (operation == Operation::UNSUPPORTED)
+      {
+         bool const jammed{ Variant::JAMS and info.mnemonic == "JAM" };
+         for_each_lane(mask,
+            [this, jammed, opcode](std::size_t const lane)
+            {
+               // the opcode was fetched, as on the other cores
+               halt(lane, jammed ? HaltReason::Cause::JAM : HaltReason::Cause::UNSUPPORTED_OPCODE,
+                  program_counters_[lane]++, opcode);
+            });
+         return;
+      }
+
+      if (info.mode == AddressingMode::RELATIVE)
+         return branch(opcode, mask);
+
+      address(info.mode, mask);
+      blend(mask, program_counters_,
+         [this, &info](std::size_t const lane) { return static_cast<Word>(program_counters_[lane] + info.length); });
+      blend(mask, cycles_, [this, &info](std::size_t const lane)
+         {
+            return cycles_[lane] + info.predicted_cycles(page_crossings_[lane]);
+         });
+
+      AddressingMode const mode{ info.mode };
+      switch (operation)
+      {
+         case Operation::LDA:
+            read(mask);
+            transfer(mask, accumulators_, values_);
+            break;
+
+         case Operation::LDX:
+            read(mask);
+            transfer(mask, xs_, values_);
+            break;
+
+         case Operation::LDY:
+            read(mask);
+            transfer(mask, ys_, values_);
+            break;
+
+         case Operation::STA:
+            for_each_lane(mask, [this](std::size_t const lane) { at(lane, addresses_[lane]) = accumulators_[lane]; });
+            break;
+
+         case Operation::STX:
+            for_each_lane(mask, [this](std::size_t const lane) { at(lane, addresses_[lane]) = xs_[lane]; });
+            break;
+
+         case Operation::STY:
+            for_each_lane(mask, [this](std::size_t const lane) { at(lane, addresses_[lane]) = ys_[lane]; });
+            break;
+
+         case Operation::ORA:
+            read(mask);
+            blend(mask, accumulators_,
+               [this](std::size_t const lane) { return static_cast<Byte>(accumulators_[lane] | values_[lane]); });
+            update_zero_and_negative_flag(mask, accumulators_);
+            break;
+
+         case Operation::AND:
+            read(mask);
+            blend(mask, accumulators_,
+               [this](std::size_t const lane) { return static_cast<Byte>(accumulators_[lane] & values_[lane]); });
+            update_zero_and_negative_flag(mask, accumulators_);
+            break;
+
+         case Operation::EOR:
+            read(mask);
+            blend(mask, accumulators_,
+               [this](std::size_t const lane) { return static_cast<Byte>(accumulators_[lane] ^ values_[lane]); });
+            update_zero_and_negative_flag(mask, accumulators_);
+            break;
+
+         case Operation::ADC:
+         case Operation::SBC:
+         {
+            read(mask);
+            bool const subtract{ operation == Operation::SBC };
+            Mask decimal{};
+            Mask binary{};
+            for (std::size_t lane{}; lane < LANES; ++lane)
+            {
+               decimal[lane] = mask[lane] and Variant::DECIMAL_MODE and processor_statuses_[lane] & D;
+               binary[lane] = mask[lane] and not decimal[lane];
+            }
+
+            add(binary, subtract);
+            for_each_lane(decimal, [this, subtract](std::size_t const lane)
+               {
+                  bool const carry{ (processor_statuses_[lane] & C) != 0 };
+                  auto const result{
+                     subtract
+                        ? subtract_decimal(accumulators_[lane], values_[lane], carry)
+                        : add_decimal(accumulators_[lane], values_[lane], carry)
+                  };
+                  change_flag(lane, C, result.carry);
+                  change_flag(lane, V, result.overflow);
+                  change_flag(lane, Z, result.zero);
+                  change_flag(lane, N, result.negative);
+                  accumulators_[lane] = result.result;
+               });
+            break;
+         }
+
+         case Operation::CMP:
+         case Operation::CPX:
+         case Operation::CPY:
+         {
+            read(mask);
+            Lanes<Byte> const& registers{
+               operation == Operation::CMP ? accumulators_ : operation == Operation::CPX ? xs_ : ys_
+            };
+            blend(mask, processor_statuses_, [this, &registers](std::size_t const lane)
+               {
+                  auto const status{
+                     static_cast<ProcessorStatus>((processor_statuses_[lane] & ~C) | (registers[lane] >= values_[lane]))
+                  };
+                  return with_zero_and_negative(status, static_cast<Byte>(registers[lane] - values_[lane]));
+               });
+            break;
+         }
+
+         case Operation::BIT:
+            read(mask);
+            blend(mask, processor_statuses_, [this](std::size_t const lane)
+               {
+                  return static_cast<ProcessorStatus>((processor_statuses_[lane] & ~(N | V | Z))
+                     | (values_[lane] & (N | V)) | (values_[lane] & accumulators_[lane] ? 0 : Z));
+               });
+            break;
+
+         case Operation::ASL:
+            for_each_lane(mask, [this, mode](std::size_t const lane)
+               {
+                  Byte& value{ operand(lane, mode) };
+                  change_flag(lane, C, value & 0x80);
+                  update_zero_and_negative_flag(lane, value <<= 1);
+               });
+            break;
+
+         case Operation::LSR:
+            for_each_lane(mask, [this, mode](std::size_t const lane)
+               {
+                  Byte& value{ operand(lane, mode) };
+                  change_flag(lane, C, value & 0x01);
+                  update_zero_and_negative_flag(lane, value >>= 1);
+               });
+            break;
+
+         case Operation::ROL:
+            for_each_lane(mask, [this, mode](std::size_t const lane)
+               {
+                  Byte& value{ operand(lane, mode) };
+                  Byte const old_carry{ static_cast<Byte>(processor_statuses_[lane] & C) };
+                  change_flag(lane, C, value & 0x80);
+                  update_zero_and_negative_flag(lane, value = static_cast<Byte>(value << 1 | old_carry));
+               });
+            break;
+
+         case Operation::ROR:
+            for_each_lane(mask, [this, mode](std::size_t const lane)
+               {
+                  Byte& value{ operand(lane, mode) };
+                  Byte const old_carry{ static_cast<Byte>(processor_statuses_[lane] & C) };
+                  change_flag(lane, C, value & 0x01);
+                  update_zero_and_negative_flag(lane, value = static_cast<Byte>(value >> 1 | old_carry << 7));
+               });
+            break;
+
+         case Operation::INC:
+            for_each_lane(mask, [this, mode](std::size_t const lane)
+               {
+                  update_zero_and_negative_flag(lane, ++operand(lane, mode));
+               });
+            break;
+
+         case Operation::DEC:
+            for_each_lane(mask, [this, mode](std::size_t const lane)
+               {
+                  update_zero_and_negative_flag(lane, --operand(lane, mode));
+               });
+            break;
+
+         case Operation::INX:
+            blend(mask, xs_, [this](std::size_t const lane) { return static_cast<Index>(xs_[lane] + 1); });
+            update_zero_and_negative_flag(mask, xs_);
+            break;
+
+         case Operation::INY:
+            blend(mask, ys_, [this](std::size_t const lane) { return static_cast<Index>(ys_[lane] + 1); });
+            update_zero_and_negative_flag(mask, ys_);
+            break;
+
+         case Operation::DEX:
+            blend(mask, xs_, [this](std::size_t const lane) { return static_cast<Index>(xs_[lane] - 1); });
+            update_zero_and_negative_flag(mask, xs_);
+            break;
+
+         case Operation::DEY:
+            blend(mask, ys_, [this](std::size_t const lane) { return static_cast<Index>(ys_[lane] - 1); });
+            update_zero_and_negative_flag(mask, ys_);
+            break;
+
+         case Operation::TAX:
+            transfer(mask, xs_, accumulators_);
+            break;
+
+         case Operation::TAY:
+            transfer(mask, ys_, accumulators_);
+            break;
+
+         case Operation::TXA:
+            transfer(mask, accumulators_, xs_);
+            break;
+
+         case Operation::TYA:
+            transfer(mask, accumulators_, ys_);
+            break;
+
+         case Operation::TSX:
+            transfer(mask, xs_, stack_pointers_);
+            break;
+
+         case Operation::TXS:
+            blend(mask, stack_pointers_, [this](std::size_t const lane) { return xs_[lane]; });
+            break;
+
+         case Operation::CLC:
+            change_flag(mask, C, false);
+            break;
+
+         case Operation::SEC:
+            change_flag(mask, C, true);
+            break;
+
+         case Operation::CLI:
+            change_flag(mask, I, false);
+            break;
+
+         case Operation::SEI:
+            change_flag(mask, I, true);
+            break;
+
+         case Operation::CLV:
+            change_flag(mask, V, false);
+            break;
+
+         case Operation::CLD:
+            change_flag(mask, D, false);
+            break;
+
+         case Operation::SED:
+            change_flag(mask, D, true);
+            break;
+
+         case Operation::PHA:
+            for_each_lane(mask, [this](std::size_t const lane) { push(lane, accumulators_[lane]); });
+            break;
+
+         case Operation::PHP:
+            // B and _ are set in P by pushing it, as on the other cores
+            for_each_lane(mask, [this](std::size_t const lane) { push(lane, processor_statuses_[lane] |= B | _); });
+            break;
+
+         case Operation::PLA:
+            for_each_lane(mask, [this](std::size_t const lane)
+               {
+                  update_zero_and_negative_flag(lane, accumulators_[lane] = pull(lane));
+               });
+            break;
+
+         case Operation::PLP:
+            for_each_lane(mask, [this](std::size_t const lane)
+               {
+                  processor_statuses_[lane] = (processor_statuses_[lane] & (B | _)) | pull(lane);
+               });
+            break;
+
+         case Operation::JMP:
+            for_each_lane(mask, [this, opcode](std::size_t const lane) { jump(lane, addresses_[lane], opcode); });
+            break;
+
+         case Operation::JSR:
+            for_each_lane(mask, [this](std::size_t const lane)
+               {
+                  // the return address pushed is the last byte of the JSR
+                  auto const return_address{ static_cast<Word>(program_counters_[lane] - 1) };
+                  push(lane, static_cast<Byte>(return_address >> 8));
+                  push(lane, static_cast<Byte>(return_address));
+                  program_counters_[lane] = addresses_[lane];
+               });
+            break;
+
+         case Operation::RTS:
+            for_each_lane(mask, [this](std::size_t const lane)
+               {
+                  Byte const low{ pull(lane) };
+                  program_counters_[lane] = static_cast<Word>((pull(lane) << 8 | low) + 1);
+               });
+            break;
+
+         case Operation::RTI:
+            for_each_lane(mask, [this](std::size_t const lane)
+               {
+                  processor_statuses_[lane] = (processor_statuses_[lane] & (B | _)) | pull(lane);
+                  Byte const low{ pull(lane) };
+                  program_counters_[lane] = static_cast<Word>(pull(lane) << 8 | low);
+               });
+            break;
+
+         case Operation::BRK:
+            for_each_lane(mask, [this](std::size_t const lane)
+               {
+                  // past the padding byte, which its length counts
+                  Word const return_address{ program_counters_[lane] };
+                  change_flag(lane, B, true);
+                  push(lane, static_cast<Byte>(return_address >> 8));
+                  push(lane, static_cast<Byte>(return_address));
+                  push(lane, processor_statuses_[lane]);
+                  program_counters_[lane] = read_word(lane, Processor::IRQ_LOW, Processor::IRQ_HIGH);
+                  change_flag(lane, I, true);
+               });
+            break;
+
+         default:
+            break;
+      }
+   }
+
+   void LockstepBatch::address(AddressingMode const mode, Mask const& mask) noexcept
+   {
+      page_crossings_.fill(false);
+      switch (mode)
+      {
+         case AddressingMode::IMMEDIATE:
+            for_each_lane(mask, [this](std::size_t const lane)
+               {
+                  addresses_[lane] = static_cast<Word>(program_counters_[lane] + 1);
+               });
+            break;
+
+         case AddressingMode::ZERO_PAGE:
+            for_each_lane(mask, [this](std::size_t const lane)
+               {
+                  addresses_[lane] = at(lane, static_cast<Word>(program_counters_[lane] + 1));
+               });
+            break;
+
+         case AddressingMode::ZERO_PAGE_X:
+            for_each_lane(mask, [this](std::size_t const lane)
+               {
+                  addresses_[lane] = static_cast<Byte>(at(lane, static_cast<Word>(program_counters_[lane] + 1))
+                     + xs_[lane]);
+               });
+            break;
+
+         case AddressingMode::ZERO_PAGE_Y:
+            for_each_lane(mask, [this](std::size_t const lane)
+               {
+                  addresses_[lane] = static_cast<Byte>(at(lane, static_cast<Word>(program_counters_[lane] + 1))
+                     + ys_[lane]);
+               });
+            break;
+
+         case AddressingMode::ABSOLUTE:
+            for_each_lane(mask, [this](std::size_t const lane)
+               {
+                  Word const operand{ static_cast<Word>(program_counters_[lane] + 1) };
+                  addresses_[lane] = read_word(lane, operand, static_cast<Word>(operand + 1));
+               });
+            break;
+
+         case AddressingMode::ABSOLUTE_X:
+         case AddressingMode::ABSOLUTE_Y:
+         {
+            Lanes<Index> const& indices{ mode == AddressingMode::ABSOLUTE_X ? xs_ : ys_ };
+            for_each_lane(mask, [this, &indices](std::size_t const lane)
+               {
+                  Word const operand{ static_cast<Word>(program_counters_[lane] + 1) };
+                  Word const base{ read_word(lane, operand, static_cast<Word>(operand + 1)) };
+                  addresses_[lane] = static_cast<Word>(base + indices[lane]);
+                  page_crossings_[lane] = (base ^ addresses_[lane]) & 0xFF'00;
+               });
+            break;
+         }
+
+         case AddressingMode::INDIRECT:
+            for_each_lane(mask, [this](std::size_t const lane)
+               {
+                  Word const operand{ static_cast<Word>(program_counters_[lane] + 1) };
+                  Word const pointer{ read_word(lane, operand, static_cast<Word>(operand + 1)) };
+                  Word const high_address{
+                     Variant::INDIRECT_JUMP_WRAPS
+                        ? static_cast<Word>((pointer & 0xFF'00) | static_cast<Byte>(pointer + 1))
+                        : static_cast<Word>(pointer + 1)
+                  };
+                  addresses_[lane] = read_word(lane, pointer, high_address);
+               });
+            break;
+
+         case AddressingMode::X_INDIRECT:
+            for_each_lane(mask, [this](std::size_t const lane)
+               {
+                  auto const pointer{
+                     static_cast<Byte>(at(lane, static_cast<Word>(program_counters_[lane] + 1)) + xs_[lane])
+                  };
+                  addresses_[lane] = read_word(lane, pointer, static_cast<Byte>(pointer + 1));
+               });
+            break;
+
+         case AddressingMode::INDIRECT_Y:
+            for_each_lane(mask, [this](std::size_t const lane)
+               {
+                  Byte const pointer{ at(lane, static_cast<Word>(program_counters_[lane] + 1)) };
+                  Word const base{ read_word(lane, pointer, static_cast<Byte>(pointer + 1)) };
+                  addresses_[lane] = static_cast<Word>(base + ys_[lane]);
+                  page_crossings_[lane] = (base ^ addresses_[lane]) & 0xFF'00;
+               });
+            break;
+
+         case AddressingMode::RELATIVE:
+            for_each_lane(mask, [this](std::size_t const lane)
+               {
+                  auto const operand{ static_cast<Word>(program_counters_[lane] + 1) };
+                  auto const next{ static_cast<Word>(operand + 1) };
+                  auto const offset{ static_cast<SignedByte>(at(lane, operand)) };
+                  addresses_[lane] = static_cast<Word>(next + offset);
+                  page_crossings_[lane] = (next ^ addresses_[lane]) & 0xFF'00;
+               });
+            break;
+
+         default:
+            break;
+      }
+   }
+
+   void LockstepBatch::read(Mask const& mask) noexcept
+   {
+      for_each_lane(mask, [this](std::size_t const lane) { values_[lane] = at(lane, addresses_[lane]); });
+   }
+
+   void LockstepBatch::branch(Byte const opcode, Mask const& mask) noexcept
+   {
+      // bits 7 and 6 of a branch opcode select the flag, bit 5 whether the branch is taken on it being set
+      std::array<Flag, 4> constexpr FLAGS{ N, V, C, Z };
+      Flag const flag{ FLAGS[opcode >> 6] };
+      bool const taken_if_set{ (opcode & 0b00'10'00'00) != 0 };
+
+      address(AddressingMode::RELATIVE, mask);
+      Mask taken{};
+      for (std::size_t lane{}; lane < LANES; ++lane)
+         taken[lane] = mask[lane] and ((processor_statuses_[lane] & flag) != 0) == taken_if_set;
+
+      OpcodeInfo const& info{ OPCODE_INFOS[opcode] };
+      blend(mask, cycles_, [this, &info, &taken](std::size_t const lane)
+         {
+            return cycles_[lane] + info.predicted_cycles(page_crossings_[lane], taken[lane]);
+         });
+      blend(mask, program_counters_,
+         [this](std::size_t const lane) { return static_cast<Word>(program_counters_[lane] + 2); });
+      for_each_lane(taken, [this, opcode](std::size_t const lane) { jump(lane, addresses_[lane], opcode); });
+   }
+
+   void LockstepBatch::jump(std::size_t const lane, Word const target, Byte const opcode) noexcept
+   {
+      // a jump to itself is a trap, which ends the run of the lane
+      auto const instruction{ static_cast<Word>(program_counters_[lane] - OPCODE_INFOS[opcode].length) };
+      if (target == instruction)
+         halt(lane, HaltReason::Cause::TRAP, instruction, opcode);
+
+      program_counters_[lane] = target;
+   }
+
+   void LockstepBatch::halt(std::size_t const lane, HaltReason::Cause const cause, Word const program_counter,
+      Byte const opcode) noexcept
+   {
+      halt_reasons_[lane] = { .cause{ cause }, .program_counter{ program_counter }, .opcode{ opcode } };
+   }
+
+   Byte& LockstepBatch::at(std::size_t const lane, Word const address) noexcept
+   {
+      return memories_[lane * MEMORY_SIZE + address];
+   }
+
+   Word LockstepBatch::read_word(std::size_t const lane, Word const low_address, Word const high_address) noexcept
+   {
+      return static_cast<Word>(at(lane, high_address) << 8 | at(lane, low_address));
+   }
+
+   Byte& LockstepBatch::operand(std::size_t const lane, AddressingMode const mode) noexcept
+   {
+      return mode == AddressingMode::ACCUMULATOR ? accumulators_[lane] : at(lane, addresses_[lane]);
+   }
+
+   void LockstepBatch::push(std::size_t const lane, Byte const value) noexcept
+   {
+      at(lane, 0x01'00 + stack_pointers_[lane]--) = value;
+   }
+
+   Byte LockstepBatch::pull(std::size_t const lane) noexcept
+   {
+      return at(lane, 0x01'00 + ++stack_pointers_[lane]);
+   }
+
+   void LockstepBatch::change_flag(std::size_t const lane, Flag const flag, bool const set) noexcept
+   {
+      processor_statuses_[lane] = set ? processor_statuses_[lane] | flag : processor_statuses_[lane] & ~flag;
+   }
+
+   void LockstepBatch::update_zero_and_negative_flag(std::size_t const lane, Byte const value) noexcept
+   {
+      change_flag(lane, Z, value == 0);
+      change_flag(lane, N, value & 0x80);
+   }
+
+   void LockstepBatch::change_flag(Mask const& mask, Flag const flag, bool const set) noexcept
+   {
+      blend(mask, processor_statuses_, [this, flag, set](std::size_t const lane)
+         {
+            ProcessorStatus const status{ processor_statuses_[lane] };
+            return static_cast<ProcessorStatus>(set ? status | flag : status & ~flag);
+         });
+   }
+
+   void LockstepBatch::update_zero_and_negative_flag(Mask const& mask, Lanes<Byte> const& values) noexcept
+   {
+      blend(mask, processor_statuses_, [this, &values](std::size_t const lane)
+         {
+            return with_zero_and_negative(processor_statuses_[lane], values[lane]);
+         });
+   }
+
+   void LockstepBatch::transfer(Mask const& mask, Lanes<Byte>& target, Lanes<Byte> const& source) noexcept
+   {
+      blend(mask, target, [&source](std::size_t const lane) { return source[lane]; });
+      update_zero_and_negative_flag(mask, target);
+   }
+
+   void LockstepBatch::add(Mask const& mask, bool const subtract) noexcept
+   {
+      // the sums of every lane come first, as the flags of a lane depend on its accumulator before the addition
+      Lanes<Word> sums{};
+      for (std::size_t lane{}; lane < LANES; ++lane)
+      {
+         auto const value{ static_cast<Byte>(subtract ? ~values_[lane] : values_[lane]) };
+         sums[lane] = static_cast<Word>(accumulators_[lane] + value + (processor_statuses_[lane] & C));
+      }
+
+      blend(mask, processor_statuses_, [this, subtract, &sums](std::size_t const lane)
+         {
+            auto const value{ static_cast<Byte>(subtract ? ~values_[lane] : values_[lane]) };
+            auto const overflow{ (accumulators_[lane] ^ sums[lane]) & (value ^ sums[lane]) & 0x80 };
+            auto const status{
+               static_cast<ProcessorStatus>((processor_statuses_[lane] & ~(C | V)) | sums[lane] >> 8 | overflow >> 1)
+            };
+            return with_zero_and_negative(status, static_cast<Byte>(sums[lane]));
+         });
+      blend(mask, accumulators_, [&sums](std::size_t const lane) { return static_cast<Byte>(sums[lane]); });
+   }
+
+   constexpr ProcessorStatus LockstepBatch::with_zero_and_negative(ProcessorStatus const status,
+      Byte const value) noexcept
+   {
+      return static_cast<ProcessorStatus>((status & ~(Z | N)) | (value ? 0 : Z) | (value & N));
+   }
+
+   constexpr LockstepBatch::Operation LockstepBatch::operation(Byte const opcode) noexcept
+   {
+      // in the order of the operations
+      std::array<std::string_view, 56> constexpr MNEMONICS{
+         "ADC", "AND", "ASL", "BCC", "BCS", "BEQ", "BIT", "BMI", "BNE", "BPL", "BRK", "BVC", "BVS", "CLC",
+         "CLD", "CLI", "CLV", "CMP", "CPX", "CPY", "DEC", "DEX", "DEY", "EOR", "INC", "INX", "INY", "JMP",
+         "JSR", "LDA", "LDX", "LDY", "LSR", "NOP", "ORA", "PHA", "PHP", "PLA", "PLP", "ROL", "ROR", "RTI",
+         "RTS", "SBC", "SEC", "SED", "SEI", "STA", "STX", "STY", "TAX", "TAY", "TSX", "TXA", "TXS", "TYA"
+      };
+
+      OpcodeInfo const& info{ OPCODE_INFOS[opcode] };
+      auto const mnemonic{ std::ranges::find(MNEMONICS, info.mnemonic) };
+      if (not info.official or mnemonic == MNEMONICS.end())
+         return Operation::UNSUPPORTED;
+
+      return static_cast<Operation>(mnemonic - MNEMONICS.begin());
+   }
+
+   constexpr std::array<LockstepBatch::Operation, 256> LockstepBatch::OPERATIONS{
+      []
+      {
+         std::array<Operation, 256> operations{};
+         for (std::size_t opcode{}; opcode < operations.size(); ++opcode)
+            operations[opcode] = operation(static_cast<Byte>(opcode));
+
+         return operations;
+      }()
+   };
+}
\ No newline at end of file
@@ -0,0 +1,169 @@
+#ifndef LOCKSTEP_BATCH_HPP
+#define LOCKSTEP_BATCH_HPP
+
+#include "addressing_mode.hpp"
+#include "halt_reason.hpp"
+#include "hardware/types.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   // Runs a batch of independent 6502s in lockstep, for workloads like test vectors or searches that run one program
+   // on many inputs. The registers of the lanes are kept as arrays, one element per lane, and each lane has 64 KiB of
+   // memory of its own. Each step decodes the opcode of the lane at the lowest address once and executes it on every
+   // lane at the same opcode; lanes that diverged are masked off and replayed in a later step. Register and flag
+   // operations blend their results into those arrays without branching on the mask, which the compiler turns into
+   // vector code; memory accesses, the stack and jumps go lane by lane.
+   // Lanes have no interrupts or memory-mapped devices and only execute the official opcodes, timed at instruction
+   // granularity like the instruction-stepped core. A lane stops at a trap, a JAM or an unsupported opcode and stays
+   // halted until it is loaded again.
+   class LockstepBatch final
+   {
+      public:
+         static std::size_t constexpr LANES{ 16 };
+         static std::size_t constexpr MEMORY_SIZE{ 0x1'00'00 };
+
+         struct LaneState final
+         {
+            ProgramCounter program_counter{};
+            Accumulator accumulator{};
+            Index x{};
+            Index y{};
+            // as the processor leaves them after a reset
+            StackPointer stack_pointer{ 0xFC };
+            ProcessorStatus processor_status{};
+         };
+
+         struct LaneResult final
+         {
+            Cycle cycles;
+            std::optional<HaltReason> halt_reason;
+         };
+
+         LockstepBatch();
+         LockstepBatch(LockstepBatch const&) = delete;
+         LockstepBatch(LockstepBatch&&) = delete;
+
+         ~LockstepBatch() noexcept = default;
+
+         LockstepBatch& operator=(LockstepBatch const&) = delete;
+         LockstepBatch& operator=(LockstepBatch&&) = delete;
+
+         [[nodiscard]] std::span<Byte, MEMORY_SIZE> memory(std::size_t lane) noexcept;
+         [[nodiscard]] std::span<Byte const, MEMORY_SIZE> memory(std::size_t lane) const noexcept;
+
+         // sets the registers of the lane and clears its halt
+         void load(std::size_t lane, LaneState const& state) noexcept;
+         // loads the lane with the registers after a reset, starting at the reset vector in its memory
+         void reset(std::size_t lane) noexcept;
+
+         // Runs every lane that is not halted until it has spent the budget, overshooting it by part of an
+         // instruction like the instruction-stepped core, or halts. Returns the cycles each lane ran and why it halted.
+         std::array<LaneResult, LANES> run(Cycle budget) noexcept;
+
+         [[nodiscard]] LaneState state(std::size_t lane) const noexcept;
+         [[nodiscard]] Cycle cycle(std::size_t lane) const noexcept;
+         [[nodiscard]] std::optional<HaltReason> const& halt_reason(std::size_t lane) const noexcept;
+         // steps executed and instructions executed over all lanes, which tell how well the lanes kept together
+         [[nodiscard]] std::size_t steps() const noexcept;
+         [[nodiscard]] std::size_t instructions() const noexcept;
+
+      private:
+         template <typename T>
+         using Lanes = std::array<T, LANES>;
+         using Mask = Lanes<bool>;
+
+         enum class Operation : Byte
+         {
+            ADC, AND, ASL, BCC, BCS, BEQ, BIT, BMI, BNE, BPL, BRK, BVC, BVS, CLC,
+            CLD, CLI, CLV, CMP, CPX, CPY, DEC, DEX, DEY, EOR, INC, INX, INY, JMP,
+            JSR, LDA, LDX, LDY, LSR, NOP, ORA, PHA, PHP, PLA, PLP, ROL, ROR, RTI,
+            RTS, SBC, SEC, SED, SEI, STA, STX, STY, TAX, TAY, TSX, TXA, TXS, TYA,
+            UNSUPPORTED
+         };
+
+         enum Flag : ProcessorStatus
+         {
+            C = 0b00'00'00'01,
+            Z = 0b00'00'00'10,
+            I = 0b00'00'01'00,
+            D = 0b00'00'10'00,
+            B = 0b00'01'00'00,
+            _ = 0b00'10'00'00,
+            V = 0b01'00'00'00,
+            N = 0b10'00'00'00
+         };
+
+         static std::array<Operation, 256> const OPERATIONS;
+
+         template <typename Function>
+         static void for_each_lane(Mask const& mask, Function function)
+         {
+            for (std::size_t lane{}; lane < LANES; ++lane)
+               if (mask[lane])
+                  function(lane);
+         }
+
+         // Runs the function on every lane and keeps its result on the lanes in the mask, so it must not have side
+         // effects. The mask selects the bits to keep rather than a branch, which leaves the compiler a loop to
+         // vectorise.
+         template <typename T, typename Function>
+         static void blend(Mask const& mask, Lanes<T>& lanes, Function function)
+         {
+            for (std::size_t lane{}; lane < LANES; ++lane)
+            {
+               auto const selected{ static_cast<T>(-static_cast<T>(mask[lane])) };
+               lanes[lane] = static_cast<T>((function(lane) & selected) | (lanes[lane] & ~selected));
+            }
+         }
+
+         void execute(Byte opcode, Mask const& mask) noexcept;
+         void address(AddressingMode mode, Mask const& mask) noexcept;
+         void read(Mask const& mask) noexcept;
+         void branch(Byte opcode, Mask const& mask) noexcept;
+         void jump(std::size_t lane, Word target, Byte opcode) noexcept;
+         void halt(std::size_t lane, HaltReason::Cause cause, Word program_counter, Byte opcode) noexcept;
+
+         [[nodiscard]] Byte& at(std::size_t lane, Word address) noexcept;
+         [[nodiscard]] Word read_word(std::size_t lane, Word low_address, Word high_address) noexcept;
+         // the accumulator or the addressed memory, whichever a read-modify-write instruction works on
+         [[nodiscard]] Byte& operand(std::size_t lane, AddressingMode mode) noexcept;
+         void push(std::size_t lane, Byte value) noexcept;
+         [[nodiscard]] Byte pull(std::size_t lane) noexcept;
+         void change_flag(std::size_t lane, Flag flag, bool set) noexcept;
+         void update_zero_and_negative_flag(std::size_t lane, Byte value) noexcept;
+         void change_flag(Mask const& mask, Flag flag, bool set) noexcept;
+         void update_zero_and_negative_flag(Mask const& mask, Lanes<Byte> const& values) noexcept;
+         // copies the source register to the target one and sets Z and N from it
+         void transfer(Mask const& mask, Lanes<Byte>& target, Lanes<Byte> const& source) noexcept;
+         // ADC, or SBC as the addition of the complement, outside decimal mode
+         void add(Mask const& mask, bool subtract) noexcept;
+
+         [[nodiscard]] static constexpr ProcessorStatus with_zero_and_negative(ProcessorStatus status,
+            Byte value) noexcept;
+
+         [[nodiscard]] static constexpr Operation operation(Byte opcode) noexcept;
+
+         std::vector<Byte> memories_;
+
+         Lanes<ProgramCounter> program_counters_{};
+         Lanes<Accumulator> accumulators_{};
+         Lanes<Index> xs_{};
+         Lanes<Index> ys_{};
+         Lanes<StackPointer> stack_pointers_{};
+         Lanes<ProcessorStatus> processor_statuses_{};
+         Lanes<Cycle> cycles_{};
+         Lanes<Cycle> cycle_limits_{};
+         Lanes<std::optional<HaltReason>> halt_reasons_{};
+
+         // what the addressing mode of the current step resolved to, per lane
+         Lanes<Word> addresses_{};
+         Lanes<Byte> values_{};
+         Lanes<bool> page_crossings_{};
+
+         std::size_t steps_{};
+         std::size_t instructions_{};
+   };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,22 @@
+#ifndef MICROCODE_STATE_HPP
+#define MICROCODE_STATE_HPP
+
+#include "hardware/types.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   // Everything the micro-op core carries from one cycle of an instruction to the next
+   struct MicrocodeState final
+   {
+      Word address;
+      Byte opcode;
+      Byte step;
+      Byte value;
+      Byte pointer;
+      SignedByte overflow;
+      bool in_flight;
+   };
+}
+
+#endif
\ No newline at end of file
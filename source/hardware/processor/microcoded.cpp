@@ -0,0 +1,660 @@
+#include "processor.hpp"
+#include "profiler.hpp"
+
+namespace nes
+{
+   bool Processor::tick_microcoded()
+   {
+      MicrocodeState& state{ microcode_state_ };
+      if (not state.in_flight and hooks_ and run_hook())
+         return true;
+
+      ++cycle_;
+      if (not state.in_flight)
+      {
+         // fetch opcode, increment PC
+         Byte const opcode{ memory_.read(program_counter) };
+         ++program_counter;
+         current_opcode_ = static_cast<Opcode>(opcode);
+         if (profiler_)
+            profiler_->record(opcode);
+
+         if (cycle_ < cycle_limit_)
+            skip_idle_loop(static_cast<Word>(program_counter - 1), current_opcode_);
+
+         state = { .address{}, .opcode{ opcode }, .step{}, .value{}, .pointer{}, .overflow{}, .in_flight{ true } };
+         return false;
+      }
+
+      Microprogram const& microprogram{ MICROPROGRAMS[state.opcode] };
+      bool const ended_early{ microprogram.micro_ops[state.step++](*this) };
+      if (not ended_early and state.step < microprogram.length)
+         return false;
+
+      // a branch that fetched the opcode of the next instruction left that instruction's first micro-op up next
+      state.in_flight = state.step == 0;
+      return true;
+   }
+
+   template <AddressingMode MODE, bool ALWAYS_FIX, auto... MICRO_OPS>
+   constexpr Microprogram Processor::microcoded_addressed() noexcept
+   {
+      if constexpr (MODE == AddressingMode::ZERO_PAGE)
+         return microcoded<&Processor::micro_fetch_address_low, MICRO_OPS...>();
+      else if constexpr (MODE == AddressingMode::ZERO_PAGE_X or MODE == AddressingMode::ZERO_PAGE_Y)
+      {
+         auto constexpr INDEX{ MODE == AddressingMode::ZERO_PAGE_X ? &Processor::x_ : &Processor::y_ };
+         return microcoded<
+            &Processor::micro_fetch_address_low, &Processor::micro_index_zero_page<INDEX>, MICRO_OPS...
+         >();
+      }
+      else if constexpr (MODE == AddressingMode::ABSOLUTE)
+         return microcoded<&Processor::micro_fetch_address_low, &Processor::micro_fetch_address_high, MICRO_OPS...>();
+      else if constexpr (MODE == AddressingMode::ABSOLUTE_X or MODE == AddressingMode::ABSOLUTE_Y)
+      {
+         auto constexpr INDEX{ MODE == AddressingMode::ABSOLUTE_X ? &Processor::x_ : &Processor::y_ };
+         if constexpr (ALWAYS_FIX)
+            return microcoded<
+               &Processor::micro_fetch_address_low, &Processor::micro_fetch_address_high_indexed<INDEX>,
+               &Processor::micro_fix_address, MICRO_OPS...
+            >();
+         else
+            return microcoded<
+               &Processor::micro_fetch_address_low, &Processor::micro_fetch_address_high_indexed<INDEX>, MICRO_OPS...
+            >();
+      }
+      else if constexpr (MODE == AddressingMode::X_INDIRECT)
+         return microcoded<
+            &Processor::micro_fetch_pointer, &Processor::micro_index_pointer, &Processor::micro_fetch_pointed_low,
+            &Processor::micro_fetch_pointed_high, MICRO_OPS...
+         >();
+      else
+      {
+         static_assert(MODE == AddressingMode::INDIRECT_Y);
+
+         if constexpr (ALWAYS_FIX)
+            return microcoded<
+               &Processor::micro_fetch_pointer, &Processor::micro_fetch_pointed_low,
+               &Processor::micro_fetch_pointed_high_indexed, &Processor::micro_fix_address, MICRO_OPS...
+            >();
+         else
+            return microcoded<
+               &Processor::micro_fetch_pointer, &Processor::micro_fetch_pointed_low,
+               &Processor::micro_fetch_pointed_high_indexed, MICRO_OPS...
+            >();
+      }
+   }
+
+   template <Processor::BranchOperation OPERATION>
+   constexpr Microprogram Processor::microcoded_relative() noexcept
+   {
+      return microcoded<
+         &Processor::micro_fetch_operand, &Processor::micro_branch<OPERATION>, &Processor::micro_branch_taken,
+         &Processor::micro_branch_page_crossed
+      >();
+   }
+
+   template <Processor::ReadOperation OPERATION, AddressingMode MODE>
+   constexpr Microprogram Processor::microcoded_read() noexcept
+   {
+      if constexpr (MODE == AddressingMode::IMMEDIATE)
+         return microcoded<&Processor::micro_read_immediate<OPERATION>>();
+      else if constexpr (
+         MODE == AddressingMode::ABSOLUTE_X or MODE == AddressingMode::ABSOLUTE_Y or MODE == AddressingMode::INDIRECT_Y)
+         return microcoded_addressed<
+            MODE, false, &Processor::micro_read_indexed<OPERATION>, &Processor::micro_read<OPERATION>
+         >();
+      else
+         return microcoded_addressed<MODE, false, &Processor::micro_read<OPERATION>>();
+   }
+
+   template <Processor::ModifyOperation OPERATION, AddressingMode MODE>
+   constexpr Microprogram Processor::microcoded_modify() noexcept
+   {
+      if constexpr (MODE == AddressingMode::ACCUMULATOR)
+         return microcoded<&Processor::micro_modify_accumulator<OPERATION>>();
+      else
+         return microcoded_addressed<
+            MODE, true, &Processor::micro_read_value, &Processor::micro_modify<OPERATION>, &Processor::micro_write_value
+         >();
+   }
+
+   template <Processor::WriteOperation OPERATION, AddressingMode MODE>
+   constexpr Microprogram Processor::microcoded_write() noexcept
+   {
+      return microcoded_addressed<MODE, true, &Processor::micro_write<OPERATION>>();
+   }
+
+   template <Byte OPCODE>
+   constexpr Microprogram Processor::microprogram() noexcept
+   {
+      OpcodeInfo constexpr INFO{ OPCODE_INFOS[OPCODE] };
+      if constexpr (not INFO.official)
+         return microcoded<&Processor::micro_unsupported>();
+      else if constexpr (INFO.mode == AddressingMode::RELATIVE)
+         return microcoded_relative<branch_operation(INFO.mnemonic)>();
+      else if constexpr (read_operation(INFO.mnemonic) not_eq nullptr)
+         return microcoded_read<read_operation(INFO.mnemonic), INFO.mode>();
+      else if constexpr (modify_operation(INFO.mnemonic) not_eq nullptr)
+         return microcoded_modify<modify_operation(INFO.mnemonic), INFO.mode>();
+      else if constexpr (write_operation(INFO.mnemonic) not_eq nullptr)
+         return microcoded_write<write_operation(INFO.mnemonic), INFO.mode>();
+      else
+         return implied_microprogram(INFO);
+   }
+
+   constexpr Microprogram Processor::implied_microprogram(OpcodeInfo const& info) noexcept
+   {
+      if (info.mnemonic == "BRK")
+         return microcoded<
+            &Processor::micro_BRK_fetch_padding, &Processor::micro_BRK_push_program_counter_high,
+            &Processor::micro_push_program_counter_low, &Processor::micro_BRK_push_processor_status,
+            &Processor::micro_BRK_fetch_vector_low, &Processor::micro_BRK_fetch_vector_high
+         >();
+      if (info.mnemonic == "PHP")
+         return microcoded<&Processor::micro_read_next, &Processor::micro_PHP>();
+      if (info.mnemonic == "CLC")
+         return microcoded<&Processor::micro_flag<ProcessorStatusFlag::C, false>>();
+      if (info.mnemonic == "JSR")
+         return microcoded<
+            &Processor::micro_fetch_address_low, &Processor::micro_internal_operation,
+            &Processor::micro_push_program_counter_high, &Processor::micro_push_program_counter_low,
+            &Processor::micro_jump
+         >();
+      if (info.mnemonic == "PLP")
+         return microcoded<
+            &Processor::micro_read_next, &Processor::micro_increment_stack_pointer, &Processor::micro_PLP
+         >();
+      if (info.mnemonic == "SEC")
+         return microcoded<&Processor::micro_flag<ProcessorStatusFlag::C, true>>();
+      if (info.mnemonic == "RTI")
+         return microcoded<
+            &Processor::micro_read_next, &Processor::micro_increment_stack_pointer,
+            &Processor::micro_RTI_pull_processor_status, &Processor::micro_pull_program_counter_low,
+            &Processor::micro_pull_program_counter_high
+         >();
+      if (info.mnemonic == "PHA")
+         return microcoded<&Processor::micro_read_next, &Processor::micro_PHA>();
+      if (info.mnemonic == "JMP" and info.mode == AddressingMode::ABSOLUTE)
+         return microcoded<&Processor::micro_fetch_address_low, &Processor::micro_jump>();
+      if (info.mnemonic == "CLI")
+         return microcoded<&Processor::micro_flag<ProcessorStatusFlag::I, false>>();
+      if (info.mnemonic == "RTS")
+         return microcoded<
+            &Processor::micro_read_next, &Processor::micro_increment_stack_pointer,
+            &Processor::micro_pull_program_counter_low, &Processor::micro_pull_program_counter_high,
+            &Processor::micro_increment_program_counter
+         >();
+      if (info.mnemonic == "PLA")
+         return microcoded<
+            &Processor::micro_read_next, &Processor::micro_increment_stack_pointer, &Processor::micro_PLA
+         >();
+      if (info.mnemonic == "JMP" and info.mode == AddressingMode::INDIRECT)
+         return microcoded<
+            &Processor::micro_fetch_address_low, &Processor::micro_fetch_address_high,
+            &Processor::micro_read_value, &Processor::micro_jump_indirect
+         >();
+      if (info.mnemonic == "SEI")
+         return microcoded<&Processor::micro_flag<ProcessorStatusFlag::I, true>>();
+      if (info.mnemonic == "DEY")
+         return microcoded<&Processor::micro_decrement<&Processor::y_>>();
+      if (info.mnemonic == "TXA")
+         return microcoded<&Processor::micro_transfer<&Processor::x_, &Processor::accumulator_>>();
+      if (info.mnemonic == "TYA")
+         return microcoded<&Processor::micro_transfer<&Processor::y_, &Processor::accumulator_>>();
+      if (info.mnemonic == "TXS")
+         return microcoded<&Processor::micro_TXS>();
+      if (info.mnemonic == "TAY")
+         return microcoded<&Processor::micro_transfer<&Processor::accumulator_, &Processor::y_>>();
+      if (info.mnemonic == "TAX")
+         return microcoded<&Processor::micro_transfer<&Processor::accumulator_, &Processor::x_>>();
+      if (info.mnemonic == "CLV")
+         return microcoded<&Processor::micro_flag<ProcessorStatusFlag::V, false>>();
+      if (info.mnemonic == "TSX")
+         return microcoded<&Processor::micro_transfer<&Processor::stack_pointer_, &Processor::x_>>();
+      if (info.mnemonic == "INY")
+         return microcoded<&Processor::micro_increment<&Processor::y_>>();
+      if (info.mnemonic == "DEX")
+         return microcoded<&Processor::micro_decrement<&Processor::x_>>();
+      if (info.mnemonic == "CLD")
+         return microcoded<&Processor::micro_flag<ProcessorStatusFlag::D, false>>();
+      if (info.mnemonic == "INX")
+         return microcoded<&Processor::micro_increment<&Processor::x_>>();
+      if (info.mnemonic == "NOP")
+         return microcoded<&Processor::micro_NOP>();
+      if (info.mnemonic == "SED")
+         return microcoded<&Processor::micro_flag<ProcessorStatusFlag::D, true>>();
+
+      return microcoded<&Processor::micro_unsupported>();
+   }
+
+   constexpr std::array<Microprogram, 256> Processor::MICROPROGRAMS{
+      []<std::size_t... OPCODES>(std::index_sequence<OPCODES...>)
+      {
+         return std::array<Microprogram, 256>{ microprogram<OPCODES>()... };
+      }(std::make_index_sequence<256>{})
+   };
+
+   bool Processor::micro_fetch_address_low() noexcept
+   {
+      // fetch low byte of address, increment PC
+      microcode_state_.address = memory_.read(program_counter);
+      ++program_counter;
+      return false;
+   }
+
+   bool Processor::micro_fetch_address_high() noexcept
+   {
+      // fetch high byte of address, increment PC
+      microcode_state_.address = assign_high_byte(microcode_state_.address, memory_.read(program_counter));
+      ++program_counter;
+      return false;
+   }
+
+   template <Index Processor::* INDEX>
+   bool Processor::micro_fetch_address_high_indexed() noexcept
+   {
+      // fetch high byte of address, add index register to low address byte, increment PC
+      Byte const high_byte_of_address{ memory_.read(program_counter) };
+      auto const [low_byte_of_address, overflow]{
+         add_with_overflow(low_byte(microcode_state_.address), this->*INDEX)
+      };
+      microcode_state_.address = assemble_word(high_byte_of_address, low_byte_of_address);
+      microcode_state_.overflow = overflow;
+      ++program_counter;
+      return false;
+   }
+
+   template <Index Processor::* INDEX>
+   bool Processor::micro_index_zero_page() noexcept
+   {
+      // read from address, add index register to it
+      dummy_read(microcode_state_.address);
+      microcode_state_.address = static_cast<Byte>(microcode_state_.address + this->*INDEX);
+      return false;
+   }
+
+   bool Processor::micro_fetch_pointer() noexcept
+   {
+      // fetch pointer address, increment PC
+      microcode_state_.pointer = memory_.read(program_counter);
+      ++program_counter;
+      return false;
+   }
+
+   bool Processor::micro_index_pointer() noexcept
+   {
+      // read from the address, add X to it
+      dummy_read(microcode_state_.pointer);
+      microcode_state_.pointer += x_;
+      return false;
+   }
+
+   bool Processor::micro_fetch_pointed_low() noexcept
+   {
+      // fetch effective address low
+      microcode_state_.address = memory_.read(microcode_state_.pointer);
+      return false;
+   }
+
+   bool Processor::micro_fetch_pointed_high() noexcept
+   {
+      // fetch effective address high
+      ++microcode_state_.pointer;
+      microcode_state_.address = assign_high_byte(microcode_state_.address, memory_.read(microcode_state_.pointer));
+      return false;
+   }
+
+   bool Processor::micro_fetch_pointed_high_indexed() noexcept
+   {
+      // fetch effective address high, add Y to low byte of effective address
+      ++microcode_state_.pointer;
+      Byte const effective_address_high{ memory_.read(microcode_state_.pointer) };
+      auto const [effective_address_low, overflow]{ add_with_overflow(low_byte(microcode_state_.address), y_) };
+      microcode_state_.address = assemble_word(effective_address_high, effective_address_low);
+      microcode_state_.overflow = overflow;
+      return false;
+   }
+
+   bool Processor::micro_fix_address() noexcept
+   {
+      // read from effective address, fix the high byte of effective address
+      dummy_read(microcode_state_.address);
+      microcode_state_.address = assign_high_byte(microcode_state_.address,
+         static_cast<Byte>(high_byte(microcode_state_.address) + microcode_state_.overflow));
+      return false;
+   }
+
+   template <Processor::ReadOperation OPERATION>
+   bool Processor::micro_read_immediate() noexcept
+   {
+      // fetch value, increment PC
+      Byte const value{ memory_.read(program_counter) };
+      ++program_counter;
+
+      std::invoke(OPERATION, this, value);
+      return false;
+   }
+
+   template <Processor::ReadOperation OPERATION>
+   bool Processor::micro_read() noexcept
+   {
+      // read from effective address
+      std::invoke(OPERATION, this, memory_.read(microcode_state_.address));
+      return false;
+   }
+
+   template <Processor::ReadOperation OPERATION>
+   bool Processor::micro_read_indexed() noexcept
+   {
+      // read from effective address, fix the high byte of effective address, re-read from it next cycle (+)
+      if (microcode_state_.overflow)
+      {
+         dummy_read(microcode_state_.address);
+         microcode_state_.address = assign_high_byte(microcode_state_.address,
+            static_cast<Byte>(high_byte(microcode_state_.address) + 1));
+         return false;
+      }
+
+      std::invoke(OPERATION, this, memory_.read(microcode_state_.address));
+      return true;
+   }
+
+   template <Processor::ModifyOperation OPERATION>
+   bool Processor::micro_modify_accumulator() noexcept
+   {
+      // do the operation on the accumulator
+      accumulator_ = std::invoke(OPERATION, this, accumulator_);
+      return false;
+   }
+
+   bool Processor::micro_read_value() noexcept
+   {
+      // read from effective address
+      microcode_state_.value = memory_.read(microcode_state_.address);
+      return false;
+   }
+
+   template <Processor::ModifyOperation OPERATION>
+   bool Processor::micro_modify() noexcept
+   {
+      // write the value back to effective address, and do the operation on it
+      memory_.write(microcode_state_.address, microcode_state_.value);
+      microcode_state_.value = std::invoke(OPERATION, this, microcode_state_.value);
+      return false;
+   }
+
+   bool Processor::micro_write_value() noexcept
+   {
+      // write the new value to effective address
+      memory_.write(microcode_state_.address, microcode_state_.value);
+      return false;
+   }
+
+   template <Processor::WriteOperation OPERATION>
+   bool Processor::micro_write() noexcept
+   {
+      // write register to effective address
+      memory_.write(microcode_state_.address, std::invoke(OPERATION, this));
+      return false;
+   }
+
+   bool Processor::micro_fetch_operand() noexcept
+   {
+      // fetch operand, increment PC
+      microcode_state_.value = memory_.read(program_counter);
+      ++program_counter;
+      return false;
+   }
+
+   template <Processor::BranchOperation OPERATION>
+   bool Processor::micro_branch() noexcept
+   {
+      // fetch opcode of next instruction, if branch is taken, add operand to PCL (and throw the opcode away),
+      // otherwise increment PC
+      if (not std::invoke(OPERATION, this))
+         return micro_prefetch(memory_.read(program_counter));
+
+      dummy_read(program_counter);
+      auto const [program_counter_low, overflow]{
+         add_with_overflow(low_byte(program_counter), static_cast<SignedByte>(microcode_state_.value))
+      };
+      program_counter = assign_low_byte(program_counter, program_counter_low);
+      microcode_state_.overflow = overflow;
+      return false;
+   }
+
+   bool Processor::micro_branch_taken() noexcept
+   {
+      // fetch opcode of next instruction, fix PCH (and throw the opcode away), if it did not change, increment PC (+)
+      if (not microcode_state_.overflow)
+         return micro_prefetch(memory_.read(program_counter));
+
+      dummy_read(program_counter);
+      program_counter = assign_high_byte(program_counter,
+         static_cast<Byte>(high_byte(program_counter) + microcode_state_.overflow));
+      return false;
+   }
+
+   bool Processor::micro_branch_page_crossed() noexcept
+   {
+      // fetch opcode of next instruction, increment PC (!)
+      return micro_prefetch(memory_.read(program_counter));
+   }
+
+   bool Processor::micro_prefetch(Byte const opcode) noexcept
+   {
+      // the next instruction starts with its first micro-op, its opcode fetch overlapped the branch
+      ++program_counter;
+      current_opcode_ = static_cast<Opcode>(opcode);
+      if (profiler_)
+         profiler_->record(opcode);
+
+      if (cycle_ < cycle_limit_)
+         skip_idle_loop(static_cast<Word>(program_counter - 1), current_opcode_);
+
+      microcode_state_.opcode = opcode;
+      microcode_state_.step = 0;
+      return true;
+   }
+
+   template <Processor::ProcessorStatusFlag FLAG, bool SET>
+   bool Processor::micro_flag() noexcept
+   {
+      change_processor_status_flag(FLAG, SET);
+      return false;
+   }
+
+   template <Byte Processor::* SOURCE, Byte Processor::* TARGET>
+   bool Processor::micro_transfer() noexcept
+   {
+      update_zero_and_negative_flag(this->*TARGET = this->*SOURCE);
+      return false;
+   }
+
+   template <Byte Processor::* REGISTER>
+   bool Processor::micro_increment() noexcept
+   {
+      update_zero_and_negative_flag(++(this->*REGISTER));
+      return false;
+   }
+
+   template <Byte Processor::* REGISTER>
+   bool Processor::micro_decrement() noexcept
+   {
+      update_zero_and_negative_flag(--(this->*REGISTER));
+      return false;
+   }
+
+   bool Processor::micro_TXS() noexcept
+   {
+      // transfer X to S
+      stack_pointer_ = x_;
+      return false;
+   }
+
+   bool Processor::micro_NOP() noexcept
+   {
+      return false;
+   }
+
+   bool Processor::micro_read_next() noexcept
+   {
+      // read next instruction byte (and throw it away)
+      dummy_read(program_counter);
+      return false;
+   }
+
+   bool Processor::micro_internal_operation() noexcept
+   {
+      return false;
+   }
+
+   bool Processor::micro_increment_stack_pointer() noexcept
+   {
+      // increment S
+      ++stack_pointer_;
+      return false;
+   }
+
+   bool Processor::micro_push_program_counter_high() noexcept
+   {
+      // push PCH on stack, decrement S
+      write_to_stack(high_byte(program_counter));
+      --stack_pointer_;
+      return false;
+   }
+
+   bool Processor::micro_push_program_counter_low() noexcept
+   {
+      // push PCL on stack, decrement S
+      write_to_stack(low_byte(program_counter));
+      --stack_pointer_;
+      return false;
+   }
+
+   bool Processor::micro_pull_program_counter_low() noexcept
+   {
+      // pull PCL from stack, increment S
+      program_counter = assign_low_byte(program_counter, read_from_stack());
+      ++stack_pointer_;
+      return false;
+   }
+
+   bool Processor::micro_pull_program_counter_high() noexcept
+   {
+      // pull PCH from stack
+      program_counter = assign_high_byte(program_counter, read_from_stack());
+      return false;
+   }
+
+   bool Processor::micro_increment_program_counter() noexcept
+   {
+      // increment PC
+      ++program_counter;
+      return false;
+   }
+
+   bool Processor::micro_jump() noexcept
+   {
+      // copy low address byte to PCL, fetch high address byte to PCH
+      program_counter = assemble_word(memory_.read(program_counter), low_byte(microcode_state_.address));
+      return false;
+   }
+
+   bool Processor::micro_jump_indirect() noexcept
+   {
+      // fetch PCH, copy latch to PCL
+      program_counter = assemble_word(memory_.read(indirect_jump_high_address(microcode_state_.address)),
+         microcode_state_.value);
+      return false;
+   }
+
+   bool Processor::micro_BRK_fetch_padding() noexcept
+   {
+      // read next instruction byte (and throw it away), increment PC
+      dummy_read(program_counter);
+      ++program_counter;
+      return false;
+   }
+
+   bool Processor::micro_BRK_push_program_counter_high() noexcept
+   {
+      // push PCH on stack (with B flag set), decrement S
+      change_processor_status_flag(ProcessorStatusFlag::B, true);
+      return micro_push_program_counter_high();
+   }
+
+   bool Processor::micro_BRK_push_processor_status() noexcept
+   {
+      // push P on stack, decrement S
+      resolve_processor_status();
+      write_to_stack(processor_status_);
+      --stack_pointer_;
+      return false;
+   }
+
+   bool Processor::micro_BRK_fetch_vector_low() noexcept
+   {
+      // fetch PCL
+      program_counter = assign_low_byte(program_counter, memory_.read(IRQ_LOW));
+      return false;
+   }
+
+   bool Processor::micro_BRK_fetch_vector_high() noexcept
+   {
+      // fetch PCH
+      program_counter = assign_high_byte(program_counter, memory_.read(IRQ_HIGH));
+
+      // the handler starts with interrupts disabled
+      change_processor_status_flag(ProcessorStatusFlag::I, true);
+      return false;
+   }
+
+   bool Processor::micro_PHP() noexcept
+   {
+      // push register on stack (with B and _ flag set), decrement S
+      change_processor_status_flag(ProcessorStatusFlag::B, true);
+      change_processor_status_flag(ProcessorStatusFlag::_, true);
+      resolve_processor_status();
+      write_to_stack(processor_status_);
+      --stack_pointer_;
+      return false;
+   }
+
+   bool Processor::micro_PHA() noexcept
+   {
+      // push register on stack, decrement S
+      write_to_stack(accumulator_);
+      --stack_pointer_;
+      return false;
+   }
+
+   bool Processor::micro_PLP() noexcept
+   {
+      // pull register from stack (with B and _ flag ignored)
+      pull_processor_status();
+      return false;
+   }
+
+   bool Processor::micro_PLA() noexcept
+   {
+      // pull register from stack
+      update_zero_and_negative_flag(accumulator_ = read_from_stack());
+      return false;
+   }
+
+   bool Processor::micro_RTI_pull_processor_status() noexcept
+   {
+      // pull P from stack, increment S
+      micro_PLP();
+      ++stack_pointer_;
+      return false;
+   }
+
+   bool Processor::micro_unsupported() noexcept
+   {
+      freeze();
+      return true;
+   }
+}
\ No newline at end of file
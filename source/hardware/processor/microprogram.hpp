@@ -0,0 +1,24 @@
+#ifndef MICROPROGRAM_HPP
+#define MICROPROGRAM_HPP
+
+#include "hardware/types.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   class Processor;
+
+   // The micro-ops an instruction runs after its opcode fetch, one per cycle. A micro-op returns whether it ended the
+   // instruction early, like a read that did not cross a page or a branch that was not taken.
+   struct Microprogram final
+   {
+      using MicroOp = bool(*)(Processor& processor);
+
+      static std::size_t constexpr MAX_LENGTH{ 7 };
+
+      std::array<MicroOp, MAX_LENGTH> micro_ops;
+      Byte length;
+   };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,308 @@
+#ifndef OPCODE_INFO_HPP
+#define OPCODE_INFO_HPP
+
+#include "addressing_mode.hpp"
+#include "hardware/types.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   // What there is to know about an opcode without executing it
+   struct OpcodeInfo final
+   {
+      std::string_view mnemonic;
+      AddressingMode mode;
+      // BRK counts the padding byte it skips, making it two bytes long
+      Byte length;
+      Byte cycles;
+      // a read spends an extra cycle when its indexing crosses a page, a taken branch when its target is on another one
+      bool page_crossing;
+      bool official;
+
+      // cycles the instruction takes, given whether it crossed a page and, for branches, whether it was taken
+      [[nodiscard]] constexpr Cycle predicted_cycles(bool const page_crossed,
+         bool const branch_taken = false) const noexcept
+      {
+         if (mode == AddressingMode::RELATIVE)
+            return cycles + branch_taken + (branch_taken and page_crossed);
+
+         return cycles + (page_crossing and page_crossed);
+      }
+   };
+
+   std::array<OpcodeInfo, 256> constexpr OPCODE_INFOS{ {
+      { "BRK", AddressingMode::IMPLIED,     2, 7, false, true  }, // 00
+      { "ORA", AddressingMode::X_INDIRECT,  2, 6, false, true  }, // 01
+      { "JAM", AddressingMode::IMPLIED,     1, 2, false, false }, // 02
+      { "SLO", AddressingMode::X_INDIRECT,  2, 8, false, false }, // 03
+      { "NOP", AddressingMode::ZERO_PAGE,   2, 3, false, false }, // 04
+      { "ORA", AddressingMode::ZERO_PAGE,   2, 3, false, true  }, // 05
+      { "ASL", AddressingMode::ZERO_PAGE,   2, 5, false, true  }, // 06
+      { "SLO", AddressingMode::ZERO_PAGE,   2, 5, false, false }, // 07
+      { "PHP", AddressingMode::IMPLIED,     1, 3, false, true  }, // 08
+      { "ORA", AddressingMode::IMMEDIATE,   2, 2, false, true  }, // 09
+      { "ASL", AddressingMode::ACCUMULATOR, 1, 2, false, true  }, // 0A
+      { "ANC", AddressingMode::IMMEDIATE,   2, 2, false, false }, // 0B
+      { "NOP", AddressingMode::ABSOLUTE,    3, 4, false, false }, // 0C
+      { "ORA", AddressingMode::ABSOLUTE,    3, 4, false, true  }, // 0D
+      { "ASL", AddressingMode::ABSOLUTE,    3, 6, false, true  }, // 0E
+      { "SLO", AddressingMode::ABSOLUTE,    3, 6, false, false }, // 0F
+
+      { "BPL", AddressingMode::RELATIVE,    2, 2, true,  true  }, // 10
+      { "ORA", AddressingMode::INDIRECT_Y,  2, 5, true,  true  }, // 11
+      { "JAM", AddressingMode::IMPLIED,     1, 2, false, false }, // 12
+      { "SLO", AddressingMode::INDIRECT_Y,  2, 8, false, false }, // 13
+      { "NOP", AddressingMode::ZERO_PAGE_X, 2, 4, false, false }, // 14
+      { "ORA", AddressingMode::ZERO_PAGE_X, 2, 4, false, true  }, // 15
+      { "ASL", AddressingMode::ZERO_PAGE_X, 2, 6, false, true  }, // 16
+      { "SLO", AddressingMode::ZERO_PAGE_X, 2, 6, false, false }, // 17
+      { "CLC", AddressingMode::IMPLIED,     1, 2, false, true  }, // 18
+      { "ORA", AddressingMode::ABSOLUTE_Y,  3, 4, true,  true  }, // 19
+      { "NOP", AddressingMode::IMPLIED,     1, 2, false, false }, // 1A
+      { "SLO", AddressingMode::ABSOLUTE_Y,  3, 7, false, false }, // 1B
+      { "NOP", AddressingMode::ABSOLUTE_X,  3, 4, true,  false }, // 1C
+      { "ORA", AddressingMode::ABSOLUTE_X,  3, 4, true,  true  }, // 1D
+      { "ASL", AddressingMode::ABSOLUTE_X,  3, 7, false, true  }, // 1E
+      { "SLO", AddressingMode::ABSOLUTE_X,  3, 7, false, false }, // 1F
+
+      { "JSR", AddressingMode::ABSOLUTE,    3, 6, false, true  }, // 20
+      { "AND", AddressingMode::X_INDIRECT,  2, 6, false, true  }, // 21
+      { "JAM", AddressingMode::IMPLIED,     1, 2, false, false }, // 22
+      { "RLA", AddressingMode::X_INDIRECT,  2, 8, false, false }, // 23
+      { "BIT", AddressingMode::ZERO_PAGE,   2, 3, false, true  }, // 24
+      { "AND", AddressingMode::ZERO_PAGE,   2, 3, false, true  }, // 25
+      { "ROL", AddressingMode::ZERO_PAGE,   2, 5, false, true  }, // 26
+      { "RLA", AddressingMode::ZERO_PAGE,   2, 5, false, false }, // 27
+      { "PLP", AddressingMode::IMPLIED,     1, 4, false, true  }, // 28
+      { "AND", AddressingMode::IMMEDIATE,   2, 2, false, true  }, // 29
+      { "ROL", AddressingMode::ACCUMULATOR, 1, 2, false, true  }, // 2A
+      { "ANC", AddressingMode::IMMEDIATE,   2, 2, false, false }, // 2B
+      { "BIT", AddressingMode::ABSOLUTE,    3, 4, false, true  }, // 2C
+      { "AND", AddressingMode::ABSOLUTE,    3, 4, false, true  }, // 2D
+      { "ROL", AddressingMode::ABSOLUTE,    3, 6, false, true  }, // 2E
+      { "RLA", AddressingMode::ABSOLUTE,    3, 6, false, false }, // 2F
+
+      { "BMI", AddressingMode::RELATIVE,    2, 2, true,  true  }, // 30
+      { "AND", AddressingMode::INDIRECT_Y,  2, 5, true,  true  }, // 31
+      { "JAM", AddressingMode::IMPLIED,     1, 2, false, false }, // 32
+      { "RLA", AddressingMode::INDIRECT_Y,  2, 8, false, false }, // 33
+      { "NOP", AddressingMode::ZERO_PAGE_X, 2, 4, false, false }, // 34
+      { "AND", AddressingMode::ZERO_PAGE_X, 2, 4, false, true  }, // 35
+      { "ROL", AddressingMode::ZERO_PAGE_X, 2, 6, false, true  }, // 36
+      { "RLA", AddressingMode::ZERO_PAGE_X, 2, 6, false, false }, // 37
+      { "SEC", AddressingMode::IMPLIED,     1, 2, false, true  }, // 38
+      { "AND", AddressingMode::ABSOLUTE_Y,  3, 4, true,  true  }, // 39
+      { "NOP", AddressingMode::IMPLIED,     1, 2, false, false }, // 3A
+      { "RLA", AddressingMode::ABSOLUTE_Y,  3, 7, false, false }, // 3B
+      { "NOP", AddressingMode::ABSOLUTE_X,  3, 4, true,  false }, // 3C
+      { "AND", AddressingMode::ABSOLUTE_X,  3, 4, true,  true  }, // 3D
+      { "ROL", AddressingMode::ABSOLUTE_X,  3, 7, false, true  }, // 3E
+      { "RLA", AddressingMode::ABSOLUTE_X,  3, 7, false, false }, // 3F
+
+      { "RTI", AddressingMode::IMPLIED,     1, 6, false, true  }, // 40
+      { "EOR", AddressingMode::X_INDIRECT,  2, 6, false, true  }, // 41
+      { "JAM", AddressingMode::IMPLIED,     1, 2, false, false }, // 42
+      { "SRE", AddressingMode::X_INDIRECT,  2, 8, false, false }, // 43
+      { "NOP", AddressingMode::ZERO_PAGE,   2, 3, false, false }, // 44
+      { "EOR", AddressingMode::ZERO_PAGE,   2, 3, false, true  }, // 45
+      { "LSR", AddressingMode::ZERO_PAGE,   2, 5, false, true  }, // 46
+      { "SRE", AddressingMode::ZERO_PAGE,   2, 5, false, false }, // 47
+      { "PHA", AddressingMode::IMPLIED,     1, 3, false, true  }, // 48
+      { "EOR", AddressingMode::IMMEDIATE,   2, 2, false, true  }, // 49
+      { "LSR", AddressingMode::ACCUMULATOR, 1, 2, false, true  }, // 4A
+      { "ALR", AddressingMode::IMMEDIATE,   2, 2, false, false }, // 4B
+      { "JMP", AddressingMode::ABSOLUTE,    3, 3, false, true  }, // 4C
+      { "EOR", AddressingMode::ABSOLUTE,    3, 4, false, true  }, // 4D
+      { "LSR", AddressingMode::ABSOLUTE,    3, 6, false, true  }, // 4E
+      { "SRE", AddressingMode::ABSOLUTE,    3, 6, false, false }, // 4F
+
+      { "BVC", AddressingMode::RELATIVE,    2, 2, true,  true  }, // 50
+      { "EOR", AddressingMode::INDIRECT_Y,  2, 5, true,  true  }, // 51
+      { "JAM", AddressingMode::IMPLIED,     1, 2, false, false }, // 52
+      { "SRE", AddressingMode::INDIRECT_Y,  2, 8, false, false }, // 53
+      { "NOP", AddressingMode::ZERO_PAGE_X, 2, 4, false, false }, // 54
+      { "EOR", AddressingMode::ZERO_PAGE_X, 2, 4, false, true  }, // 55
+      { "LSR", AddressingMode::ZERO_PAGE_X, 2, 6, false, true  }, // 56
+      { "SRE", AddressingMode::ZERO_PAGE_X, 2, 6, false, false }, // 57
+      { "CLI", AddressingMode::IMPLIED,     1, 2, false, true  }, // 58
+      { "EOR", AddressingMode::ABSOLUTE_Y,  3, 4, true,  true  }, // 59
+      { "NOP", AddressingMode::IMPLIED,     1, 2, false, false }, // 5A
+      { "SRE", AddressingMode::ABSOLUTE_Y,  3, 7, false, false }, // 5B
+      { "NOP", AddressingMode::ABSOLUTE_X,  3, 4, true,  false }, // 5C
+      { "EOR", AddressingMode::ABSOLUTE_X,  3, 4, true,  true  }, // 5D
+      { "LSR", AddressingMode::ABSOLUTE_X,  3, 7, false, true  }, // 5E
+      { "SRE", AddressingMode::ABSOLUTE_X,  3, 7, false, false }, // 5F
+
+      { "RTS", AddressingMode::IMPLIED,     1, 6, false, true  }, // 60
+      { "ADC", AddressingMode::X_INDIRECT,  2, 6, false, true  }, // 61
+      { "JAM", AddressingMode::IMPLIED,     1, 2, false, false }, // 62
+      { "RRA", AddressingMode::X_INDIRECT,  2, 8, false, false }, // 63
+      { "NOP", AddressingMode::ZERO_PAGE,   2, 3, false, false }, // 64
+      { "ADC", AddressingMode::ZERO_PAGE,   2, 3, false, true  }, // 65
+      { "ROR", AddressingMode::ZERO_PAGE,   2, 5, false, true  }, // 66
+      { "RRA", AddressingMode::ZERO_PAGE,   2, 5, false, false }, // 67
+      { "PLA", AddressingMode::IMPLIED,     1, 4, false, true  }, // 68
+      { "ADC", AddressingMode::IMMEDIATE,   2, 2, false, true  }, // 69
+      { "ROR", AddressingMode::ACCUMULATOR, 1, 2, false, true  }, // 6A
+      { "ARR", AddressingMode::IMMEDIATE,   2, 2, false, false }, // 6B
+      { "JMP", AddressingMode::INDIRECT,    3, 5, false, true  }, // 6C
+      { "ADC", AddressingMode::ABSOLUTE,    3, 4, false, true  }, // 6D
+      { "ROR", AddressingMode::ABSOLUTE,    3, 6, false, true  }, // 6E
+      { "RRA", AddressingMode::ABSOLUTE,    3, 6, false, false }, // 6F
+
+      { "BVS", AddressingMode::RELATIVE,    2, 2, true,  true  }, // 70
+      { "ADC", AddressingMode::INDIRECT_Y,  2, 5, true,  true  }, // 71
+      { "JAM", AddressingMode::IMPLIED,     1, 2, false, false }, // 72
+      { "RRA", AddressingMode::INDIRECT_Y,  2, 8, false, false }, // 73
+      { "NOP", AddressingMode::ZERO_PAGE_X, 2, 4, false, false }, // 74
+      { "ADC", AddressingMode::ZERO_PAGE_X, 2, 4, false, true  }, // 75
+      { "ROR", AddressingMode::ZERO_PAGE_X, 2, 6, false, true  }, // 76
+      { "RRA", AddressingMode::ZERO_PAGE_X, 2, 6, false, false }, // 77
+      { "SEI", AddressingMode::IMPLIED,     1, 2, false, true  }, // 78
+      { "ADC", AddressingMode::ABSOLUTE_Y,  3, 4, true,  true  }, // 79
+      { "NOP", AddressingMode::IMPLIED,     1, 2, false, false }, // 7A
+      { "RRA", AddressingMode::ABSOLUTE_Y,  3, 7, false, false }, // 7B
+      { "NOP", AddressingMode::ABSOLUTE_X,  3, 4, true,  false }, // 7C
+      { "ADC", AddressingMode::ABSOLUTE_X,  3, 4, true,  true  }, // 7D
+      { "ROR", AddressingMode::ABSOLUTE_X,  3, 7, false, true  }, // 7E
+      { "RRA", AddressingMode::ABSOLUTE_X,  3, 7, false, false }, // 7F
+
+      { "NOP", AddressingMode::IMMEDIATE,   2, 2, false, false }, // 80
+      { "STA", AddressingMode::X_INDIRECT,  2, 6, false, true  }, // 81
+      { "NOP", AddressingMode::IMMEDIATE,   2, 2, false, false }, // 82
+      { "SAX", AddressingMode::X_INDIRECT,  2, 6, false, false }, // 83
+      { "STY", AddressingMode::ZERO_PAGE,   2, 3, false, true  }, // 84
+      { "STA", AddressingMode::ZERO_PAGE,   2, 3, false, true  }, // 85
+      { "STX", AddressingMode::ZERO_PAGE,   2, 3, false, true  }, // 86
+      { "SAX", AddressingMode::ZERO_PAGE,   2, 3, false, false }, // 87
+      { "DEY", AddressingMode::IMPLIED,     1, 2, false, true  }, // 88
+      { "NOP", AddressingMode::IMMEDIATE,   2, 2, false, false }, // 89
+      { "TXA", AddressingMode::IMPLIED,     1, 2, false, true  }, // 8A
+      { "ANE", AddressingMode::IMMEDIATE,   2, 2, false, false }, // 8B
+      { "STY", AddressingMode::ABSOLUTE,    3, 4, false, true  }, // 8C
+      { "STA", AddressingMode::ABSOLUTE,    3, 4, false, true  }, // 8D
+      { "STX", AddressingMode::ABSOLUTE,    3, 4, false, true  }, // 8E
+      { "SAX", AddressingMode::ABSOLUTE,    3, 4, false, false }, // 8F
+
+      { "BCC", AddressingMode::RELATIVE,    2, 2, true,  true  }, // 90
+      { "STA", AddressingMode::INDIRECT_Y,  2, 6, false, true  }, // 91
+      { "JAM", AddressingMode::IMPLIED,     1, 2, false, false }, // 92
+      { "SHA", AddressingMode::INDIRECT_Y,  2, 6, false, false }, // 93
+      { "STY", AddressingMode::ZERO_PAGE_X, 2, 4, false, true  }, // 94
+      { "STA", AddressingMode::ZERO_PAGE_X, 2, 4, false, true  }, // 95
+      { "STX", AddressingMode::ZERO_PAGE_Y, 2, 4, false, true  }, // 96
+      { "SAX", AddressingMode::ZERO_PAGE_Y, 2, 4, false, false }, // 97
+      { "TYA", AddressingMode::IMPLIED,     1, 2, false, true  }, // 98
+      { "STA", AddressingMode::ABSOLUTE_Y,  3, 5, false, true  }, // 99
+      { "TXS", AddressingMode::IMPLIED,     1, 2, false, true  }, // 9A
+      { "TAS", AddressingMode::ABSOLUTE_Y,  3, 5, false, false }, // 9B
+      { "SHY", AddressingMode::ABSOLUTE_X,  3, 5, false, false }, // 9C
+      { "STA", AddressingMode::ABSOLUTE_X,  3, 5, false, true  }, // 9D
+      { "SHX", AddressingMode::ABSOLUTE_Y,  3, 5, false, false }, // 9E
+      { "SHA", AddressingMode::ABSOLUTE_Y,  3, 5, false, false }, // 9F
+
+      { "LDY", AddressingMode::IMMEDIATE,   2, 2, false, true  }, // A0
+      { "LDA", AddressingMode::X_INDIRECT,  2, 6, false, true  }, // A1
+      { "LDX", AddressingMode::IMMEDIATE,   2, 2, false, true  }, // A2
+      { "LAX", AddressingMode::X_INDIRECT,  2, 6, false, false }, // A3
+      { "LDY", AddressingMode::ZERO_PAGE,   2, 3, false, true  }, // A4
+      { "LDA", AddressingMode::ZERO_PAGE,   2, 3, false, true  }, // A5
+      { "LDX", AddressingMode::ZERO_PAGE,   2, 3, false, true  }, // A6
+      { "LAX", AddressingMode::ZERO_PAGE,   2, 3, false, false }, // A7
+      { "TAY", AddressingMode::IMPLIED,     1, 2, false, true  }, // A8
+      { "LDA", AddressingMode::IMMEDIATE,   2, 2, false, true  }, // A9
+      { "TAX", AddressingMode::IMPLIED,     1, 2, false, true  }, // AA
+      { "LXA", AddressingMode::IMMEDIATE,   2, 2, false, false }, // AB
+      { "LDY", AddressingMode::ABSOLUTE,    3, 4, false, true  }, // AC
+      { "LDA", AddressingMode::ABSOLUTE,    3, 4, false, true  }, // AD
+      { "LDX", AddressingMode::ABSOLUTE,    3, 4, false, true  }, // AE
+      { "LAX", AddressingMode::ABSOLUTE,    3, 4, false, false }, // AF
+
+      { "BCS", AddressingMode::RELATIVE,    2, 2, true,  true  }, // B0
+      { "LDA", AddressingMode::INDIRECT_Y,  2, 5, true,  true  }, // B1
+      { "JAM", AddressingMode::IMPLIED,     1, 2, false, false }, // B2
+      { "LAX", AddressingMode::INDIRECT_Y,  2, 5, true,  false }, // B3
+      { "LDY", AddressingMode::ZERO_PAGE_X, 2, 4, false, true  }, // B4
+      { "LDA", AddressingMode::ZERO_PAGE_X, 2, 4, false, true  }, // B5
+      { "LDX", AddressingMode::ZERO_PAGE_Y, 2, 4, false, true  }, // B6
+      { "LAX", AddressingMode::ZERO_PAGE_Y, 2, 4, false, false }, // B7
+      { "CLV", AddressingMode::IMPLIED,     1, 2, false, true  }, // B8
+      { "LDA", AddressingMode::ABSOLUTE_Y,  3, 4, true,  true  }, // B9
+      { "TSX", AddressingMode::IMPLIED,     1, 2, false, true  }, // BA
+      { "LAS", AddressingMode::ABSOLUTE_Y,  3, 4, true,  false }, // BB
+      { "LDY", AddressingMode::ABSOLUTE_X,  3, 4, true,  true  }, // BC
+      { "LDA", AddressingMode::ABSOLUTE_X,  3, 4, true,  true  }, // BD
+      { "LDX", AddressingMode::ABSOLUTE_Y,  3, 4, true,  true  }, // BE
+      { "LAX", AddressingMode::ABSOLUTE_Y,  3, 4, true,  false }, // BF
+
+      { "CPY", AddressingMode::IMMEDIATE,   2, 2, false, true  }, // C0
+      { "CMP", AddressingMode::X_INDIRECT,  2, 6, false, true  }, // C1
+      { "NOP", AddressingMode::IMMEDIATE,   2, 2, false, false }, // C2
+      { "DCP", AddressingMode::X_INDIRECT,  2, 8, false, false }, // C3
+      { "CPY", AddressingMode::ZERO_PAGE,   2, 3, false, true  }, // C4
+      { "CMP", AddressingMode::ZERO_PAGE,   2, 3, false, true  }, // C5
+      { "DEC", AddressingMode::ZERO_PAGE,   2, 5, false, true  }, // C6
+      { "DCP", AddressingMode::ZERO_PAGE,   2, 5, false, false }, // C7
+      { "INY", AddressingMode::IMPLIED,     1, 2, false, true  }, // C8
+      { "CMP", AddressingMode::IMMEDIATE,   2, 2, false, true  }, // C9
+      { "DEX", AddressingMode::IMPLIED,     1, 2, false, true  }, // CA
+      { "SBX", AddressingMode::IMMEDIATE,   2, 2, false, false }, // CB
+      { "CPY", AddressingMode::ABSOLUTE,    3, 4, false, true  }, // CC
+      { "CMP", AddressingMode::ABSOLUTE,    3, 4, false, true  }, // CD
+      { "DEC", AddressingMode::ABSOLUTE,    3, 6, false, true  }, // CE
+      { "DCP", AddressingMode::ABSOLUTE,    3, 6, false, false }, // CF
+
+      { "BNE", AddressingMode::RELATIVE,    2, 2, true,  true  }, // D0
+      { "CMP", AddressingMode::INDIRECT_Y,  2, 5, true,  true  }, // D1
+      { "JAM", AddressingMode::IMPLIED,     1, 2, false, false }, // D2
+      { "DCP", AddressingMode::INDIRECT_Y,  2, 8, false, false }, // D3
+      { "NOP", AddressingMode::ZERO_PAGE_X, 2, 4, false, false }, // D4
+      { "CMP", AddressingMode::ZERO_PAGE_X, 2, 4, false, true  }, // D5
+      { "DEC", AddressingMode::ZERO_PAGE_X, 2, 6, false, true  }, // D6
+      { "DCP", AddressingMode::ZERO_PAGE_X, 2, 6, false, false }, // D7
+      { "CLD", AddressingMode::IMPLIED,     1, 2, false, true  }, // D8
+      { "CMP", AddressingMode::ABSOLUTE_Y,  3, 4, true,  true  }, // D9
+      { "NOP", AddressingMode::IMPLIED,     1, 2, false, false }, // DA
+      { "DCP", AddressingMode::ABSOLUTE_Y,  3, 7, false, false }, // DB
+      { "NOP", AddressingMode::ABSOLUTE_X,  3, 4, true,  false }, // DC
+      { "CMP", AddressingMode::ABSOLUTE_X,  3, 4, true,  true  }, // DD
+      { "DEC", AddressingMode::ABSOLUTE_X,  3, 7, false, true  }, // DE
+      { "DCP", AddressingMode::ABSOLUTE_X,  3, 7, false, false }, // DF
+
+      { "CPX", AddressingMode::IMMEDIATE,   2, 2, false, true  }, // E0
+      { "SBC", AddressingMode::X_INDIRECT,  2, 6, false, true  }, // E1
+      { "NOP", AddressingMode::IMMEDIATE,   2, 2, false, false }, // E2
+      { "ISC", AddressingMode::X_INDIRECT,  2, 8, false, false }, // E3
+      { "CPX", AddressingMode::ZERO_PAGE,   2, 3, false, true  }, // E4
+      { "SBC", AddressingMode::ZERO_PAGE,   2, 3, false, true  }, // E5
+      { "INC", AddressingMode::ZERO_PAGE,   2, 5, false, true  }, // E6
+      { "ISC", AddressingMode::ZERO_PAGE,   2, 5, false, false }, // E7
+      { "INX", AddressingMode::IMPLIED,     1, 2, false, true  }, // E8
+      { "SBC", AddressingMode::IMMEDIATE,   2, 2, false, true  }, // E9
+      { "NOP", AddressingMode::IMPLIED,     1, 2, false, true  }, // EA
+      { "SBC", AddressingMode::IMMEDIATE,   2, 2, false, false }, // EB
+      { "CPX", AddressingMode::ABSOLUTE,    3, 4, false, true  }, // EC
+      { "SBC", AddressingMode::ABSOLUTE,    3, 4, false, true  }, // ED
+      { "INC", AddressingMode::ABSOLUTE,    3, 6, false, true  }, // EE
+      { "ISC", AddressingMode::ABSOLUTE,    3, 6, false, false }, // EF
+
+      { "BEQ", AddressingMode::RELATIVE,    2, 2, true,  true  }, // F0
+      { "SBC", AddressingMode::INDIRECT_Y,  2, 5, true,  true  }, // F1
+      { "JAM", AddressingMode::IMPLIED,     1, 2, false, false }, // F2
+      { "ISC", AddressingMode::INDIRECT_Y,  2, 8, false, false }, // F3
+      { "NOP", AddressingMode::ZERO_PAGE_X, 2, 4, false, false }, // F4
+      { "SBC", AddressingMode::ZERO_PAGE_X, 2, 4, false, true  }, // F5
+      { "INC", AddressingMode::ZERO_PAGE_X, 2, 6, false, true  }, // F6
+      { "ISC", AddressingMode::ZERO_PAGE_X, 2, 6, false, false }, // F7
+      { "SED", AddressingMode::IMPLIED,     1, 2, false, true  }, // F8
+      { "SBC", AddressingMode::ABSOLUTE_Y,  3, 4, true,  true  }, // F9
+      { "NOP", AddressingMode::IMPLIED,     1, 2, false, false }, // FA
+      { "ISC", AddressingMode::ABSOLUTE_Y,  3, 7, false, false }, // FB
+      { "NOP", AddressingMode::ABSOLUTE_X,  3, 4, true,  false }, // FC
+      { "SBC", AddressingMode::ABSOLUTE_X,  3, 4, true,  true  }, // FD
+      { "INC", AddressingMode::ABSOLUTE_X,  3, 7, false, true  }, // FE
+      { "ISC", AddressingMode::ABSOLUTE_X,  3, 7, false, false }, // FF
+   } };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,361 @@
+#include "predecode_index.hpp"
+#include "variant.hpp"
+
+namespace nes
+{
+   namespace
+   {
+      // the reset, NMI and IRQ vectors, traced from when a program is loaded without an entry point
+      std::array<Word, 3> constexpr VECTORS{ 0xFF'FC, 0xFF'FA, 0xFF'FE };
+   }
+
+   PredecodeIndex::PredecodeIndex(Memory& memory) noexcept
+      : memory_{ memory }
+      , watcher_{ memory.add_watcher(std::bind_front(&PredecodeIndex::invalidate, this)) }
+   {
+   }
+
+   PredecodeIndex::~PredecodeIndex() noexcept
+   {
+      if (watcher_)
+         memory_.remove_watcher(*watcher_);
+   }
+
+   void PredecodeIndex::load_program(std::filesystem::path const& path, Word const load_address,
+      std::optional<Word> const entry_point)
+   {
+      clear();
+      std::size_t const size{ memory_.load_program(path, load_address) };
+      if (not watcher_)
+         return;
+
+      Key key{
+         .hash{ HASH_BASIS },
+         .size{ static_cast<std::uint32_t>(size) },
+         .load_address{ load_address },
+         .entry_point{ entry_point }
+      };
+
+      // the vectors may lie outside of the program, so what they hold is part of what the index depends on
+      auto const hash{ [&key](Byte const byte) { key.hash = (key.hash ^ byte) * HASH_PRIME; } };
+      for (std::size_t offset{}; offset < size; ++offset)
+         hash(memory_.read(static_cast<Word>(load_address + offset)));
+
+      if (not entry_point)
+         for (Word const vector : VECTORS)
+         {
+            hash(memory_.read(vector));
+            hash(memory_.read(static_cast<Word>(vector + 1)));
+         }
+
+      std::filesystem::path const cache{ cache_path(path) };
+      from_cache_ = read_cache(cache, key);
+      if (from_cache_ or not size)
+         return;
+
+      // the code of the program is what is indexed, not whatever its jumps out of it find in memory
+      auto const last{ static_cast<Word>(load_address + size - 1) };
+      if (entry_point)
+         trace(*entry_point, load_address, last);
+      else
+         for (Word const vector : VECTORS)
+            trace(read_word(vector, static_cast<Word>(vector + 1)), load_address, last);
+
+      write_cache(cache, key);
+   }
+
+   void PredecodeIndex::trace(Word const entry_point)
+   {
+      if (watcher_)
+         trace(entry_point, 0x00'00, 0xFF'FF);
+   }
+
+   void PredecodeIndex::clear() noexcept
+   {
+      for (std::size_t address{}; address < flags_.size(); ++address)
+         if (flags_[address] & INSTRUCTION)
+            watch(static_cast<Word>(address), false);
+
+      flags_.fill(0);
+      references_.fill(0);
+      instructions_ = 0;
+      from_cache_ = false;
+   }
+
+   bool PredecodeIndex::instruction(Word const address) const noexcept
+   {
+      return flags_[address] & INSTRUCTION;
+   }
+
+   bool PredecodeIndex::leader(Word const address) const noexcept
+   {
+      bool const to_itself{ flags_[address] & TARGETING and targets_[address] == address };
+      return flags_[address] & INSTRUCTION
+         and (flags_[address] & (ENTERED | RESUMED) or references_[address] > std::uint16_t{ to_itself });
+   }
+
+   bool PredecodeIndex::branch_target(Word const address) const noexcept
+   {
+      return references_[address];
+   }
+
+   std::optional<Word> PredecodeIndex::target(Word const address) const noexcept
+   {
+      if (not(flags_[address] & TARGETING))
+         return std::nullopt;
+
+      return targets_[address];
+   }
+
+   std::size_t PredecodeIndex::instructions() const noexcept
+   {
+      return instructions_;
+   }
+
+   std::size_t PredecodeIndex::invalidations() const noexcept
+   {
+      return invalidations_;
+   }
+
+   bool PredecodeIndex::from_cache() const noexcept
+   {
+      return from_cache_;
+   }
+
+   std::filesystem::path PredecodeIndex::cache_path(std::filesystem::path const& program)
+   {
+      return std::filesystem::path{ program } += ".predecode";
+   }
+
+   void PredecodeIndex::trace(Word const entry_point, Word const first, Word const last)
+   {
+      std::vector<std::pair<Word, Byte>> pending{ { entry_point, ENTERED } };
+      while (not pending.empty())
+      {
+         auto [address, flags]{ pending.back() };
+         pending.pop_back();
+
+         while (static_cast<Word>(address - first) <= static_cast<Word>(last - first))
+         {
+            // code traced before is not traced again, only how it is got to is noted
+            if (flags_[address] & INSTRUCTION)
+            {
+               flags_[address] |= flags;
+               break;
+            }
+
+            OpcodeInfo const& info{ this->info(address) };
+            auto const next{ static_cast<Word>(address + info.length) };
+            auto const operand{
+               info.length < 3
+                  ? Word{ memory_.read(static_cast<Word>(address + 1)) }
+                  : read_word(static_cast<Word>(address + 1), static_cast<Word>(address + 2))
+            };
+
+            if (info.mode == AddressingMode::RELATIVE)
+            {
+               auto const target{ static_cast<Word>(next + static_cast<SignedByte>(operand)) };
+               add(address, flags | TARGETING, target);
+               pending.emplace_back(target, 0);
+               pending.emplace_back(next, RESUMED);
+               break;
+            }
+
+            if (info.mnemonic == "JMP")
+            {
+               if (info.mode == AddressingMode::ABSOLUTE)
+               {
+                  add(address, flags | TARGETING, operand);
+                  pending.emplace_back(operand, 0);
+               }
+               else
+               {
+                  // most likely where the pointer points when the program is loaded
+                  add(address, flags, 0x00'00);
+                  pending.emplace_back(read_word(operand, Variant::INDIRECT_JUMP_WRAPS
+                     ? static_cast<Word>((operand & 0xFF'00) | static_cast<Byte>(operand + 1))
+                     : static_cast<Word>(operand + 1)), ENTERED);
+               }
+
+               break;
+            }
+
+            if (info.mnemonic == "JSR")
+            {
+               add(address, flags | TARGETING, operand);
+               pending.emplace_back(operand, 0);
+               pending.emplace_back(next, RESUMED);
+               break;
+            }
+
+            // the handler returns past the padding byte
+            if (info.mnemonic == "BRK")
+            {
+               add(address, flags, 0x00'00);
+               pending.emplace_back(read_word(0xFF'FE, 0xFF'FF), ENTERED);
+               pending.emplace_back(next, RESUMED);
+               break;
+            }
+
+            add(address, flags, 0x00'00);
+            if (info.mnemonic == "RTS" or info.mnemonic == "RTI" or info.mnemonic == "JAM")
+               break;
+
+            address = next;
+            flags = 0;
+         }
+      }
+   }
+
+   void PredecodeIndex::add(Word const address, Byte const flags, Word const target) noexcept
+   {
+      flags_[address] = flags | INSTRUCTION;
+      lengths_[address] = info(address).length;
+      if (flags & TARGETING)
+      {
+         targets_[address] = target;
+         ++references_[target];
+      }
+
+      watch(address, true);
+      ++instructions_;
+   }
+
+   void PredecodeIndex::remove(Word const address) noexcept
+   {
+      watch(address, false);
+      if (flags_[address] & TARGETING)
+         --references_[targets_[address]];
+
+      flags_[address] = 0;
+      --instructions_;
+      ++invalidations_;
+   }
+
+   void PredecodeIndex::watch(Word const address, bool const watched) noexcept
+   {
+      // byte by byte, as an instruction at the end of memory wraps around to its start
+      for (Byte offset{}; offset < lengths_[address]; ++offset)
+      {
+         auto const byte{ static_cast<Word>(address + offset) };
+         memory_.watch(*watcher_, byte, byte, watched);
+      }
+   }
+
+   void PredecodeIndex::invalidate(Word const first, Word const last) noexcept
+   {
+      // the instructions written to start from up to two bytes before the first address written to, and no longer
+      // watching their bytes takes those from the instructions that overlap them too, which are watched again
+      std::size_t const span{ static_cast<std::size_t>(last - first) + 1 };
+      for (std::size_t offset{}; offset < span + 2; ++offset)
+      {
+         auto const address{ static_cast<Word>(first - 2 + offset) };
+         if (flags_[address] & INSTRUCTION and (offset >= 2 or 2 - offset < lengths_[address]))
+            remove(address);
+      }
+
+      for (std::size_t offset{}; offset < span + 6; ++offset)
+         if (auto const address{ static_cast<Word>(first - 4 + offset) }; flags_[address] & INSTRUCTION)
+            watch(address, true);
+   }
+
+   bool PredecodeIndex::read_cache(std::filesystem::path const& path, Key const& key)
+   {
+      std::ifstream in{ path, std::ios::binary };
+      std::vector<char> const contents{ std::istreambuf_iterator<char>{ in }, std::istreambuf_iterator<char>{} };
+
+      std::size_t position{};
+      auto const read{
+         [&contents, &position](std::size_t const bytes) -> std::optional<std::uint64_t>
+         {
+            if (contents.size() - position < bytes)
+               return std::nullopt;
+
+            std::uint64_t value{};
+            for (std::size_t byte{}; byte < bytes; ++byte)
+               value |= std::uint64_t{ static_cast<Byte>(contents[position++]) } << 8 * byte;
+
+            return value;
+         }
+      };
+
+      if (contents.size() < CACHE_MAGIC.size() or not std::ranges::equal(CACHE_MAGIC,
+         std::span{ contents }.first(CACHE_MAGIC.size())))
+         return false;
+
+      position = CACHE_MAGIC.size();
+      if (read(2) not_eq CACHE_VERSION or read(8) not_eq key.hash or read(4) not_eq key.size
+         or read(2) not_eq key.load_address or read(1) not_eq std::uint64_t{ key.entry_point.has_value() }
+         or read(2) not_eq key.entry_point.value_or(0x00'00))
+         return false;
+
+      std::optional const instructions{ read(4) };
+      if (not instructions)
+         return false;
+
+      for (std::uint64_t instruction{}; instruction < *instructions; ++instruction)
+      {
+         std::optional const address{ read(2) };
+         std::optional const flags{ read(1) };
+         if (not address or not flags or not(*flags & INSTRUCTION)
+            or *flags & ~std::uint64_t{ INSTRUCTION | ENTERED | RESUMED | TARGETING } or flags_[*address] & INSTRUCTION)
+            break;
+
+         std::optional const target{ *flags & TARGETING ? read(2) : std::optional<std::uint64_t>{ 0 } };
+         if (not target)
+            break;
+
+         add(static_cast<Word>(*address), static_cast<Byte>(*flags & ~INSTRUCTION), static_cast<Word>(*target));
+      }
+
+      // a damaged cache file is as good as none
+      if (instructions_ not_eq *instructions or position not_eq contents.size())
+      {
+         clear();
+         return false;
+      }
+
+      return true;
+   }
+
+   void PredecodeIndex::write_cache(std::filesystem::path const& path, Key const& key) const
+   {
+      // the index stays usable without its cache file, for instance next to a program in a read-only directory
+      std::ofstream out{ path, std::ios::binary | std::ios::trunc };
+      auto const write{
+         [&out](std::uint64_t const value, std::size_t const bytes)
+         {
+            for (std::size_t byte{}; byte < bytes; ++byte)
+               out.put(static_cast<char>(value >> 8 * byte));
+         }
+      };
+
+      out.write(CACHE_MAGIC.data(), CACHE_MAGIC.size());
+      write(CACHE_VERSION, 2);
+      write(key.hash, 8);
+      write(key.size, 4);
+      write(key.load_address, 2);
+      write(key.entry_point.has_value(), 1);
+      write(key.entry_point.value_or(0x00'00), 2);
+      write(instructions_, 4);
+
+      for (std::size_t address{}; address < flags_.size(); ++address)
+         if (flags_[address] & INSTRUCTION)
+         {
+            write(address, 2);
+            write(flags_[address], 1);
+            if (flags_[address] & TARGETING)
+               write(targets_[address], 2);
+         }
+   }
+
+   OpcodeInfo const& PredecodeIndex::info(Word const address) const noexcept
+   {
+      return OPCODE_INFOS[memory_.read(address)];
+   }
+
+   Word PredecodeIndex::read_word(Word const low_address, Word const high_address) const noexcept
+   {
+      return static_cast<Word>(memory_.read(high_address) << 8 | memory_.read(low_address));
+   }
+}
\ No newline at end of file
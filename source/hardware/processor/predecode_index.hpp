@@ -0,0 +1,106 @@
+#ifndef PREDECODE_INDEX_HPP
+#define PREDECODE_INDEX_HPP
+
+#include "hardware/memory/memory.hpp"
+#include "hardware/types.hpp"
+#include "opcode_info.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   // Where the instructions of a loaded program start, where its branches, jumps and calls lead and where its basic
+   // blocks begin, found by tracing the code reachable from an entry point (or from the reset, NMI and IRQ vectors).
+   // The index is kept in a cache file next to the program, keyed by the loaded contents, the load address and the
+   // entry point, so a program loaded again is not traced again. A write to indexed code drops exactly the
+   // instructions it touches, which the index then no longer knows anything about. Without a free watcher of the
+   // memory to do that with, the index stays empty.
+   class PredecodeIndex final
+   {
+      public:
+         explicit PredecodeIndex(Memory& memory) noexcept;
+         PredecodeIndex(PredecodeIndex const&) = delete;
+         PredecodeIndex(PredecodeIndex&&) = delete;
+
+         ~PredecodeIndex() noexcept;
+
+         PredecodeIndex& operator=(PredecodeIndex const&) = delete;
+         PredecodeIndex& operator=(PredecodeIndex&&) = delete;
+
+         // loads the program into memory and indexes it, from the cache file when there is a matching one and by
+         // tracing otherwise, in which case the cache file is written for the next time
+         void load_program(std::filesystem::path const& path, Word load_address = 0x0000,
+            std::optional<Word> entry_point = std::nullopt);
+         // indexes what is in memory from the entry point on, adding to what the index already holds
+         void trace(Word entry_point);
+         void clear() noexcept;
+
+         [[nodiscard]] bool instruction(Word address) const noexcept;
+         // An instruction that starts a basic block, as execution can get there other than from the one before it. A
+         // branch or jump to itself, like a trap, does not make one of itself, so it ends the block it is in.
+         [[nodiscard]] bool leader(Word address) const noexcept;
+         [[nodiscard]] bool branch_target(Word address) const noexcept;
+         // where the instruction at the address branches, jumps or calls to, if that is in its operand
+         [[nodiscard]] std::optional<Word> target(Word address) const noexcept;
+
+         [[nodiscard]] std::size_t instructions() const noexcept;
+         [[nodiscard]] std::size_t invalidations() const noexcept;
+         // whether the index of the last program loaded came from its cache file
+         [[nodiscard]] bool from_cache() const noexcept;
+
+         [[nodiscard]] static std::filesystem::path cache_path(std::filesystem::path const& program);
+
+      private:
+         enum Flag : Byte
+         {
+            INSTRUCTION = 0b00'01,
+            // an entry point, or where a pointer in memory leads
+            ENTERED = 0b00'10,
+            // where execution carries on after a branch that is not taken, a subroutine or an interrupt
+            RESUMED = 0b01'00,
+            TARGETING = 0b10'00
+         };
+
+         struct Key final
+         {
+            std::uint64_t hash;
+            std::uint32_t size;
+            Word load_address;
+            std::optional<Word> entry_point;
+         };
+
+         void trace(Word entry_point, Word first, Word last);
+         void add(Word address, Byte flags, Word target) noexcept;
+         void remove(Word address) noexcept;
+         void watch(Word address, bool watched) noexcept;
+         void invalidate(Word first, Word last) noexcept;
+
+         [[nodiscard]] bool read_cache(std::filesystem::path const& path, Key const& key);
+         void write_cache(std::filesystem::path const& path, Key const& key) const;
+
+         [[nodiscard]] OpcodeInfo const& info(Word address) const noexcept;
+         [[nodiscard]] Word read_word(Word low_address, Word high_address) const noexcept;
+
+         // FNV-1a
+         static std::uint64_t constexpr HASH_BASIS{ 0xCB'F2'9C'E4'84'22'23'25 };
+         static std::uint64_t constexpr HASH_PRIME{ 0x00'00'01'00'00'00'01'B3 };
+
+         static std::array<char, 4> constexpr CACHE_MAGIC{ 'F', 'R', 'P', 'I' };
+         static std::uint16_t constexpr CACHE_VERSION{ 1 };
+
+         Memory& memory_;
+         std::optional<Memory::WatcherId> const watcher_;
+
+         std::array<Byte, std::numeric_limits<ProgramCounter>::max() + 1> flags_{};
+         // the lengths of the instructions as they were indexed, which a write to them may change
+         std::array<Byte, std::numeric_limits<ProgramCounter>::max() + 1> lengths_{};
+         std::array<Word, std::numeric_limits<ProgramCounter>::max() + 1> targets_{};
+         // how many indexed instructions branch, jump or call to the address
+         std::array<std::uint16_t, std::numeric_limits<ProgramCounter>::max() + 1> references_{};
+
+         std::size_t instructions_{};
+         std::size_t invalidations_{};
+         bool from_cache_{};
+   };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,27 @@
+#ifndef PREDECODED_INSTRUCTION_HPP
+#define PREDECODED_INSTRUCTION_HPP
+
+#include "hardware/types.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   class Processor;
+
+   // An instruction whose handler is already resolved and whose operand bytes are already fetched
+   struct PredecodedInstruction final
+   {
+      using Handler = void(*)(Processor& processor, Word operand);
+      using FusedHandler = void(*)(Processor& processor, PredecodedInstruction const* instructions);
+
+      Handler handler;
+      Word operand;
+      Byte opcode;
+      Byte length;
+      // set on the first instruction of a sequence that can run as one, along with the instructions in the sequence
+      FusedHandler fused_handler;
+      Byte fused_count;
+   };
+}
+
+#endif
\ No newline at end of file
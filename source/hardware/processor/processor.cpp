@@ -1,32 +1,76 @@
 #include "processor.hpp"
-#include "exceptions/unsupported_opcode.hpp"
+#include "opcode_info.hpp"
+#include "profiler.hpp"
+#include "utility/runtime_assert.hpp"
 
 namespace nes
 {
-   Processor::Processor(Memory& memory) noexcept
+   Processor::Processor(Memory& memory, Core const core) noexcept
       : memory_{ memory }
    {
+      bool const changed{ change_core(core) };
+      runtime_assert(changed, "the memory has no free watcher for the core, which leaves the processor cycle stepped");
    }
 
-   bool Processor::tick()
+   std::expected<bool, HaltReason> Processor::tick()
    {
-      ++cycle_;
+      // a single tick is observed on its own, so coroutine instructions suspend at every cycle boundary
+      cycle_limit_ = {};
+      if (frozen())
+      {
+         ++cycle_;
+         return std::unexpected{ *halt_reason_ };
+      }
+
+      bool const completed{ tick_core() };
+      if (frozen())
+         return std::unexpected{ *halt_reason_ };
 
-      bool instruction_completed;
-      if (not current_instruction_)
+      return completed;
+   }
+
+   std::expected<Cycle, HaltReason> Processor::run(Cycle const budget)
+   {
+      Cycle const start{ cycle_ };
+      // saturates, as run_until's budget defaults to every cycle there is
+      cycle_limit_ = start + std::min(budget, std::numeric_limits<Cycle>::max() - start);
+      if (frozen())
       {
-         current_opcode_ = static_cast<Opcode>(memory_.read(program_counter));
-         ++program_counter;
-         current_instruction_ = instruction_from_opcode(current_opcode_);
-         instruction_completed = false;
+         cycle_ = cycle_limit_;
+         return std::unexpected{ *halt_reason_ };
       }
-      else if (instruction_completed = current_instruction_->tick(); instruction_completed)
+
+      // a trap is found again if the run still starts in it
+      halt_reason_.reset();
+      bool stopped{};
+      while (not stopped and microcode_state_.in_flight and cycle_ < cycle_limit_)
+         stopped = tick_microcoded() and stop_requested();
+
+      if (core_ == Core::CYCLE_STEPPED)
+         while (not stopped and cycle_ < cycle_limit_)
+            stopped = tick_cycle() and stop_requested();
+      else
       {
-         std::optional prefetched_instruction{ current_instruction_->prefetched_instruction() };
-         current_instruction_ = std::move(prefetched_instruction);
+         while (not stopped and current_instruction_ and cycle_ < cycle_limit_)
+            stopped = tick_cycle() and stop_requested();
+
+         if (core_ == Core::MICROCODED)
+            while (not stopped and cycle_ < cycle_limit_)
+               stopped = tick_microcoded() and stop_requested();
+         else if (core_ == Core::INSTRUCTION_STEPPED)
+            while (not stopped and cycle_ < cycle_limit_)
+            {
+               step();
+               stopped = stop_requested();
+            }
+         else if (not stopped and cycle_ < cycle_limit_)
+            run_predecoded(cycle_limit_ - cycle_);
       }
 
-      return instruction_completed;
+      if (halt_reason_)
+         return std::unexpected{ *halt_reason_ };
+
+      return cycle_ - start;
    }
 
    void Processor::reset() noexcept
@@ -34,6 +78,108 @@ namespace nes
       cycle_ = 0;
       current_opcode_ = {};
       current_instruction_ = RST();
+      microcode_state_ = {};
+      halt_reason_.reset();
+      verification_.reset();
+   }
+
+   bool Processor::CycleBoundary::await_ready() const noexcept
+   {
+      if (processor.cycle_ >= processor.cycle_limit_)
+         return false;
+
+      ++processor.cycle_;
+      return true;
+   }
+
+   void Processor::CycleBoundary::await_suspend(std::coroutine_handle<>) noexcept
+   {
+   }
+
+   void Processor::CycleBoundary::await_resume() noexcept
+   {
+   }
+
+   bool Processor::tick_core()
+   {
+      // an instruction that is still in flight (the reset sequence, or one prefetched by a branch) is finished
+      // cycle by cycle by the core that started it; the other cores only take over at a clean instruction boundary
+      if (microcode_state_.in_flight or (core_ == Core::MICROCODED and not current_instruction_))
+         return tick_microcoded();
+
+      if (core_ == Core::INSTRUCTION_STEPPED and not current_instruction_)
+      {
+         step();
+         return true;
+      }
+
+      if ((core_ == Core::PREDECODED or core_ == Core::RECOMPILED) and not current_instruction_)
+      {
+         run_predecoded(1);
+         return true;
+      }
+
+      return tick_cycle();
+   }
+
+   bool Processor::tick_cycle()
+   {
+      if (not current_instruction_ and hooks_ and run_hook())
+         return true;
+
+      ++cycle_;
+
+      // a finishing branch leaves the instruction it prefetched in place of itself
+      if (current_instruction_)
+         return current_instruction_.tick();
+
+      auto const opcode{ static_cast<Opcode>(memory_.read(program_counter)) };
+      ++program_counter;
+      current_instruction_ = instruction_from_opcode(opcode);
+      return false;
+   }
+
+   bool Processor::change_core(Core const core) noexcept
+   {
+      if (core == Core::PREDECODED or core == Core::RECOMPILED)
+      {
+         if (not block_cache_.enable())
+            return false;
+      }
+      else
+         block_cache_.disable();
+
+      if (core == Core::RECOMPILED)
+         recompiler_.map_code_buffer();
+
+      core_ = core;
+      return true;
+   }
+
+   void Processor::attach(Profiler* const profiler) noexcept
+   {
+      profiler_ = profiler;
+   }
+
+   void Processor::install(HookRegistry* const hooks) noexcept
+   {
+      hooks_ = hooks;
+      verification_.reset();
+   }
+
+   void Processor::set_fusion(bool const fusion) noexcept
+   {
+      fusion_ = fusion;
+   }
+
+   void Processor::set_static_translation(StaticTranslation* const translation) noexcept
+   {
+      static_translation_ = translation;
+   }
+
+   Processor::Core Processor::core() const noexcept
+   {
+      return core_;
    }
 
    Cycle Processor::cycle() const noexcept
@@ -63,532 +209,587 @@ namespace nes
 
    ProcessorStatus Processor::processor_status() const noexcept
    {
-      return processor_status_;
+      if (not zero_and_negative_pending_)
+         return processor_status_;
+
+      auto const n{ static_cast<std::underlying_type_t<ProcessorStatusFlag>>(ProcessorStatusFlag::N) };
+      auto const z{ static_cast<std::underlying_type_t<ProcessorStatusFlag>>(ProcessorStatusFlag::Z) };
+      return static_cast<ProcessorStatus>((processor_status_ & ~(n | z)) | (zero_and_negative_source_ & n) |
+         (zero_and_negative_source_ ? 0 : z));
+   }
+
+   std::size_t Processor::heap_allocations() const noexcept
+   {
+      return frame_pool_.heap_allocations();
+   }
+
+   std::size_t Processor::elided_reads() const noexcept
+   {
+      return elided_reads_;
+   }
+
+   std::size_t Processor::fusions() const noexcept
+   {
+      return fusions_;
+   }
+
+   BlockCache const& Processor::block_cache() const noexcept
+   {
+      return block_cache_;
+   }
+
+   Recompiler const& Processor::recompiler() const noexcept
+   {
+      return recompiler_;
    }
 
-   Instruction Processor::relative(BranchOperation const operation)
+   std::optional<HaltReason> const& Processor::halt_reason() const noexcept
+   {
+      return halt_reason_;
+   }
+
+   template <Processor::BranchOperation OPERATION>
+   Instruction Processor::relative()
    {
       // fetch operand, increment PC
       auto const operand{ static_cast<SignedByte>(memory_.read(program_counter)) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
-      // fetch opcode of next instruction, if branch is taken, add operand to PCL, otherwise increment PC
-      Byte next_opcode{ memory_.read(program_counter) };
-      if (std::invoke(operation, this))
+      // fetch opcode of next instruction, if branch is taken, add operand to PCL (and throw the opcode away),
+      // otherwise increment PC
+      if (std::invoke(OPERATION, this))
       {
+         dummy_read(program_counter);
          auto const [program_counter_low, overflow]{ add_with_overflow(low_byte(program_counter), operand) };
          program_counter = assign_low_byte(program_counter, program_counter_low);
-         co_await std::suspend_always{};
+         co_await CycleBoundary{ *this };
 
-         // fetch opcode of next instruction, fix PCH, if it did not change, increment PC (+)
-         next_opcode = memory_.read(program_counter);
+         // fetch opcode of next instruction, fix PCH (and throw the opcode away) (+)
          if (overflow)
          {
+            dummy_read(program_counter);
             auto const program_counter_high{ static_cast<Byte>(high_byte(program_counter) + overflow) };
             program_counter = assign_high_byte(program_counter, program_counter_high);
-            co_await std::suspend_always{};
-
-            // fetch opcode of next instruction, increment PC (!)
-            next_opcode = memory_.read(program_counter);
+            co_await CycleBoundary{ *this };
          }
       }
 
+      // fetch opcode of next instruction, increment PC
+      Byte const next_opcode{ memory_.read(program_counter) };
       ++program_counter;
       co_return instruction_from_opcode(static_cast<Opcode>(next_opcode));
    }
 
-   Instruction Processor::immediate(ReadOperation const operation) noexcept
+   template <Processor::ReadOperation OPERATION>
+   Instruction Processor::immediate() noexcept
    {
       // fetch value, increment PC
       Byte const value{ memory_.read(program_counter) };
       ++program_counter;
 
-      std::invoke(operation, this, value);
+      std::invoke(OPERATION, this, value);
       co_return std::nullopt;
    }
 
-   Instruction Processor::absolute(ReadOperation const operation) noexcept
+   template <Processor::ReadOperation OPERATION>
+   Instruction Processor::absolute() noexcept
    {
       // fetch low byte of address, increment PC
       Byte const low_byte_of_address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch high byte of address, increment PC
       Byte const high_byte_of_address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // read from effective address
       Word const effective_address{ assemble_word(high_byte_of_address, low_byte_of_address) };
       Byte const value{ memory_.read(effective_address) };
 
-      std::invoke(operation, this, value);
+      std::invoke(OPERATION, this, value);
       co_return std::nullopt;
    }
 
-   Instruction Processor::zero_page(ReadOperation const operation) noexcept
+   template <Processor::ReadOperation OPERATION>
+   Instruction Processor::zero_page() noexcept
    {
       // fetch address, increment PC
       Word const address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // read from effective address
       Byte const value{ memory_.read(address) };
 
-      std::invoke(operation, this, value);
+      std::invoke(OPERATION, this, value);
       co_return std::nullopt;
    }
 
-   Instruction Processor::zero_page_indexed(ReadOperation const operation, Index const index) noexcept
+   template <Processor::ReadOperation OPERATION, Index Processor::* INDEX>
+   Instruction Processor::zero_page_indexed() noexcept
    {
       // fetch address, increment PC
       Byte address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // read from address, add index register to it
-      std::ignore = memory_.read(address); // ???
-      address += index;
-      co_await std::suspend_always{};
+      dummy_read(address); // ???
+      address += this->*INDEX;
+      co_await CycleBoundary{ *this };
 
       // read from effective address
       Byte const value{ memory_.read(address) };
 
-      std::invoke(operation, this, value);
+      std::invoke(OPERATION, this, value);
       co_return std::nullopt;
    }
 
-   Instruction Processor::absolute_indexed(ReadOperation const operation, Index const index) noexcept
+   template <Processor::ReadOperation OPERATION, Index Processor::* INDEX>
+   Instruction Processor::absolute_indexed() noexcept
    {
       // fetch low byte of address, increment PC
       Byte const low_byte_of_address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch high byte of address, add index register to low address byte, increment PC
       Byte high_byte_of_address{ memory_.read(program_counter) };
-      auto const [low_byte, overflow]{ add_with_overflow(low_byte_of_address, index) };
+      auto const [low_byte, overflow]{ add_with_overflow(low_byte_of_address, this->*INDEX) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // read from effective address, fix the high byte of effective address
       Word effective_address{ assemble_word(high_byte_of_address, low_byte) };
-      Byte value{ memory_.read(effective_address) };
       if (overflow)
       {
+         dummy_read(effective_address);
          ++high_byte_of_address;
-         co_await std::suspend_always{};
+         co_await CycleBoundary{ *this };
 
          // re-read from effective address (+)
          effective_address = assign_high_byte(effective_address, high_byte_of_address);
-         value = memory_.read(effective_address);
       }
 
-      std::invoke(operation, this, value);
+      std::invoke(OPERATION, this, memory_.read(effective_address));
       co_return std::nullopt;
    }
 
-   Instruction Processor::x_indirect(ReadOperation const operation) noexcept
+   template <Processor::ReadOperation OPERATION>
+   Instruction Processor::x_indirect() noexcept
    {
       // fetch pointer address, increment PC
       Byte pointer_address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // read from the address, add X to it
-      std::ignore = memory_.read(pointer_address); // ???
+      dummy_read(pointer_address); // ???
       pointer_address += x_;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch effective address low
       Byte const effective_address_low{ memory_.read(pointer_address) };
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch effective address high
       ++pointer_address;
       Byte const effective_address_high{ memory_.read(pointer_address) };
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // read from effective address
       Word const effective_address{ assemble_word(effective_address_high, effective_address_low) };
       auto const value{ memory_.read(effective_address) };
 
-      std::invoke(operation, this, value);
+      std::invoke(OPERATION, this, value);
       co_return std::nullopt;
    }
 
-   Instruction Processor::indirect_y(ReadOperation const operation) noexcept
+   template <Processor::ReadOperation OPERATION>
+   Instruction Processor::indirect_y() noexcept
    {
       // fetch pointer address, increment PC
       Byte pointer_address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch effective address low
       Byte const effective_address_low{ memory_.read(pointer_address) };
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch effective address high, add Y to low byte of effective address
       ++pointer_address;
       Byte effective_address_high{ memory_.read(pointer_address) };
       auto const [low_byte, overflow]{ add_with_overflow(effective_address_low, y_) };
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // read from effective address, fix high byte of effective address
       Word effective_address{ assemble_word(effective_address_high, low_byte) };
-      Byte value{ memory_.read(effective_address) };
       if (overflow)
       {
+         dummy_read(effective_address);
          ++effective_address_high;
-         co_await std::suspend_always{};
+         co_await CycleBoundary{ *this };
 
          // read from effective address (+)
          effective_address = assign_high_byte(effective_address, effective_address_high);
-         value = memory_.read(effective_address);
       }
 
-      std::invoke(operation, this, value);
+      std::invoke(OPERATION, this, memory_.read(effective_address));
       co_return std::nullopt;
    }
 
-   Instruction Processor::accumulator(ModifyOperation const operation) noexcept
+   template <Processor::ModifyOperation OPERATION>
+   Instruction Processor::accumulator() noexcept
    {
       // do the operation on the accumulator
-      accumulator_ = std::invoke(operation, this, accumulator_);
+      accumulator_ = std::invoke(OPERATION, this, accumulator_);
       co_return std::nullopt;
    }
 
-   Instruction Processor::absolute(ModifyOperation const operation) noexcept
+   template <Processor::ModifyOperation OPERATION>
+   Instruction Processor::absolute() noexcept
    {
       // fetch low byte of address, increment PC
       Byte const low_byte_of_address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch high byte of address, increment PC
       Byte const high_byte_of_address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // read from effective address
       Word const effective_address{ assemble_word(high_byte_of_address, low_byte_of_address) };
       Byte value{ memory_.read(effective_address) };
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // write the value back to effective address, and do the operation on it
       memory_.write(effective_address, value);
-      value = std::invoke(operation, this, value);
-      co_await std::suspend_always{};
+      value = std::invoke(OPERATION, this, value);
+      co_await CycleBoundary{ *this };
 
       // write the new value to effective address
       memory_.write(effective_address, value);
       co_return std::nullopt;
    }
 
-   Instruction Processor::zero_page(ModifyOperation const operation) noexcept
+   template <Processor::ModifyOperation OPERATION>
+   Instruction Processor::zero_page() noexcept
    {
       // fetch address, increment PC
       Word const address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // read from effective address
       Byte value{ memory_.read(address) };
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // write the value back to effective address, and do the operation on it
       memory_.write(address, value);
-      value = std::invoke(operation, this, value);
-      co_await std::suspend_always{};
+      value = std::invoke(OPERATION, this, value);
+      co_await CycleBoundary{ *this };
 
       // write the new value to effective address
       memory_.write(address, value);
       co_return std::nullopt;
    }
 
-   Instruction Processor::zero_page_indexed(ModifyOperation const operation, Index const index) noexcept
+   template <Processor::ModifyOperation OPERATION, Index Processor::* INDEX>
+   Instruction Processor::zero_page_indexed() noexcept
    {
       // fetch address, increment PC
       Byte address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // read from address, add index register to it
-      std::ignore = memory_.read(address); // ???
-      address += index;
-      co_await std::suspend_always{};
+      dummy_read(address); // ???
+      address += this->*INDEX;
+      co_await CycleBoundary{ *this };
 
       // read from effective address
       Byte value{ memory_.read(address) };
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // write the value back to effective address, and do the operation on it
       memory_.write(address, value);
-      value = std::invoke(operation, this, value);
-      co_await std::suspend_always{};
+      value = std::invoke(OPERATION, this, value);
+      co_await CycleBoundary{ *this };
 
       // write the new value to effective address
       memory_.write(address, value);
       co_return std::nullopt;
    }
 
-   Instruction Processor::absolute_indexed(ModifyOperation const operation, Index const index) noexcept
+   template <Processor::ModifyOperation OPERATION, Index Processor::* INDEX>
+   Instruction Processor::absolute_indexed() noexcept
    {
       // fetch low byte of address, increment PC
       Byte const low_byte_of_address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch high byte of address, add index register to low address byte, increment PC
       Byte high_byte_of_address{ memory_.read(program_counter) };
-      auto const [low_byte, overflow]{ add_with_overflow(low_byte_of_address, index) };
+      auto const [low_byte, overflow]{ add_with_overflow(low_byte_of_address, this->*INDEX) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // read from effective address, fix the high byte of effective address
       Word effective_address{ assemble_word(high_byte_of_address, low_byte) };
-      Byte value{ memory_.read(effective_address) };
+      dummy_read(effective_address);
       high_byte_of_address += overflow;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // re-read from effective address
       effective_address = assign_high_byte(effective_address, high_byte_of_address);
-      value = memory_.read(effective_address);
-      co_await std::suspend_always{};
+      Byte value{ memory_.read(effective_address) };
+      co_await CycleBoundary{ *this };
 
       // write the value back to effective address, and do the operation on it
       memory_.write(effective_address, value);
-      value = std::invoke(operation, this, value);
-      co_await std::suspend_always{};
+      value = std::invoke(OPERATION, this, value);
+      co_await CycleBoundary{ *this };
 
       // write the new value to effective address
       memory_.write(effective_address, value);
       co_return std::nullopt;
    }
 
-   Instruction Processor::x_indirect(ModifyOperation const operation) noexcept
+   template <Processor::ModifyOperation OPERATION>
+   Instruction Processor::x_indirect() noexcept
    {
       // fetch pointer address, increment PC
       Byte pointer_address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // read from the address, add X to it
-      std::ignore = memory_.read(pointer_address); // ???
+      dummy_read(pointer_address); // ???
       pointer_address += x_;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch effective address low
       Byte const effective_address_low{ memory_.read(pointer_address) };
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch effective address high
       ++pointer_address;
       Byte const effective_address_high{ memory_.read(pointer_address) };
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // read from effective address
       Word const effective_address{ assemble_word(effective_address_high, effective_address_low) };
       auto value{ memory_.read(effective_address) };
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // write the value back to effective address, and do the operation on it
       memory_.write(effective_address, value);
-      value = std::invoke(operation, this, value);
-      co_await std::suspend_always{};
+      value = std::invoke(OPERATION, this, value);
+      co_await CycleBoundary{ *this };
 
       // write the new value to effective address
       memory_.write(effective_address, value);
       co_return std::nullopt;
    }
 
-   Instruction Processor::indirect_y(ModifyOperation const operation) noexcept
+   template <Processor::ModifyOperation OPERATION>
+   Instruction Processor::indirect_y() noexcept
    {
       // fetch pointer address, increment PC
       Byte pointer_address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch effective address low
       Byte const effective_address_low{ memory_.read(pointer_address) };
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch effective address high, add Y to low byte of effective address
       ++pointer_address;
       Byte effective_address_high{ memory_.read(pointer_address) };
       auto const [low_byte, overflow]{ add_with_overflow(effective_address_low, y_) };
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // read from effective address, fix high byte of effective address
       Word effective_address{ assemble_word(effective_address_high, low_byte) };
-      Byte value{ memory_.read(effective_address) };
+      dummy_read(effective_address);
       effective_address_high += overflow;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // read from effective address
       effective_address = assign_high_byte(effective_address, effective_address_high);
-      value = memory_.read(effective_address);
-      co_await std::suspend_always{};
+      Byte value{ memory_.read(effective_address) };
+      co_await CycleBoundary{ *this };
 
       // write the value back to effective address, and do the operation on it
       memory_.write(effective_address, value);
-      value = std::invoke(operation, this, value);
-      co_await std::suspend_always{};
+      value = std::invoke(OPERATION, this, value);
+      co_await CycleBoundary{ *this };
 
       // write the new value to effective address
       memory_.write(effective_address, value);
       co_return std::nullopt;
    }
 
-   Instruction Processor::absolute(WriteOperation const operation) noexcept
+   template <Processor::WriteOperation OPERATION>
+   Instruction Processor::absolute() noexcept
    {
       // fetch low byte of address, increment PC
       Byte const low_byte_of_address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch high byte of address, increment PC
       Byte const high_byte_of_address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // write register to effective address
       Word const effective_address{ assemble_word(high_byte_of_address, low_byte_of_address) };
-      memory_.write(effective_address, std::invoke(operation, this));
+      memory_.write(effective_address, std::invoke(OPERATION, this));
       co_return std::nullopt;
    }
 
-   Instruction Processor::zero_page(WriteOperation const operation) noexcept
+   template <Processor::WriteOperation OPERATION>
+   Instruction Processor::zero_page() noexcept
    {
       // fetch address, increment PC
       Word const address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // write register to effective address
-      memory_.write(address, std::invoke(operation, this));
+      memory_.write(address, std::invoke(OPERATION, this));
       co_return std::nullopt;
    }
 
-   Instruction Processor::zero_page_indexed(WriteOperation const operation, Index const index) noexcept
+   template <Processor::WriteOperation OPERATION, Index Processor::* INDEX>
+   Instruction Processor::zero_page_indexed() noexcept
    {
       // fetch address, increment PC
       Byte address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // read from address, add index register to it
-      std::ignore = memory_.read(address); // ???
-      address += index;
-      co_await std::suspend_always{};
+      dummy_read(address); // ???
+      address += this->*INDEX;
+      co_await CycleBoundary{ *this };
 
       // write to effective address
-      memory_.write(address, std::invoke(operation, this));
+      memory_.write(address, std::invoke(OPERATION, this));
       co_return std::nullopt;
    }
 
-   Instruction Processor::absolute_indexed(WriteOperation const operation, Index const index) noexcept
+   template <Processor::WriteOperation OPERATION, Index Processor::* INDEX>
+   Instruction Processor::absolute_indexed() noexcept
    {
       // fetch low byte of address, increment PC
       Byte const low_byte_of_address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch high byte of address, add index register to low address byte, increment PC
       Byte high_byte_of_address{ memory_.read(program_counter) };
-      auto const [low_byte, overflow]{ add_with_overflow(low_byte_of_address, index) };
+      auto const [low_byte, overflow]{ add_with_overflow(low_byte_of_address, this->*INDEX) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // read from effective address, fix the high byte of effective address
       Word effective_address{ assemble_word(high_byte_of_address, low_byte) };
-      std::ignore = memory_.read(effective_address);
+      dummy_read(effective_address);
       high_byte_of_address += overflow;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // write to effective address
       effective_address = assign_high_byte(effective_address, high_byte_of_address);
-      memory_.write(effective_address, std::invoke(operation, this));
+      memory_.write(effective_address, std::invoke(OPERATION, this));
       co_return std::nullopt;
    }
 
-   Instruction Processor::x_indirect(WriteOperation const operation) noexcept
+   template <Processor::WriteOperation OPERATION>
+   Instruction Processor::x_indirect() noexcept
    {
       // fetch pointer address, increment PC
       Byte pointer_address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // read from the address, add X to it
-      std::ignore = memory_.read(pointer_address); // ???
+      dummy_read(pointer_address); // ???
       pointer_address += x_;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch effective address low
       Byte const effective_address_low{ memory_.read(pointer_address) };
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch effective address high
       ++pointer_address;
       Byte const effective_address_high{ memory_.read(pointer_address) };
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // write to effective address
       Word const effective_address{ assemble_word(effective_address_high, effective_address_low) };
-      memory_.write(effective_address, std::invoke(operation, this));
+      memory_.write(effective_address, std::invoke(OPERATION, this));
       co_return std::nullopt;
    }
 
-   Instruction Processor::indirect_y(WriteOperation const operation) noexcept
+   template <Processor::WriteOperation OPERATION>
+   Instruction Processor::indirect_y() noexcept
    {
       // fetch pointer address, increment PC
       Byte pointer_address{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch effective address low
       Byte const effective_address_low{ memory_.read(pointer_address) };
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch effective address high, add Y to low byte of effective address
       ++pointer_address;
       Byte effective_address_high{ memory_.read(pointer_address) };
       auto const [low_byte, overflow]{ add_with_overflow(effective_address_low, y_) };
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // read from effective address, fix high byte of effective address
       Word effective_address{ assemble_word(effective_address_high, low_byte) };
-      std::ignore = memory_.read(effective_address);
+      dummy_read(effective_address);
       effective_address_high += overflow;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // write to effective address
       effective_address = assign_high_byte(effective_address, effective_address_high);
-      memory_.write(effective_address, std::invoke(operation, this));
+      memory_.write(effective_address, std::invoke(OPERATION, this));
       co_return std::nullopt;
    }
 
    // TODO: find what exactly happens here
    Instruction Processor::RST() noexcept
    {
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       --stack_pointer_;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       --stack_pointer_;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       --stack_pointer_;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       program_counter = assign_low_byte(program_counter, memory_.read(RESET_LOW));
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       program_counter = assign_high_byte(program_counter, memory_.read(RESET_HIGH));
       co_return std::nullopt;
@@ -597,29 +798,30 @@ namespace nes
    Instruction Processor::BRK() noexcept
    {
       // read next instruction byte (and throw it away), increment PC
-      std::ignore = memory_.read(program_counter);
+      dummy_read(program_counter);
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // push PCH on stack (with B flag set), decrement S
       change_processor_status_flag(ProcessorStatusFlag::B, true);
       write_to_stack(high_byte(program_counter));
       --stack_pointer_;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // push PCL on stack, decrement S
       write_to_stack(low_byte(program_counter));
       --stack_pointer_;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // push P on stack, decrement S
+      resolve_processor_status();
       write_to_stack(processor_status_);
       --stack_pointer_;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch PCL
       program_counter = assign_low_byte(program_counter, memory_.read(IRQ_LOW));
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch PCH
       program_counter = assign_high_byte(program_counter, memory_.read(IRQ_HIGH));
@@ -632,12 +834,13 @@ namespace nes
    Instruction Processor::PHP() noexcept
    {
       // read next instruction byte (and throw it away)
-      std::ignore = memory_.read(program_counter);
-      co_await std::suspend_always{};
+      dummy_read(program_counter);
+      co_await CycleBoundary{ *this };
 
       // push register on stack (with B and _ flag set), decrement S
       change_processor_status_flag(ProcessorStatusFlag::B, true);
       change_processor_status_flag(ProcessorStatusFlag::_, true);
+      resolve_processor_status();
       write_to_stack(processor_status_);
       --stack_pointer_;
       co_return std::nullopt;
@@ -654,21 +857,21 @@ namespace nes
       // fetch low address byte, increment PC
       Byte const low_address_byte{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // internal operation (pre-decrement S?)
       // --stack_pointer_;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // push PCH on stack, decrement S
       write_to_stack(high_byte(program_counter));
       --stack_pointer_;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // push PCL on stack, decrement S
       write_to_stack(low_byte(program_counter));
       --stack_pointer_;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // copy low address byte to PCL, fetch high address byte to PCH
       program_counter = assemble_word(memory_.read(program_counter), low_address_byte);
@@ -678,15 +881,15 @@ namespace nes
    Instruction Processor::PLP() noexcept
    {
       // read next instruction byte (and throw it away)
-      std::ignore = memory_.read(program_counter);
-      co_await std::suspend_always{};
+      dummy_read(program_counter);
+      co_await CycleBoundary{ *this };
 
       // increment S
       ++stack_pointer_;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // pull register from stack (with B and _ flag ignored)
-      processor_status_ = (processor_status_ & 0b00'11'00'00) | read_from_stack(); // TODO: make this cleaner
+      pull_processor_status();
       co_return std::nullopt;
    }
 
@@ -700,22 +903,22 @@ namespace nes
    Instruction Processor::RTI() noexcept
    {
       // read next instruction byte (and throw it away)
-      std::ignore = memory_.read(program_counter);
-      co_await std::suspend_always{};
+      dummy_read(program_counter);
+      co_await CycleBoundary{ *this };
 
       // increment S
       ++stack_pointer_;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // pull P from stack, increment S
-      processor_status_ = (processor_status_ & 0b00'11'00'00) | read_from_stack(); // TODO: make this cleaner
+      pull_processor_status();
       ++stack_pointer_;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // pull PCL from stack, increment S
       program_counter = assign_low_byte(program_counter, read_from_stack());
       ++stack_pointer_;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // pull PCH from stack
       program_counter = assign_high_byte(program_counter, read_from_stack());
@@ -725,8 +928,8 @@ namespace nes
    Instruction Processor::PHA() noexcept
    {
       // read next instruction byte (and throw it away)
-      std::ignore = memory_.read(program_counter);
-      co_await std::suspend_always{};
+      dummy_read(program_counter);
+      co_await CycleBoundary{ *this };
 
       // push register on stack, decrement S
       write_to_stack(accumulator_);
@@ -739,7 +942,7 @@ namespace nes
       // fetch low address byte, increment PC
       Byte const low_address_byte{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // copy low address byte to PCL, fetch high address byte to PCH
       program_counter = assemble_word(memory_.read(program_counter), low_address_byte);
@@ -756,21 +959,21 @@ namespace nes
    Instruction Processor::RTS() noexcept
    {
       // read next instruction byte (and throw it away)
-      std::ignore = memory_.read(program_counter);
-      co_await std::suspend_always{};
+      dummy_read(program_counter);
+      co_await CycleBoundary{ *this };
 
       // increment S
       ++stack_pointer_;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // pull PCL from stack, increment S
       program_counter = assign_low_byte(program_counter, read_from_stack());
       ++stack_pointer_;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // pull PCH from stack
       program_counter = assign_high_byte(program_counter, read_from_stack());
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // increment PC
       ++program_counter;
@@ -780,12 +983,12 @@ namespace nes
    Instruction Processor::PLA() noexcept
    {
       // read next instruction byte (and throw it away)
-      std::ignore = memory_.read(program_counter);
-      co_await std::suspend_always{};
+      dummy_read(program_counter);
+      co_await CycleBoundary{ *this };
 
       // increment S
       ++stack_pointer_;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // pull register from stack
       update_zero_and_negative_flag(accumulator_ = read_from_stack());
@@ -795,24 +998,22 @@ namespace nes
    Instruction Processor::JMP_indirect() noexcept
    {
       // fetch pointer address low, increment PC
-      Byte pointer_address_low{ memory_.read(program_counter) };
+      Byte const pointer_address_low{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch pointer address high, increment PC
       Byte const pointer_address_high{ memory_.read(program_counter) };
       ++program_counter;
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch low address to latch
-      Word pointer_address{ assemble_word(pointer_address_high, pointer_address_low) };
+      Word const pointer_address{ assemble_word(pointer_address_high, pointer_address_low) };
       Byte const low_address{ memory_.read(pointer_address) };
-      co_await std::suspend_always{};
+      co_await CycleBoundary{ *this };
 
       // fetch PCH, copy latch to PCL
-      ++pointer_address_low;
-      pointer_address = assign_low_byte(pointer_address, pointer_address_low);
-      program_counter = assemble_word(memory_.read(pointer_address), low_address);
+      program_counter = assemble_word(memory_.read(indirect_jump_high_address(pointer_address)), low_address);
       co_return std::nullopt;
    }
 
@@ -919,6 +1120,12 @@ namespace nes
       co_return std::nullopt;
    }
 
+   Instruction Processor::unsupported() noexcept
+   {
+      freeze();
+      return {};
+   }
+
    bool Processor::BPL() const noexcept
    {
       return not processor_status_flag(ProcessorStatusFlag::N);
@@ -997,17 +1204,11 @@ namespace nes
 
    void Processor::ADC(Byte const value) noexcept
    {
-      // perform addition
-      auto const result{ accumulator_ + value + processor_status_flag(ProcessorStatusFlag::C) };
+      if constexpr (Variant::DECIMAL_MODE)
+         if (processor_status_flag(ProcessorStatusFlag::D))
+            return add_decimal(value);
 
-      // set C if there was a carry-out
-      change_processor_status_flag(ProcessorStatusFlag::C, result > 0xFF);
-
-      // set V if there was a signed overflow
-      change_processor_status_flag(ProcessorStatusFlag::V, (accumulator_ ^ result) & (value ^ result) & 0x80);
-
-      // store result in accumulator
-      update_zero_and_negative_flag(accumulator_ = static_cast<Byte>(result));
+      apply_binary(add_binary(accumulator_, value, processor_status_flag(ProcessorStatusFlag::C)));
    }
 
    void Processor::LDY(Byte const value) noexcept
@@ -1024,81 +1225,46 @@ namespace nes
 
    void Processor::CPY(Byte const value) noexcept
    {
-      change_processor_status_flag(ProcessorStatusFlag::C, y_ >= value);
-      update_zero_and_negative_flag(y_ - value);
+      std::ignore = apply_carry(compare_binary(y_, value));
    }
 
    void Processor::CMP(Byte const value) noexcept
    {
-      change_processor_status_flag(ProcessorStatusFlag::C, accumulator_ >= value);
-      update_zero_and_negative_flag(accumulator_ - value);
+      std::ignore = apply_carry(compare_binary(accumulator_, value));
    }
 
    void Processor::CPX(Byte const value) noexcept
    {
-      change_processor_status_flag(ProcessorStatusFlag::C, x_ >= value);
-      update_zero_and_negative_flag(x_ - value);
+      std::ignore = apply_carry(compare_binary(x_, value));
    }
 
    void Processor::SBC(Byte const value) noexcept
    {
-      // perform subtraction
-      auto const result{ accumulator_ - value - not processor_status_flag(ProcessorStatusFlag::C) };
-
-      // set C if there was no borrow
-      change_processor_status_flag(ProcessorStatusFlag::C, result >= 0);
+      if constexpr (Variant::DECIMAL_MODE)
+         if (processor_status_flag(ProcessorStatusFlag::D))
+            return subtract_decimal(value);
 
-      // set V if there was a signed overflow
-      change_processor_status_flag(ProcessorStatusFlag::V, (accumulator_ ^ value) & (accumulator_ ^ result) & 0x80);
-
-      // store result in accumulator
-      update_zero_and_negative_flag(accumulator_ = static_cast<Byte>(result));
+      apply_binary(subtract_binary(accumulator_, value, processor_status_flag(ProcessorStatusFlag::C)));
    }
 
-   Byte Processor::ASL(Byte value) noexcept
+   Byte Processor::ASL(Byte const value) noexcept
    {
-      // C set to bit 7 of value before ASL
-      change_processor_status_flag(ProcessorStatusFlag::C, value & 0x80);
-
-      // shift value left by 1
-      update_zero_and_negative_flag(value <<= 1);
-      return value;
+      return apply_carry(shift_left(value, false));
    }
 
-   Byte Processor::ROL(Byte value) noexcept
+   Byte Processor::ROL(Byte const value) noexcept
    {
-      // save old C
-      Byte const old_carry{ processor_status_flag(ProcessorStatusFlag::C) };
-
-      // C set to bit 7 of value before ROL
-      change_processor_status_flag(ProcessorStatusFlag::C, value & 0b10'00'00'00);
-
-      // shift value left by 1, set bit 0 to old C
-      update_zero_and_negative_flag(value = value << 1 | old_carry);
-      return value;
+      return apply_carry(shift_left(value, processor_status_flag(ProcessorStatusFlag::C)));
    }
 
-   Byte Processor::LSR(Byte value) noexcept
+   Byte Processor::LSR(Byte const value) noexcept
    {
-      // C set to bit 0 of value before LSR
-      change_processor_status_flag(ProcessorStatusFlag::C, value & 0b00'00'00'01);
-
-      // shift value right by 1
-      update_zero_and_negative_flag(value >>= 1);
-      return value;
+      return apply_carry(shift_right(value, false));
    }
 
-   Byte Processor::ROR(Byte value) noexcept
+   Byte Processor::ROR(Byte const value) noexcept
    {
-      // save old C
-      Byte const old_carry{ processor_status_flag(ProcessorStatusFlag::C) };
-
-      // C set to bit 0 of value before ROR
-      change_processor_status_flag(ProcessorStatusFlag::C, value & 0b00'00'00'01);
-
-      // shift value right by 1, set bit 7 to old C
-      update_zero_and_negative_flag(value = value >> 1 | old_carry << 7);
-      return value;
+      return apply_carry(shift_right(value, processor_status_flag(ProcessorStatusFlag::C)));
    }
 
    Byte Processor::DEC(Byte value) noexcept
@@ -1132,786 +1298,343 @@ namespace nes
 
    Instruction Processor::instruction_from_opcode(Opcode const opcode)
    {
-      switch (opcode)
-      {
-         case Opcode::BRK_IMPLIED:
-            return BRK();
-
-         case Opcode::ORA_X_INDIRECT:
-            return x_indirect(&Processor::ORA);
-
-         case Opcode::JAM_IMPLIED_02:
-            return Instruction{ {} };
-
-         case Opcode::SLO_X_INDIRECT:
-            return Instruction{ {} };
-
-         case Opcode::NOP_ZERO_PAGE_04:
-            return Instruction{ {} };
-
-         case Opcode::ORA_ZERO_PAGE:
-            return zero_page(&Processor::ORA);
-
-         case Opcode::ASL_ZERO_PAGE:
-            return zero_page(&Processor::ASL);
-
-         case Opcode::SLO_ZERO_PAGE:
-            return Instruction{ {} };
-
-         case Opcode::PHP_IMPLIED:
-            return PHP();
-
-         case Opcode::ORA_IMMEDIATE:
-            return immediate(&Processor::ORA);
+      current_opcode_ = opcode;
+      if (profiler_)
+         profiler_->record(static_cast<std::underlying_type_t<Opcode>>(opcode));
 
-         case Opcode::ASL_ACCUMULATOR:
-            return accumulator(&Processor::ASL);
+      if (cycle_ < cycle_limit_)
+         skip_idle_loop(static_cast<Word>(program_counter - 1), opcode);
 
-         case Opcode::ANC_IMMEDIATE_0B:
-            return Instruction{ {} };
-
-         case Opcode::NOP_ABSOLUTE:
-            return Instruction{ {} };
+      return std::invoke(INSTRUCTION_FACTORIES[static_cast<std::underlying_type_t<Opcode>>(opcode)], this);
+   }
 
-         case Opcode::ORA_ABSOLUTE:
-            return absolute(&Processor::ORA);
+   template <Byte OPCODE>
+   constexpr Processor::InstructionFactory Processor::instruction_factory() noexcept
+   {
+      OpcodeInfo constexpr INFO{ OPCODE_INFOS[OPCODE] };
+      if constexpr (not INFO.official)
+         return &Processor::unsupported;
+      else if constexpr (INFO.mode == AddressingMode::RELATIVE)
+         return &Processor::relative<branch_operation(INFO.mnemonic)>;
+      else if constexpr (read_operation(INFO.mnemonic) not_eq nullptr)
+         return addressed_instruction_factory<read_operation(INFO.mnemonic), INFO.mode>();
+      else if constexpr (modify_operation(INFO.mnemonic) not_eq nullptr)
+         return addressed_instruction_factory<modify_operation(INFO.mnemonic), INFO.mode>();
+      else if constexpr (write_operation(INFO.mnemonic) not_eq nullptr)
+         return addressed_instruction_factory<write_operation(INFO.mnemonic), INFO.mode>();
+      else
+         return implied_instruction_factory(INFO);
+   }
+
+   template <auto OPERATION, AddressingMode MODE>
+   constexpr Processor::InstructionFactory Processor::addressed_instruction_factory() noexcept
+   {
+      if constexpr (MODE == AddressingMode::IMMEDIATE)
+         return &Processor::immediate<OPERATION>;
+      else if constexpr (MODE == AddressingMode::ACCUMULATOR)
+         return &Processor::accumulator<OPERATION>;
+      else if constexpr (MODE == AddressingMode::ZERO_PAGE)
+         return &Processor::zero_page<OPERATION>;
+      else if constexpr (MODE == AddressingMode::ZERO_PAGE_X)
+         return &Processor::zero_page_indexed<OPERATION, &Processor::x_>;
+      else if constexpr (MODE == AddressingMode::ZERO_PAGE_Y)
+         return &Processor::zero_page_indexed<OPERATION, &Processor::y_>;
+      else if constexpr (MODE == AddressingMode::ABSOLUTE)
+         return &Processor::absolute<OPERATION>;
+      else if constexpr (MODE == AddressingMode::ABSOLUTE_X)
+         return &Processor::absolute_indexed<OPERATION, &Processor::x_>;
+      else if constexpr (MODE == AddressingMode::ABSOLUTE_Y)
+         return &Processor::absolute_indexed<OPERATION, &Processor::y_>;
+      else if constexpr (MODE == AddressingMode::X_INDIRECT)
+         return &Processor::x_indirect<OPERATION>;
+      else
+      {
+         static_assert(MODE == AddressingMode::INDIRECT_Y);
+         return &Processor::indirect_y<OPERATION>;
+      }
+   }
 
-         case Opcode::ASL_ABSOLUTE:
-            return absolute(&Processor::ASL);
+   constexpr Processor::InstructionFactory Processor::implied_instruction_factory(OpcodeInfo const& info) noexcept
+   {
+      if (info.mnemonic == "JMP")
+         return info.mode == AddressingMode::ABSOLUTE ? &Processor::JMP_absolute : &Processor::JMP_indirect;
+      if (info.mnemonic == "BRK")
+         return &Processor::BRK;
+      if (info.mnemonic == "PHP")
+         return &Processor::PHP;
+      if (info.mnemonic == "CLC")
+         return &Processor::CLC;
+      if (info.mnemonic == "JSR")
+         return &Processor::JSR;
+      if (info.mnemonic == "PLP")
+         return &Processor::PLP;
+      if (info.mnemonic == "SEC")
+         return &Processor::SEC;
+      if (info.mnemonic == "RTI")
+         return &Processor::RTI;
+      if (info.mnemonic == "PHA")
+         return &Processor::PHA;
+      if (info.mnemonic == "CLI")
+         return &Processor::CLI;
+      if (info.mnemonic == "RTS")
+         return &Processor::RTS;
+      if (info.mnemonic == "PLA")
+         return &Processor::PLA;
+      if (info.mnemonic == "SEI")
+         return &Processor::SEI;
+      if (info.mnemonic == "DEY")
+         return &Processor::DEY;
+      if (info.mnemonic == "TXA")
+         return &Processor::TXA;
+      if (info.mnemonic == "TYA")
+         return &Processor::TYA;
+      if (info.mnemonic == "TXS")
+         return &Processor::TXS;
+      if (info.mnemonic == "TAY")
+         return &Processor::TAY;
+      if (info.mnemonic == "TAX")
+         return &Processor::TAX;
+      if (info.mnemonic == "CLV")
+         return &Processor::CLV;
+      if (info.mnemonic == "TSX")
+         return &Processor::TSX;
+      if (info.mnemonic == "INY")
+         return &Processor::INY;
+      if (info.mnemonic == "DEX")
+         return &Processor::DEX;
+      if (info.mnemonic == "CLD")
+         return &Processor::CLD;
+      if (info.mnemonic == "INX")
+         return &Processor::INX;
+      if (info.mnemonic == "NOP")
+         return &Processor::NOP;
+      if (info.mnemonic == "SED")
+         return &Processor::SED;
+
+      return &Processor::unsupported;
+   }
+
+   constexpr std::array<Processor::InstructionFactory, 256> Processor::INSTRUCTION_FACTORIES{
+      []<std::size_t... OPCODES>(std::index_sequence<OPCODES...>)
+      {
+         return std::array<InstructionFactory, 256>{ instruction_factory<OPCODES>()... };
+      }(std::make_index_sequence<256>{})
+   };
+
+   void Processor::skip_idle_loop(Word const head, Opcode const opcode) noexcept
+   {
+      if (cycle_ >= cycle_limit_)
+         return;
+
+      // only whole iterations are skipped and at least one cycle of the budget is left, so the core carries on
+      // exactly as if it had run them, the instruction-based ones included; the operands are only read for the
+      // opcodes a loop can start with
+      // under run_until, nothing changes over the iterations of a trap, so the predicate cannot hold at any boundary
+      // skipped unless it holds at the head already; a delay loop counts an index register down, so it is not skipped
+      bool const delay_loop{ opcode == Opcode::DEX_IMPLIED or opcode == Opcode::DEY_IMPLIED };
+      if (stop_predicate_.holds and (delay_loop or stop_requested()))
+         return;
+
+      Cycle const remaining{ cycle_limit_ - cycle_ - 1 };
+      auto const crosses_page{ [head](Word const next) { return high_byte(next) not_eq high_byte(head); } };
+      auto const operand{ [this, head] { return memory_.read(static_cast<Word>(head + 1)); } };
+      switch (opcode)
+      {
+         case Opcode::JMP_ABSOLUTE:
+         {
+            if (assemble_word(memory_.read(static_cast<Word>(head + 2)), operand()) not_eq head)
+               return;
 
-         case Opcode::SLO_ABSOLUTE:
-            return Instruction{ {} };
+            halt_reason_ = {
+               .cause{ HaltReason::Cause::TRAP },
+               .program_counter{ head },
+               .opcode{ static_cast<Byte>(opcode) }
+            };
+            cycle_ += remaining - remaining % 3;
+            return;
+         }
 
          case Opcode::BPL_RELATIVE:
-            return relative(&Processor::BPL);
-
-         case Opcode::ORA_INDIRECT_Y:
-            return indirect_y(&Processor::ORA);
-
-         case Opcode::JAM_IMPLIED_12:
-            return Instruction{ {} };
-
-         case Opcode::SLO_INDIRECT_Y:
-            return Instruction{ {} };
-
-         case Opcode::NOP_ZERO_PAGE_X_14:
-            return Instruction{ {} };
-
-         case Opcode::ORA_ZERO_PAGE_X:
-            return zero_page_indexed(&Processor::ORA, x_);
-
-         case Opcode::ASL_ZERO_PAGE_X:
-            return zero_page_indexed(&Processor::ASL, x_);
-
-         case Opcode::SLO_ZERO_PAGE_X:
-            return Instruction{ {} };
-
-         case Opcode::CLC_IMPLIED:
-            return CLC();
-
-         case Opcode::ORA_ABSOLUTE_Y:
-            return absolute_indexed(&Processor::ORA, y_);
-
-         case Opcode::NOP_IMPLIED_1A:
-            return Instruction{ {} };
-
-         case Opcode::SLO_ABSOLUTE_Y:
-            return Instruction{ {} };
-
-         case Opcode::NOP_ABSOLUTE_X_1C:
-            return Instruction{ {} };
-
-         case Opcode::ORA_ABSOLUTE_X:
-            return absolute_indexed(&Processor::ORA, x_);
-
-         case Opcode::ASL_ABSOLUTE_X:
-            return absolute_indexed(&Processor::ASL, x_);
-
-         case Opcode::SLO_ABSOLUTE_X:
-            return Instruction{ {} };
-
-         case Opcode::JSR_ABSOLUTE:
-            return JSR();
-
-         case Opcode::AND_X_INDIRECT:
-            return x_indirect(&Processor::AND);
-
-         case Opcode::JAM_IMPLIED_22:
-            return Instruction{ {} };
-
-         case Opcode::RLA_X_INDIRECT:
-            return Instruction{ {} };
-
-         case Opcode::BIT_ZERO_PAGE:
-            return zero_page(&Processor::BIT);
-
-         case Opcode::AND_ZERO_PAGE:
-            return zero_page(&Processor::AND);
-
-         case Opcode::ROL_ZERO_PAGE:
-            return zero_page(&Processor::ROL);
-
-         case Opcode::RLA_ZERO_PAGE:
-            return Instruction{ {} };
-
-         case Opcode::PLP_IMPLIED:
-            return PLP();
-
-         case Opcode::AND_IMMEDIATE:
-            return immediate(&Processor::AND);
-
-         case Opcode::ROL_ACCUMULATOR:
-            return accumulator(&Processor::ROL);
-
-         case Opcode::ANC_IMMEDIATE_2B:
-            return Instruction{ {} };
-
-         case Opcode::BIT_ABSOLUTE:
-            return absolute(&Processor::BIT);
-
-         case Opcode::AND_ABSOLUTE:
-            return absolute(&Processor::AND);
-
-         case Opcode::ROL_ABSOLUTE:
-            return absolute(&Processor::ROL);
-
-         case Opcode::RLA_ABSOLUTE:
-            return Instruction{ {} };
-
          case Opcode::BMI_RELATIVE:
-            return relative(&Processor::BMI);
-
-         case Opcode::AND_INDIRECT_Y:
-            return indirect_y(&Processor::AND);
-
-         case Opcode::JAM_IMPLIED_32:
-            return Instruction{ {} };
-
-         case Opcode::RLA_INDIRECT_Y:
-            return Instruction{ {} };
-
-         case Opcode::NOP_ZERO_PAGE_X_34:
-            return Instruction{ {} };
-
-         case Opcode::AND_ZERO_PAGE_X:
-            return zero_page_indexed(&Processor::AND, x_);
-
-         case Opcode::ROL_ZERO_PAGE_X:
-            return zero_page_indexed(&Processor::ROL, x_);
-
-         case Opcode::RLA_ZERO_PAGE_X:
-            return Instruction{ {} };
-
-         case Opcode::SEC_IMPLIED:
-            return SEC();
-
-         case Opcode::AND_ABSOLUTE_Y:
-            return absolute_indexed(&Processor::AND, y_);
-
-         case Opcode::NOP_IMPLIED_3A:
-            return Instruction{ {} };
-
-         case Opcode::RLA_ABSOLUTE_Y:
-            return Instruction{ {} };
-
-         case Opcode::NOP_ABSOLUTE_X_3C:
-            return Instruction{ {} };
-
-         case Opcode::AND_ABSOLUTE_X:
-            return absolute_indexed(&Processor::AND, x_);
-
-         case Opcode::ROL_ABSOLUTE_X:
-            return absolute_indexed(&Processor::ROL, x_);
-
-         case Opcode::RLA_ABSOLUTE_X:
-            return Instruction{ {} };
-
-         case Opcode::RTI_IMPLIED:
-            return RTI();
-
-         case Opcode::EOR_X_INDIRECT:
-            return x_indirect(&Processor::EOR);
-
-         case Opcode::JAM_IMPLIED_42:
-            return Instruction{ {} };
-
-         case Opcode::SRE_X_INDIRECT:
-            return Instruction{ {} };
-
-         case Opcode::NOP_ZERO_PAGE_44:
-            return Instruction{ {} };
-
-         case Opcode::EOR_ZERO_PAGE:
-            return zero_page(&Processor::EOR);
-
-         case Opcode::LSR_ZERO_PAGE:
-            return zero_page(&Processor::LSR);
-
-         case Opcode::SRE_ZERO_PAGE:
-            return Instruction{ {} };
-
-         case Opcode::PHA_IMPLIED:
-            return PHA();
-
-         case Opcode::EOR_IMMEDIATE:
-            return immediate(&Processor::EOR);
-
-         case Opcode::LSR_ACCUMULATOR:
-            return accumulator(&Processor::LSR);
-
-         case Opcode::ALR_IMMEDIATE_4B:
-            return Instruction{ {} };
-
-         case Opcode::JMP_ABSOLUTE:
-            return JMP_absolute();
-
-         case Opcode::EOR_ABSOLUTE:
-            return absolute(&Processor::EOR);
-
-         case Opcode::LSR_ABSOLUTE:
-            return absolute(&Processor::LSR);
-
-         case Opcode::SRE_ABSOLUTE:
-            return Instruction{ {} };
-
          case Opcode::BVC_RELATIVE:
-            return relative(&Processor::BVC);
-
-         case Opcode::EOR_INDIRECT_Y:
-            return indirect_y(&Processor::EOR);
-
-         case Opcode::JAM_IMPLIED_52:
-            return Instruction{ {} };
-
-         case Opcode::SRE_INDIRECT_Y:
-            return Instruction{ {} };
-
-         case Opcode::NOP_ZERO_PAGE_X_54:
-            return Instruction{ {} };
-
-         case Opcode::EOR_ZERO_PAGE_X:
-            return zero_page_indexed(&Processor::EOR, x_);
-
-         case Opcode::LSR_ZERO_PAGE_X:
-            return zero_page_indexed(&Processor::LSR, x_);
-
-         case Opcode::SRE_ZERO_PAGE_X:
-            return Instruction{ {} };
-
-         case Opcode::CLI_IMPLIED:
-            return CLI();
-
-         case Opcode::EOR_ABSOLUTE_Y:
-            return absolute_indexed(&Processor::EOR, y_);
-
-         case Opcode::NOP_IMPLIED_5A:
-            return Instruction{ {} };
-
-         case Opcode::SRE_ABSOLUTE_Y:
-            return Instruction{ {} };
-
-         case Opcode::NOP_ABSOLUTE_X_5C:
-            return Instruction{ {} };
-
-         case Opcode::EOR_ABSOLUTE_X:
-            return absolute_indexed(&Processor::EOR, x_);
-
-         case Opcode::LSR_ABSOLUTE_X:
-            return absolute_indexed(&Processor::LSR, x_);
-
-         case Opcode::SRE_ABSOLUTE_X:
-            return Instruction{ {} };
-
-         case Opcode::RTS_IMPLIED:
-            return RTS();
-
-         case Opcode::ADC_X_INDIRECT:
-            return x_indirect(&Processor::ADC);
-
-         case Opcode::JAM_IMPLIED_62:
-            return Instruction{ {} };
-
-         case Opcode::RRA_X_INDIRECT:
-            return Instruction{ {} };
-
-         case Opcode::NOP_ZERO_PAGE_64:
-            return Instruction{ {} };
-
-         case Opcode::ADC_ZERO_PAGE:
-            return zero_page(&Processor::ADC);
-
-         case Opcode::ROR_ZERO_PAGE:
-            return zero_page(&Processor::ROR);
-
-         case Opcode::RRA_ZERO_PAGE:
-            return Instruction{ {} };
-
-         case Opcode::PLA_IMPLIED:
-            return PLA();
-
-         case Opcode::ADC_IMMEDIATE:
-            return immediate(&Processor::ADC);
-
-         case Opcode::ROR_ACCUMULATOR:
-            return accumulator(&Processor::ROR);
-
-         case Opcode::ARR_IMMEDIATE:
-            return Instruction{ {} };
-
-         case Opcode::JMP_INDIRECT:
-            return JMP_indirect();
-
-         case Opcode::ADC_ABSOLUTE:
-            return absolute(&Processor::ADC);
-
-         case Opcode::ROR_ABSOLUTE:
-            return absolute(&Processor::ROR);
-
-         case Opcode::RRA_ABSOLUTE:
-            return Instruction{ {} };
-
          case Opcode::BVS_RELATIVE:
-            return relative(&Processor::BVS);
-
-         case Opcode::ADC_INDIRECT_Y:
-            return indirect_y(&Processor::ADC);
-
-         case Opcode::JAM_IMPLIED_72:
-            return Instruction{ {} };
-
-         case Opcode::RRA_INDIRECT_Y:
-            return Instruction{ {} };
-
-         case Opcode::NOP_ZERO_PAGE_X_74:
-            return Instruction{ {} };
-
-         case Opcode::ADC_ZERO_PAGE_X:
-            return zero_page_indexed(&Processor::ADC, x_);
-
-         case Opcode::ROR_ZERO_PAGE_X:
-            return zero_page_indexed(&Processor::ROR, x_);
-
-         case Opcode::RRA_ZERO_PAGE_X:
-            return Instruction{ {} };
-
-         case Opcode::SEI_IMPLIED:
-            return SEI();
-
-         case Opcode::ADC_ABSOLUTE_Y:
-            return absolute_indexed(&Processor::ADC, y_);
-
-         case Opcode::NOP_IMPLIED_7A:
-            return Instruction{ {} };
-
-         case Opcode::RRA_ABSOLUTE_Y:
-            return Instruction{ {} };
-
-         case Opcode::NOP_ABSOLUTE_X_7C:
-            return Instruction{ {} };
-
-         case Opcode::ADC_ABSOLUTE_X:
-            return absolute_indexed(&Processor::ADC, x_);
-
-         case Opcode::ROR_ABSOLUTE_X:
-            return absolute_indexed(&Processor::ROR, x_);
-
-         case Opcode::RRA_ABSOLUTE_X:
-            return Instruction{ {} };
-
-         case Opcode::NOP_IMMEDIATE_80:
-            return Instruction{ {} };
-
-         case Opcode::STA_X_INDIRECT:
-            return x_indirect(&Processor::STA);
-
-         case Opcode::NOP_IMMEDIATE_82:
-            return Instruction{ {} };
-
-         case Opcode::SAX_X_INDIRECT:
-            return Instruction{ {} };
-
-         case Opcode::STY_ZERO_PAGE:
-            return zero_page(&Processor::STY);
-
-         case Opcode::STA_ZERO_PAGE:
-            return zero_page(&Processor::STA);
-
-         case Opcode::STX_ZERO_PAGE:
-            return zero_page(&Processor::STX);
-
-         case Opcode::SAX_ZERO_PAGE:
-            return Instruction{ {} };
-
-         case Opcode::DEY_IMPLIED:
-            return DEY();
-
-         case Opcode::NOP_IMMEDIATE_89:
-            return Instruction{ {} };
-
-         case Opcode::TXA_IMPLIED:
-            return TXA();
-
-         case Opcode::ANE_IMMEDIATE:
-            return Instruction{ {} };
-
-         case Opcode::STY_ABSOLUTE:
-            return absolute(&Processor::STY);
-
-         case Opcode::STA_ABSOLUTE:
-            return absolute(&Processor::STA);
-
-         case Opcode::STX_ABSOLUTE:
-            return absolute(&Processor::STX);
-
-         case Opcode::SAX_ABSOLUTE:
-            return Instruction{ {} };
-
          case Opcode::BCC_RELATIVE:
-            return relative(&Processor::BCC);
-
-         case Opcode::STA_INDIRECT_Y:
-            return indirect_y(&Processor::STA);
-
-         case Opcode::JAM_IMPLIED_92:
-            return Instruction{ {} };
-
-         case Opcode::SHA_INDIRECT_Y:
-            return Instruction{ {} };
-
-         case Opcode::STY_ZERO_PAGE_X:
-            return zero_page_indexed(&Processor::STY, x_);
-
-         case Opcode::STA_ZERO_PAGE_X:
-            return zero_page_indexed(&Processor::STA, x_);
-
-         case Opcode::STX_ZERO_PAGE_Y:
-            return zero_page_indexed(&Processor::STX, y_);
-
-         case Opcode::SAX_ZERO_PAGE_Y:
-            return Instruction{ {} };
-
-         case Opcode::TYA_IMPLIED:
-            return TYA();
-
-         case Opcode::STA_ABSOLUTE_Y:
-            return absolute_indexed(&Processor::STA, y_);
-
-         case Opcode::TXS_IMPLIED:
-            return TXS();
-
-         case Opcode::TAS_ABSOLUTE_Y:
-            return Instruction{ {} };
-
-         case Opcode::SHY_ABSOLUTE_X:
-            return Instruction{ {} };
-
-         case Opcode::STA_ABSOLUTE_X:
-            return absolute_indexed(&Processor::STA, x_);
-
-         case Opcode::SHX_ABSOLUTE_Y:
-            return Instruction{ {} };
-
-         case Opcode::SHA_ABSOLUTE_Y:
-            return Instruction{ {} };
-
-         case Opcode::LDY_IMMEDIATE:
-            return immediate(&Processor::LDY);
-
-         case Opcode::LDA_X_INDIRECT:
-            return x_indirect(&Processor::LDA);
-
-         case Opcode::LDX_IMMEDIATE:
-            return immediate(&Processor::LDX);
-
-         case Opcode::LAX_X_INDIRECT:
-            return Instruction{ {} };
-
-         case Opcode::LDY_ZERO_PAGE:
-            return zero_page(&Processor::LDY);
-
-         case Opcode::LDA_ZERO_PAGE:
-            return zero_page(&Processor::LDA);
-
-         case Opcode::LDX_ZERO_PAGE:
-            return zero_page(&Processor::LDX);
-
-         case Opcode::LAX_ZERO_PAGE:
-            return Instruction{ {} };
-
-         case Opcode::TAY_IMPLIED:
-            return TAY();
-
-         case Opcode::LDA_IMMEDIATE:
-            return immediate(&Processor::LDA);
-
-         case Opcode::TAX_IMPLIED:
-            return TAX();
-
-         case Opcode::LXA_IMMEDIATE:
-            return Instruction{ {} };
-
-         case Opcode::LDY_ABSOLUTE:
-            return absolute(&Processor::LDY);
-
-         case Opcode::LDA_ABSOLUTE:
-            return absolute(&Processor::LDA);
-
-         case Opcode::LDX_ABSOLUTE:
-            return absolute(&Processor::LDX);
-
-         case Opcode::LAX_ABSOLUTE:
-            return Instruction{ {} };
-
          case Opcode::BCS_RELATIVE:
-            return relative(&Processor::BCS);
-
-         case Opcode::LDA_INDIRECT_Y:
-            return indirect_y(&Processor::LDA);
-
-         case Opcode::JAM_IMPLIED_B2:
-            return Instruction{ {} };
-
-         case Opcode::LAX_INDIRECT_Y:
-            return Instruction{ {} };
-
-         case Opcode::LDY_ZERO_PAGE_X:
-            return zero_page_indexed(&Processor::LDY, x_);
-
-         case Opcode::LDA_ZERO_PAGE_X:
-            return zero_page_indexed(&Processor::LDA, x_);
-
-         case Opcode::LDX_ZERO_PAGE_Y:
-            return zero_page_indexed(&Processor::LDX, y_);
-
-         case Opcode::LAX_ZERO_PAGE_Y:
-            return Instruction{ {} };
-
-         case Opcode::CLV_IMPLIED:
-            return CLV();
-
-         case Opcode::LDA_ABSOLUTE_Y:
-            return absolute_indexed(&Processor::LDA, y_);
-
-         case Opcode::TSX_IMPLIED:
-            return TSX();
-
-         case Opcode::LAS_ABSOLUTE_Y:
-            return Instruction{ {} };
-
-         case Opcode::LDY_ABSOLUTE_X:
-            return absolute_indexed(&Processor::LDY, x_);
-
-         case Opcode::LDA_ABSOLUTE_X:
-            return absolute_indexed(&Processor::LDA, x_);
-
-         case Opcode::LDX_ABSOLUTE_Y:
-            return absolute_indexed(&Processor::LDX, y_);
-
-         case Opcode::LAX_ABSOLUTE_Y:
-            return Instruction{ {} };
-
-         case Opcode::CPY_IMMEDIATE:
-            return immediate(&Processor::CPY);
-
-         case Opcode::CMP_X_INDIRECT:
-            return x_indirect(&Processor::CMP);
-
-         case Opcode::NOP_IMMEDIATE_C2:
-            return Instruction{ {} };
-
-         case Opcode::DCP_X_INDIRECT:
-            return Instruction{ {} };
-
-         case Opcode::CPY_ZERO_PAGE:
-            return zero_page(&Processor::CPY);
-
-         case Opcode::CMP_ZERO_PAGE:
-            return zero_page(&Processor::CMP);
-
-         case Opcode::DEC_ZERO_PAGE:
-            return zero_page(&Processor::DEC);
-
-         case Opcode::DCP_ZERO_PAGE:
-            return Instruction{ {} };
-
-         case Opcode::INY_IMPLIED:
-            return INY();
-
-         case Opcode::CMP_IMMEDIATE:
-            return immediate(&Processor::CMP);
-
-         case Opcode::DEX_IMPLIED:
-            return DEX();
-
-         case Opcode::SBX_IMMEDIATE:
-            return Instruction{ {} };
-
-         case Opcode::CPY_ABSOLUTE:
-            return absolute(&Processor::CPY);
-
-         case Opcode::CMP_ABSOLUTE:
-            return absolute(&Processor::CMP);
-
-         case Opcode::DEC_ABSOLUTE:
-            return absolute(&Processor::DEC);
-
-         case Opcode::DCP_ABSOLUTE:
-            return Instruction{ {} };
-
          case Opcode::BNE_RELATIVE:
-            return relative(&Processor::BNE);
-
-         case Opcode::CMP_INDIRECT_Y:
-            return indirect_y(&Processor::CMP);
-
-         case Opcode::JAM_IMPLIED_D2:
-            return Instruction{ {} };
-
-         case Opcode::DCP_INDIRECT_Y:
-            return Instruction{ {} };
-
-         case Opcode::NOP_ZERO_PAGE_X_D4:
-            return Instruction{ {} };
-
-         case Opcode::CMP_ZERO_PAGE_X:
-            return zero_page_indexed(&Processor::CMP, x_);
-
-         case Opcode::DEC_ZERO_PAGE_X:
-            return zero_page_indexed(&Processor::DEC, x_);
-
-         case Opcode::DCP_ZERO_PAGE_X:
-            return Instruction{ {} };
-
-         case Opcode::CLD_IMPLIED:
-            return CLD();
-
-         case Opcode::CMP_ABSOLUTE_Y:
-            return absolute_indexed(&Processor::CMP, y_);
-
-         case Opcode::NOP_IMPLIED_DA:
-            return Instruction{ {} };
-
-         case Opcode::DCP_ABSOLUTE_Y:
-            return Instruction{ {} };
-
-         case Opcode::NOP_ABSOLUTE_X_DC:
-            return Instruction{ {} };
-
-         case Opcode::CMP_ABSOLUTE_X:
-            return absolute_indexed(&Processor::CMP, x_);
-
-         case Opcode::DEC_ABSOLUTE_X:
-            return absolute_indexed(&Processor::DEC, x_);
-
-         case Opcode::DCP_ABSOLUTE_X:
-            return Instruction{ {} };
-
-         case Opcode::CPX_IMMEDIATE:
-            return immediate(&Processor::CPX);
-
-         case Opcode::SBC_X_INDIRECT:
-            return x_indirect(&Processor::SBC);
-
-         case Opcode::NOP_IMMEDIATE_E2:
-            return Instruction{ {} };
-
-         case Opcode::ISC_X_INDIRECT:
-            return Instruction{ {} };
-
-         case Opcode::CPX_ZERO_PAGE:
-            return zero_page(&Processor::CPX);
-
-         case Opcode::SBC_ZERO_PAGE:
-            return zero_page(&Processor::SBC);
-
-         case Opcode::INC_ZERO_PAGE:
-            return zero_page(&Processor::INC);
-
-         case Opcode::ISC_ZERO_PAGE:
-            return Instruction{ {} };
-
-         case Opcode::INX_IMPLIED:
-            return INX();
-
-         case Opcode::SBC_IMMEDIATE_E9:
-            return immediate(&Processor::SBC);
-
-         case Opcode::NOP_IMPLIED_EA:
-            return NOP();
-
-         case Opcode::SBC_IMMEDIATE_EB:
-            return Instruction{ {} };
-
-         case Opcode::CPX_ABSOLUTE:
-            return absolute(&Processor::CPX);
+         case Opcode::BEQ_RELATIVE:
+         {
+            // the top two bits of a branch opcode select the flag it tests, the third the value it branches on
+            static std::array<ProcessorStatusFlag, 4> constexpr FLAGS{
+               ProcessorStatusFlag::N, ProcessorStatusFlag::V, ProcessorStatusFlag::C, ProcessorStatusFlag::Z
+            };
 
-         case Opcode::SBC_ABSOLUTE:
-            return absolute(&Processor::SBC);
+            auto const branch_opcode{ static_cast<std::underlying_type_t<Opcode>>(opcode) };
+            bool const branches_if_set{ static_cast<bool>(branch_opcode & 0b00'10'00'00) };
+            if (operand() not_eq 0xFE or processor_status_flag(FLAGS[branch_opcode >> 6]) not_eq branches_if_set)
+               return;
 
-         case Opcode::INC_ABSOLUTE:
-            return absolute(&Processor::INC);
+            halt_reason_ = { .cause{ HaltReason::Cause::TRAP }, .program_counter{ head }, .opcode{ branch_opcode } };
+            Cycle const period{ 3u + crosses_page(static_cast<Word>(head + 2)) };
+            cycle_ += remaining - remaining % period;
+            return;
+         }
 
-         case Opcode::ISC_ABSOLUTE:
-            return Instruction{ {} };
+         case Opcode::DEX_IMPLIED:
+         case Opcode::DEY_IMPLIED:
+         {
+            // DEX/DEY followed by a BNE back to it counts the index register down to zero
+            if (operand() not_eq static_cast<Byte>(Opcode::BNE_RELATIVE)
+               or memory_.read(static_cast<Word>(head + 2)) not_eq 0xFD)
+               return;
+
+            Index& index{ opcode == Opcode::DEX_IMPLIED ? x_ : y_ };
+            Cycle const period{ 5u + crosses_page(static_cast<Word>(head + 3)) };
+            auto const iterations{ std::min<Cycle>(static_cast<Byte>(index - 1), remaining / period) };
+            if (not iterations)
+               return;
+
+            cycle_ += iterations * period;
+            index = static_cast<Index>(index - iterations);
+            update_zero_and_negative_flag(index);
+            return;
+         }
 
-         case Opcode::BEQ_RELATIVE:
-            return relative(&Processor::BEQ);
+         default:
+            return;
+      }
+   }
 
-         case Opcode::SBC_INDIRECT_Y:
-            return indirect_y(&Processor::SBC);
+   void Processor::freeze() noexcept
+   {
+      auto const opcode{ static_cast<std::underlying_type_t<Opcode>>(current_opcode_) };
+      bool const jammed{ Variant::JAMS and OPCODE_INFOS[opcode].mnemonic == "JAM" };
+      halt_reason_ = {
+         .cause{ jammed ? HaltReason::Cause::JAM : HaltReason::Cause::UNSUPPORTED_OPCODE },
+         .program_counter{ static_cast<Word>(program_counter - 1) },
+         .opcode{ opcode }
+      };
+      cycle_ = std::max(cycle_, cycle_limit_);
+   }
 
-         case Opcode::JAM_IMPLIED_F2:
-            return Instruction{ {} };
+   bool Processor::run_hook()
+   {
+      if (verification_ and program_counter == verification_->return_address
+         and stack_pointer_ == verification_->registers.stack_pointer)
+         finish_verification();
 
-         case Opcode::ISC_INDIRECT_Y:
-            return Instruction{ {} };
+      HookRegistry::Hook* const hook{ hooks_->find(memory_, program_counter) };
+      if (not hook or (hooks_->verifying() and verification_))
+         return false;
 
-         case Opcode::NOP_ZERO_PAGE_X_F4:
-            return Instruction{ {} };
+      ++hook->calls;
+      resolve_processor_status();
+      HookRegistry::Registers registers{
+         .accumulator{ accumulator_ },
+         .x{ x_ },
+         .y{ y_ },
+         .stack_pointer{ stack_pointer_ },
+         .processor_status{ processor_status_ }
+      };
 
-         case Opcode::SBC_ZERO_PAGE_X:
-            return zero_page_indexed(&Processor::SBC, x_);
+      if (hooks_->verifying())
+      {
+         // The routine runs on a copy, the subroutine is interpreted as if there were no hook. Only the pages that can
+         // be read without side effects are copied, and of those only RAM is compared afterwards. The copy maps
+         // neither ROM nor mirrors, so writes the routine makes there would not match what the subroutine does.
+         auto memory{ std::make_unique<Memory>() };
+         std::bitset<Memory::PAGES> compared_pages{};
+         for (std::size_t page{}; page < Memory::PAGES; ++page)
+         {
+            auto const first{ static_cast<Word>(page * Memory::PAGE_SIZE) };
+            if (not memory_.side_effect_free(first))
+               continue;
 
-         case Opcode::INC_ZERO_PAGE_X:
-            return zero_page_indexed(&Processor::INC, x_);
+            for (std::size_t offset{}; offset < Memory::PAGE_SIZE; ++offset)
+               memory->write(static_cast<Word>(first + offset), memory_.read(static_cast<Word>(first + offset)));
 
-         case Opcode::ISC_ZERO_PAGE_X:
-            return Instruction{ {} };
+            compared_pages[page] = memory_.writable(first) and not memory_.mirror(first);
+         }
 
-         case Opcode::SED_IMPLIED:
-            return SED();
+         Cycle const cycles{ hook->routine(registers, *memory) };
+         Byte const return_address_low{ memory->read(0x01'00 + static_cast<Byte>(registers.stack_pointer + 1)) };
+         Byte const return_address_high{ memory->read(0x01'00 + static_cast<Byte>(registers.stack_pointer + 2)) };
+         registers.stack_pointer += 2;
+         verification_ = {
+            .hook{ hook },
+            .start{ cycle_ },
+            .cycles{ cycles },
+            .return_address{ static_cast<Word>(assemble_word(return_address_high, return_address_low) + 1) },
+            .registers{ registers },
+            .memory{ std::move(memory) },
+            .compared_pages{ compared_pages }
+         };
+
+         return false;
+      }
 
-         case Opcode::SBC_ABSOLUTE_Y:
-            return absolute_indexed(&Processor::SBC, y_);
+      cycle_ += hook->routine(registers, memory_);
+      accumulator_ = registers.accumulator;
+      x_ = registers.x;
+      y_ = registers.y;
+      stack_pointer_ = registers.stack_pointer;
+      processor_status_ = registers.processor_status;
 
-         case Opcode::NOP_IMPLIED_FA:
-            return Instruction{ {} };
+      // return like RTS
+      ++stack_pointer_;
+      Byte const return_address_low{ read_from_stack() };
+      ++stack_pointer_;
+      program_counter = static_cast<Word>(assemble_word(read_from_stack(), return_address_low) + 1);
+      return true;
+   }
 
-         case Opcode::ISC_ABSOLUTE_Y:
-            return Instruction{ {} };
+   void Processor::finish_verification() noexcept
+   {
+      resolve_processor_status();
+      HookRegistry::Registers const& expected{ verification_->registers };
+      bool matches{
+         cycle_ - verification_->start == verification_->cycles
+         and accumulator_ == expected.accumulator
+         and x_ == expected.x
+         and y_ == expected.y
+         and processor_status_ == expected.processor_status
+      };
 
-         case Opcode::NOP_ABSOLUTE_X_FC:
-            return Instruction{ {} };
+      // pages the subroutine mapped something else into since are left out as well
+      for (std::size_t page{}; matches and page < Memory::PAGES; ++page)
+      {
+         auto const first{ static_cast<Word>(page * Memory::PAGE_SIZE) };
+         if (not verification_->compared_pages[page] or not memory_.side_effect_free(first)
+            or not memory_.writable(first) or memory_.mirror(first))
+            continue;
+
+         for (std::size_t offset{}; matches and offset < Memory::PAGE_SIZE; ++offset)
+            matches = memory_.read(static_cast<Word>(first + offset))
+               == verification_->memory->read(static_cast<Word>(first + offset));
+      }
 
-         case Opcode::SBC_ABSOLUTE_X:
-            return absolute_indexed(&Processor::SBC, x_);
+      ++verification_->hook->verifications;
+      if (not matches)
+         ++verification_->hook->mismatches;
 
-         case Opcode::INC_ABSOLUTE_X:
-            return absolute_indexed(&Processor::INC, x_);
+      verification_.reset();
+   }
 
-         case Opcode::ISC_ABSOLUTE_X:
-            return Instruction{ {} };
+   bool Processor::stop_requested()
+   {
+      return stop_predicate_.holds and stop_predicate_.holds(stop_predicate_.predicate);
+   }
 
-         default:
-            throw UnsupportedOpcode{
-               static_cast<decltype(program_counter)>(program_counter - 1),
-               static_cast<std::underlying_type_t<Opcode>>(opcode)
-            };
-      }
+   bool Processor::frozen() const noexcept
+   {
+      return halt_reason_ and halt_reason_->cause not_eq HaltReason::Cause::TRAP;
    }
 
    void Processor::change_processor_status_flag(ProcessorStatusFlag const flag, bool const set) noexcept
    {
+      // the other of N and Z may still be pending
+      if (flag == ProcessorStatusFlag::N or flag == ProcessorStatusFlag::Z)
+         resolve_processor_status();
+
       auto const underlying_flag{ static_cast<std::underlying_type_t<ProcessorStatusFlag>>(flag) };
       set
          ? processor_status_ |= underlying_flag
@@ -1920,67 +1643,96 @@ namespace nes
 
    bool Processor::processor_status_flag(ProcessorStatusFlag flag) const noexcept
    {
+      if (zero_and_negative_pending_)
+      {
+         if (flag == ProcessorStatusFlag::Z)
+            return not zero_and_negative_source_;
+         if (flag == ProcessorStatusFlag::N)
+            return zero_and_negative_source_ & 0b10'00'00'00;
+      }
+
       auto const underlying_flag{ static_cast<std::underlying_type_t<ProcessorStatusFlag>>(flag) };
       return processor_status_ & underlying_flag;
    }
 
    void Processor::update_zero_and_negative_flag(Byte const value) noexcept
    {
-      change_processor_status_flag(ProcessorStatusFlag::Z, not value);
-      change_processor_status_flag(ProcessorStatusFlag::N, value & 0b10'00'00'00);
+      if constexpr (LAZY_FLAGS)
+      {
+         zero_and_negative_source_ = value;
+         zero_and_negative_pending_ = true;
+      }
+      else
+      {
+         change_processor_status_flag(ProcessorStatusFlag::Z, not value);
+         change_processor_status_flag(ProcessorStatusFlag::N, value & 0b10'00'00'00);
+      }
    }
 
-   void Processor::write_to_stack(Byte const value) const noexcept
+   void Processor::resolve_processor_status() noexcept
    {
-      memory_.write(0x01'00 + stack_pointer_, value);
+      processor_status_ = processor_status();
+      zero_and_negative_pending_ = false;
    }
 
-   Byte Processor::read_from_stack() const noexcept
+   void Processor::pull_processor_status() noexcept
    {
-      return memory_.read(0x01'00 + stack_pointer_);
+      auto constexpr KEPT{
+         static_cast<ProcessorStatus>(ProcessorStatusFlag::B) | static_cast<ProcessorStatus>(ProcessorStatusFlag::_)
+      };
+
+      resolve_processor_status();
+      processor_status_ = (processor_status_ & KEPT) | read_from_stack();
    }
 
-   constexpr Byte Processor::low_byte(Word const source) noexcept
+   void Processor::add_decimal(Byte const value) noexcept
    {
-      return static_cast<Byte>(source);
+      apply_decimal(nes::add_decimal(accumulator_, value, processor_status_flag(ProcessorStatusFlag::C)));
    }
 
-   constexpr Byte Processor::high_byte(Word const source) noexcept
+   void Processor::subtract_decimal(Byte const value) noexcept
    {
-      return source >> 8;
+      apply_decimal(nes::subtract_decimal(accumulator_, value, processor_status_flag(ProcessorStatusFlag::C)));
    }
 
-   constexpr Word Processor::assemble_word(Byte const high, Byte const low) noexcept
+   void Processor::apply_binary(BinaryResult const& binary) noexcept
    {
-      return high << 8 | low;
+      change_processor_status_flag(ProcessorStatusFlag::C, binary.carry);
+      change_processor_status_flag(ProcessorStatusFlag::V, binary.overflow);
+      update_zero_and_negative_flag(accumulator_ = binary.result);
    }
 
-   constexpr Word Processor::assign_low_byte(Word const target, Byte const value) noexcept
+   Byte Processor::apply_carry(BinaryResult const& binary) noexcept
    {
-      return assemble_word(high_byte(target), value);
+      change_processor_status_flag(ProcessorStatusFlag::C, binary.carry);
+      update_zero_and_negative_flag(binary.result);
+      return binary.result;
    }
 
-   constexpr Word Processor::assign_high_byte(Word const target, Byte const value) noexcept
+   void Processor::apply_decimal(DecimalResult const& decimal) noexcept
    {
-      return assemble_word(value, low_byte(target));
+      change_processor_status_flag(ProcessorStatusFlag::C, decimal.carry);
+      change_processor_status_flag(ProcessorStatusFlag::V, decimal.overflow);
+      change_processor_status_flag(ProcessorStatusFlag::Z, decimal.zero);
+      change_processor_status_flag(ProcessorStatusFlag::N, decimal.negative);
+      accumulator_ = decimal.result;
    }
 
-   constexpr std::pair<Byte, bool> Processor::add_with_overflow(Byte const left, Byte const right) noexcept
+   void Processor::dummy_read(Word const address) noexcept
    {
-      auto const result{ static_cast<Byte>(left + right) };
-      return { result, result < left };
+      if (memory_.side_effect_free(address))
+         ++elided_reads_;
+      else
+         std::ignore = memory_.read(address);
    }
 
-   constexpr std::pair<Byte, SignedByte> Processor::add_with_overflow(Byte const left, SignedByte const right) noexcept
+   void Processor::write_to_stack(Byte const value) const noexcept
    {
-      auto const result{ static_cast<Byte>(left + right) };
-
-      SignedByte overflow;
-      if (right < 0)
-         overflow = result > left ? -1 : 0;
-      else
-         overflow = result < left ? 1 : 0;
+      memory_.write(0x01'00 + stack_pointer_, value);
+   }
 
-      return { result, overflow };
+   Byte Processor::read_from_stack() const noexcept
+   {
+      return memory_.read(0x01'00 + stack_pointer_);
    }
 }
\ No newline at end of file
@@ -1,14 +1,33 @@
 #ifndef PROCESSOR_HPP
 #define PROCESSOR_HPP
 
+#include "addressing_mode.hpp"
+#include "binary.hpp"
+#include "block_cache.hpp"
+#include "decimal.hpp"
+#include "halt_reason.hpp"
+#include "hook_registry.hpp"
 #include "hardware/memory/memory.hpp"
 #include "instruction.hpp"
+#include "microcode_state.hpp"
+#include "microprogram.hpp"
+#include "opcode_info.hpp"
 #include "pch.hpp"
+#include "predecoded_instruction.hpp"
+#include "recompiler.hpp"
+#include "static_translation.hpp"
+#include "variant.hpp"
 
 namespace nes
 {
+   class Profiler;
+
    class Processor final
    {
+      friend Instruction::promise_type;
+      friend class Recompiler;
+      friend class StaticTranslation;
+
       using BranchOperation = bool(Processor::*)() const noexcept;
       using ReadOperation = void(Processor::*)(Byte) noexcept;
       using ModifyOperation = Byte(Processor::*)(Byte) noexcept;
@@ -302,6 +321,15 @@ namespace nes
             N = 0b10'00'00'00
          };
 
+         enum class Core
+         {
+            CYCLE_STEPPED,
+            MICROCODED,
+            INSTRUCTION_STEPPED,
+            PREDECODED,
+            RECOMPILED
+         };
+
          static Word constexpr NMI_LOW{ 0xFF'FA };
          static Word constexpr NMI_HIGH{ NMI_LOW + 1 };
          static Word constexpr RESET_LOW{ 0xFF'FC };
@@ -309,7 +337,13 @@ namespace nes
          static Word constexpr IRQ_LOW{ 0xFF'FE };
          static Word constexpr IRQ_HIGH{ IRQ_LOW + 1 };
 
-         explicit Processor(Memory& memory) noexcept;
+         // N and Z are kept as the byte they were last derived from and only folded into P once something observes P
+         static bool constexpr LAZY_FLAGS{ true };
+
+         // Starts out with the core as change_core changes to it, so the caller makes sure the memory has a free
+         // watcher for the predecoded and recompiled cores, like Host::add_processor does. Without one, debug builds
+         // assert and release builds leave the processor cycle stepped, which core() tells.
+         explicit Processor(Memory& memory, Core core = Core::CYCLE_STEPPED) noexcept;
          Processor(Processor const&) = delete;
          Processor(Processor&&) = delete;
 
@@ -318,44 +352,152 @@ namespace nes
          Processor& operator=(Processor const&) = delete;
          Processor& operator=(Processor&&) = delete;
 
-         bool tick();
-         void reset() noexcept;
+         // Returns whether an instruction completed with the cycle, or why the processor halted. A jammed processor
+         // stays halted until it is reset, its clock still running.
+         std::expected<bool, HaltReason> tick();
+
+         // Both run functions stay inside the core until their budget is spent, run_until also stopping at the first
+         // instruction boundary its predicate holds at. Callers bound the budget by the cycle their next event is due
+         // at; the instruction-based cores may overshoot it by part of an instruction. Both return the cycles run, or
+         // why the processor halted.
+         // Within a run, traps and delay loops that nothing can leave before the budget is spent are skipped by
+         // advancing the cycle counter; a trap is also reported as the halt reason.
+         std::expected<Cycle, HaltReason> run(Cycle budget);
+
+         // The predicate is tested after every instruction, so it should only depend on the state of the processor and
+         // memory, the budget standing for time. Delay loops are not skipped, traps only where the predicate does not
+         // hold, and the block-running cores interpret their blocks one instruction at a time.
+         template <std::predicate Predicate>
+         std::expected<Cycle, HaltReason> run_until(Predicate predicate,
+            Cycle const budget = std::numeric_limits<Cycle>::max())
+         {
+            stop_predicate_ = {
+               .holds{ [](void* const erased) -> bool { return std::invoke(*static_cast<Predicate*>(erased)); } },
+               .predicate{ std::addressof(predicate) }
+            };
 
+            auto const cycles{ run(budget) };
+            stop_predicate_ = {};
+            return cycles;
+         }
+
+         void reset() noexcept;
+         // The predecoded and recompiled cores keep their blocks coherent through a watcher of the memory, so changing
+         // to one fails, keeping the current core, when the memory has none free.
+         [[nodiscard]] bool change_core(Core core) noexcept;
+         // counts every instruction the interpreting cores start until detached with nullptr
+         void attach(Profiler* profiler) noexcept;
+         // Runs the native routines of the registry in place of the subroutines they stand for until uninstalled with
+         // nullptr, the registry outliving its installation. A routine runs at whatever instruction boundary the
+         // processor reaches a hooked entry point at, with tick as well, which then spends all of the routine's cycles.
+         void install(HookRegistry* hooks) noexcept;
+         // Lets the block-running cores execute frequent sequences of instructions within a block through one fused
+         // handler; a run may then overshoot its budget by a whole sequence.
+         void set_fusion(bool fusion) noexcept;
+         // runs the blocks of the translation in place of interpreting them with the block-running cores until unset
+         // with nullptr, the translation outliving its use
+         void set_static_translation(StaticTranslation* translation) noexcept;
+
+         [[nodiscard]] Core core() const noexcept;
          [[nodiscard]] Cycle cycle() const noexcept;
          [[nodiscard]] Accumulator accumulator() const noexcept;
          [[nodiscard]] Index x() const noexcept;
          [[nodiscard]] Index y() const noexcept;
          [[nodiscard]] StackPointer stack_pointer() const noexcept;
          [[nodiscard]] ProcessorStatus processor_status() const noexcept;
+         [[nodiscard]] std::size_t heap_allocations() const noexcept;
+         // reads the interpreting cores threw away without performing, as memory said they had no side effects
+         [[nodiscard]] std::size_t elided_reads() const noexcept;
+         [[nodiscard]] std::size_t fusions() const noexcept;
+         [[nodiscard]] BlockCache const& block_cache() const noexcept;
+         [[nodiscard]] Recompiler const& recompiler() const noexcept;
+         // set once the processor is found stuck; a trap until the next run, anything else until the next reset
+         [[nodiscard]] std::optional<HaltReason> const& halt_reason() const noexcept;
 
          ProgramCounter program_counter{};
 
       private:
+         // Awaited at every cycle boundary of a coroutine instruction. The instruction only suspends there when the
+         // next cycle has to be observed on its own; within the budget of a run, the cycle is accounted and the
+         // instruction carries on.
+         struct CycleBoundary final
+         {
+            Processor& processor;
+
+            [[nodiscard]] bool await_ready() const noexcept;
+            static void await_suspend(std::coroutine_handle<>) noexcept;
+            static void await_resume() noexcept;
+         };
+
+         // the predicate of the run_until in progress, type-erased so the cores test it without being templates
+         struct StopPredicate final
+         {
+            bool (*holds)(void* predicate);
+            void* predicate;
+         };
+
+         // a hooked subroutine that is interpreted to compare where it returns with what its native routine did
+         struct Verification final
+         {
+            HookRegistry::Hook* hook;
+            Cycle start;
+            Cycle cycles;
+            ProgramCounter return_address;
+            HookRegistry::Registers registers;
+            std::unique_ptr<Memory> memory;
+            // the RAM pages the memory is compared with, without their mirrors
+            std::bitset<Memory::PAGES> compared_pages;
+         };
+
+         bool tick_core();
+         bool tick_cycle();
+
          // Addressing modes
-         [[nodiscard]] Instruction relative(BranchOperation operation);
-
-         [[nodiscard]] Instruction immediate(ReadOperation operation) noexcept;
-         [[nodiscard]] Instruction absolute(ReadOperation operation) noexcept;
-         [[nodiscard]] Instruction zero_page(ReadOperation operation) noexcept;
-         [[nodiscard]] Instruction zero_page_indexed(ReadOperation operation, Index index) noexcept;
-         [[nodiscard]] Instruction absolute_indexed(ReadOperation operation, Index index) noexcept;
-         [[nodiscard]] Instruction x_indirect(ReadOperation operation) noexcept;
-         [[nodiscard]] Instruction indirect_y(ReadOperation operation) noexcept;
-
-         [[nodiscard]] Instruction accumulator(ModifyOperation operation) noexcept;
-         [[nodiscard]] Instruction absolute(ModifyOperation operation) noexcept;
-         [[nodiscard]] Instruction zero_page(ModifyOperation operation) noexcept;
-         [[nodiscard]] Instruction zero_page_indexed(ModifyOperation operation, Index index) noexcept;
-         [[nodiscard]] Instruction absolute_indexed(ModifyOperation operation, Index index) noexcept;
-         [[nodiscard]] Instruction x_indirect(ModifyOperation operation) noexcept;
-         [[nodiscard]] Instruction indirect_y(ModifyOperation operation) noexcept;
-
-         [[nodiscard]] Instruction absolute(WriteOperation operation) noexcept;
-         [[nodiscard]] Instruction zero_page(WriteOperation operation) noexcept;
-         [[nodiscard]] Instruction zero_page_indexed(WriteOperation operation, Index index) noexcept;
-         [[nodiscard]] Instruction absolute_indexed(WriteOperation operation, Index index) noexcept;
-         [[nodiscard]] Instruction x_indirect(WriteOperation operation) noexcept;
-         [[nodiscard]] Instruction indirect_y(WriteOperation operation) noexcept;
+         template <BranchOperation OPERATION>
+         [[nodiscard]] Instruction relative();
+
+         template <ReadOperation OPERATION>
+         [[nodiscard]] Instruction immediate() noexcept;
+         template <ReadOperation OPERATION>
+         [[nodiscard]] Instruction absolute() noexcept;
+         template <ReadOperation OPERATION>
+         [[nodiscard]] Instruction zero_page() noexcept;
+         template <ReadOperation OPERATION, Index Processor::* INDEX>
+         [[nodiscard]] Instruction zero_page_indexed() noexcept;
+         template <ReadOperation OPERATION, Index Processor::* INDEX>
+         [[nodiscard]] Instruction absolute_indexed() noexcept;
+         template <ReadOperation OPERATION>
+         [[nodiscard]] Instruction x_indirect() noexcept;
+         template <ReadOperation OPERATION>
+         [[nodiscard]] Instruction indirect_y() noexcept;
+
+         template <ModifyOperation OPERATION>
+         [[nodiscard]] Instruction accumulator() noexcept;
+         template <ModifyOperation OPERATION>
+         [[nodiscard]] Instruction absolute() noexcept;
+         template <ModifyOperation OPERATION>
+         [[nodiscard]] Instruction zero_page() noexcept;
+         template <ModifyOperation OPERATION, Index Processor::* INDEX>
+         [[nodiscard]] Instruction zero_page_indexed() noexcept;
+         template <ModifyOperation OPERATION, Index Processor::* INDEX>
+         [[nodiscard]] Instruction absolute_indexed() noexcept;
+         template <ModifyOperation OPERATION>
+         [[nodiscard]] Instruction x_indirect() noexcept;
+         template <ModifyOperation OPERATION>
+         [[nodiscard]] Instruction indirect_y() noexcept;
+
+         template <WriteOperation OPERATION>
+         [[nodiscard]] Instruction absolute() noexcept;
+         template <WriteOperation OPERATION>
+         [[nodiscard]] Instruction zero_page() noexcept;
+         template <WriteOperation OPERATION, Index Processor::* INDEX>
+         [[nodiscard]] Instruction zero_page_indexed() noexcept;
+         template <WriteOperation OPERATION, Index Processor::* INDEX>
+         [[nodiscard]] Instruction absolute_indexed() noexcept;
+         template <WriteOperation OPERATION>
+         [[nodiscard]] Instruction x_indirect() noexcept;
+         template <WriteOperation OPERATION>
+         [[nodiscard]] Instruction indirect_y() noexcept;
          // ---
 
          // Implied instructions
@@ -388,6 +530,28 @@ namespace nes
          [[nodiscard]] Instruction INX() noexcept;
          [[nodiscard]] Instruction NOP() noexcept;
          [[nodiscard]] Instruction SED() noexcept;
+         [[nodiscard]] Instruction unsupported() noexcept;
+         // ---
+
+         // Dispatch
+         // Every core takes the addressing mode, length and timing of an opcode from OPCODE_INFOS and what it does
+         // from its mnemonic: the operation of that name in the addressing mode, or else the instruction of that name.
+         // The opcodes that are not official are unsupported.
+         using InstructionFactory = Instruction(Processor::*)();
+
+         static std::array<InstructionFactory, 256> const INSTRUCTION_FACTORIES;
+
+         // the operations by mnemonic, nullptr for the mnemonics that are not one of the kind
+         [[nodiscard]] static constexpr BranchOperation branch_operation(std::string_view mnemonic) noexcept;
+         [[nodiscard]] static constexpr ReadOperation read_operation(std::string_view mnemonic) noexcept;
+         [[nodiscard]] static constexpr ModifyOperation modify_operation(std::string_view mnemonic) noexcept;
+         [[nodiscard]] static constexpr WriteOperation write_operation(std::string_view mnemonic) noexcept;
+
+         template <Byte OPCODE>
+         [[nodiscard]] static constexpr InstructionFactory instruction_factory() noexcept;
+         template <auto OPERATION, AddressingMode MODE>
+         [[nodiscard]] static constexpr InstructionFactory addressed_instruction_factory() noexcept;
+         [[nodiscard]] static constexpr InstructionFactory implied_instruction_factory(OpcodeInfo const& info) noexcept;
          // ---
 
          // Branch operations
@@ -431,13 +595,231 @@ namespace nes
          Byte STX() noexcept;
          // ---
 
+         // Instruction-stepped and predecoded cores
+         static std::size_t constexpr MAX_BLOCK_INSTRUCTIONS{ 32 };
+
+         void step();
+         void run_predecoded(Cycle budget);
+
+         [[nodiscard]] PredecodedInstruction predecode(Word address) const noexcept;
+         [[nodiscard]] std::vector<PredecodedInstruction> predecode_block(Word address) const;
+         void execute(PredecodedInstruction const& instruction);
+
+         // the instructions as predecoded from their opcode alone, with their operand still to be fetched
+         static std::array<PredecodedInstruction, 256> const PREDECODED_INSTRUCTIONS;
+
+         [[nodiscard]] static bool ends_block(Opcode opcode) noexcept;
+
+         // Superinstructions
+         struct Fusion final
+         {
+            std::array<Opcode, 3> opcodes;
+            Byte count;
+            PredecodedInstruction::FusedHandler handler;
+         };
+
+         // marks the sequences of the block that run as one fused handler
+         static void fuse(std::vector<PredecodedInstruction>& instructions, Word address) noexcept;
+
+         template <Opcode... OPCODES>
+         [[nodiscard]] static constexpr Fusion fusion() noexcept
+         {
+            return { .opcodes{ OPCODES... }, .count{ sizeof...(OPCODES) }, .handler{ &fused<OPCODES...> } };
+         }
+
+         template <Opcode... OPCODES>
+         static void fused(Processor& processor, PredecodedInstruction const* instructions)
+         {
+            (processor.execute<OPCODES>(*instructions++), ...);
+         }
+
+         // executes like execute, with the handler resolved at compile time
+         template <Opcode OPCODE>
+         void execute(PredecodedInstruction const& instruction);
+         // ---
+
+         template <auto HANDLER>
+         static void handle(Processor& processor, Word const operand)
+         {
+            std::invoke(HANDLER, processor, operand);
+         }
+
+         template <Byte OPCODE>
+         [[nodiscard]] static constexpr PredecodedInstruction predecoded_instruction() noexcept;
+         template <Byte OPCODE>
+         [[nodiscard]] static constexpr PredecodedInstruction::Handler predecoded_handler() noexcept;
+         [[nodiscard]] static constexpr PredecodedInstruction::Handler implied_predecoded_handler(
+            OpcodeInfo const& info) noexcept;
+
+         template <AddressingMode MODE>
+         [[nodiscard]] Word effective_address(Word operand, bool always_fix) noexcept;
+
+         template <BranchOperation OPERATION, Byte OPCODE>
+         void execute_relative(Word operand) noexcept;
+         template <ReadOperation OPERATION, Byte OPCODE>
+         void execute_read(Word operand) noexcept;
+         template <ModifyOperation OPERATION, Byte OPCODE>
+         void execute_modify(Word operand) noexcept;
+         template <WriteOperation OPERATION, Byte OPCODE>
+         void execute_write(Word operand) noexcept;
+         template <ProcessorStatusFlag FLAG, bool SET>
+         void execute_flag(Word operand) noexcept;
+         template <Byte Processor::* SOURCE, Byte Processor::* TARGET>
+         void execute_transfer(Word operand) noexcept;
+         template <Byte Processor::* REGISTER>
+         void execute_increment(Word operand) noexcept;
+         template <Byte Processor::* REGISTER>
+         void execute_decrement(Word operand) noexcept;
+
+         void execute_TXS(Word operand) noexcept;
+         void execute_NOP(Word operand) noexcept;
+         void execute_BRK(Word operand) noexcept;
+         void execute_PHP(Word operand) noexcept;
+         void execute_JSR(Word operand) noexcept;
+         void execute_PLP(Word operand) noexcept;
+         void execute_RTI(Word operand) noexcept;
+         void execute_PHA(Word operand) noexcept;
+         void execute_JMP_absolute(Word operand) noexcept;
+         void execute_RTS(Word operand) noexcept;
+         void execute_PLA(Word operand) noexcept;
+         void execute_JMP_indirect(Word operand) noexcept;
+         void execute_unsupported(Word operand) noexcept;
+         // ---
+
+         // Micro-op core
+         static std::array<Microprogram, 256> const MICROPROGRAMS;
+
+         bool tick_microcoded();
+
+         template <Byte OPCODE>
+         [[nodiscard]] static constexpr Microprogram microprogram() noexcept;
+         [[nodiscard]] static constexpr Microprogram implied_microprogram(OpcodeInfo const& info) noexcept;
+
+         template <auto MICRO_OP>
+         static bool micro_op(Processor& processor)
+         {
+            return std::invoke(MICRO_OP, processor);
+         }
+
+         template <auto... MICRO_OPS>
+         [[nodiscard]] static constexpr Microprogram microcoded() noexcept
+         {
+            static_assert(sizeof...(MICRO_OPS) <= Microprogram::MAX_LENGTH);
+            return { .micro_ops{ &micro_op<MICRO_OPS>... }, .length{ sizeof...(MICRO_OPS) } };
+         }
+
+         // prepends the micro-ops forming the effective address of the mode to the given ones
+         template <AddressingMode MODE, bool ALWAYS_FIX, auto... MICRO_OPS>
+         [[nodiscard]] static constexpr Microprogram microcoded_addressed() noexcept;
+
+         template <BranchOperation OPERATION>
+         [[nodiscard]] static constexpr Microprogram microcoded_relative() noexcept;
+         template <ReadOperation OPERATION, AddressingMode MODE>
+         [[nodiscard]] static constexpr Microprogram microcoded_read() noexcept;
+         template <ModifyOperation OPERATION, AddressingMode MODE>
+         [[nodiscard]] static constexpr Microprogram microcoded_modify() noexcept;
+         template <WriteOperation OPERATION, AddressingMode MODE>
+         [[nodiscard]] static constexpr Microprogram microcoded_write() noexcept;
+
+         bool micro_fetch_address_low() noexcept;
+         bool micro_fetch_address_high() noexcept;
+         template <Index Processor::* INDEX>
+         bool micro_fetch_address_high_indexed() noexcept;
+         template <Index Processor::* INDEX>
+         bool micro_index_zero_page() noexcept;
+         bool micro_fetch_pointer() noexcept;
+         bool micro_index_pointer() noexcept;
+         bool micro_fetch_pointed_low() noexcept;
+         bool micro_fetch_pointed_high() noexcept;
+         bool micro_fetch_pointed_high_indexed() noexcept;
+         bool micro_fix_address() noexcept;
+
+         template <ReadOperation OPERATION>
+         bool micro_read_immediate() noexcept;
+         template <ReadOperation OPERATION>
+         bool micro_read() noexcept;
+         template <ReadOperation OPERATION>
+         bool micro_read_indexed() noexcept;
+         template <ModifyOperation OPERATION>
+         bool micro_modify_accumulator() noexcept;
+         bool micro_read_value() noexcept;
+         template <ModifyOperation OPERATION>
+         bool micro_modify() noexcept;
+         bool micro_write_value() noexcept;
+         template <WriteOperation OPERATION>
+         bool micro_write() noexcept;
+
+         bool micro_fetch_operand() noexcept;
+         template <BranchOperation OPERATION>
+         bool micro_branch() noexcept;
+         bool micro_branch_taken() noexcept;
+         bool micro_branch_page_crossed() noexcept;
+         bool micro_prefetch(Byte opcode) noexcept;
+
+         template <ProcessorStatusFlag FLAG, bool SET>
+         bool micro_flag() noexcept;
+         template <Byte Processor::* SOURCE, Byte Processor::* TARGET>
+         bool micro_transfer() noexcept;
+         template <Byte Processor::* REGISTER>
+         bool micro_increment() noexcept;
+         template <Byte Processor::* REGISTER>
+         bool micro_decrement() noexcept;
+         bool micro_TXS() noexcept;
+         bool micro_NOP() noexcept;
+
+         bool micro_read_next() noexcept;
+         bool micro_internal_operation() noexcept;
+         bool micro_increment_stack_pointer() noexcept;
+         bool micro_push_program_counter_high() noexcept;
+         bool micro_push_program_counter_low() noexcept;
+         bool micro_pull_program_counter_low() noexcept;
+         bool micro_pull_program_counter_high() noexcept;
+         bool micro_increment_program_counter() noexcept;
+         bool micro_jump() noexcept;
+         bool micro_jump_indirect() noexcept;
+         bool micro_BRK_fetch_padding() noexcept;
+         bool micro_BRK_push_program_counter_high() noexcept;
+         bool micro_BRK_push_processor_status() noexcept;
+         bool micro_BRK_fetch_vector_low() noexcept;
+         bool micro_BRK_fetch_vector_high() noexcept;
+         bool micro_PHP() noexcept;
+         bool micro_PHA() noexcept;
+         bool micro_PLP() noexcept;
+         bool micro_PLA() noexcept;
+         bool micro_RTI_pull_processor_status() noexcept;
+         bool micro_unsupported() noexcept;
+         // ---
+
          // Helper functions
          [[nodiscard]] Instruction instruction_from_opcode(Opcode opcode);
+         // called as the instruction at the head of a loop starts, whatever part of it the core already did, with the
+         // opcode the core fetched
+         void skip_idle_loop(Word head, Opcode opcode) noexcept;
+         // halts on the current opcode for good, spending what is left of the budget of a run
+         void freeze() noexcept;
+         // called at clean instruction boundaries with hooks installed, returns whether a native routine ran in place
+         // of the instruction
+         bool run_hook();
+         void finish_verification() noexcept;
+         // called at instruction boundaries, returns whether the predicate of the run_until in progress holds there
+         [[nodiscard]] bool stop_requested();
+         [[nodiscard]] bool frozen() const noexcept;
 
          void change_processor_status_flag(ProcessorStatusFlag flag, bool set) noexcept;
          [[nodiscard]] bool processor_status_flag(ProcessorStatusFlag flag) const noexcept;
          void update_zero_and_negative_flag(Byte value) noexcept;
-
+         void resolve_processor_status() noexcept;
+         // takes P off the stack, which cannot clear B and the unused bit, as those are not held in the processor
+         void pull_processor_status() noexcept;
+         void add_decimal(Byte value) noexcept;
+         void subtract_decimal(Byte value) noexcept;
+         void apply_decimal(DecimalResult const& decimal) noexcept;
+         void apply_binary(BinaryResult const& binary) noexcept;
+         // sets C and leaves Z and N to the result, which it returns, as comparisons, shifts and rotates do
+         Byte apply_carry(BinaryResult const& binary) noexcept;
+
+         // a read whose value is thrown away, which only matters to memory with read side effects
+         void dummy_read(Word address) noexcept;
          void write_to_stack(Byte value) const noexcept;
          [[nodiscard]] Byte read_from_stack() const noexcept;
 
@@ -446,22 +828,174 @@ namespace nes
          [[nodiscard]] static constexpr Word assemble_word(Byte high, Byte low) noexcept;
          [[nodiscard]] static constexpr Word assign_low_byte(Word target, Byte value) noexcept;
          [[nodiscard]] static constexpr Word assign_high_byte(Word target, Byte value) noexcept;
+         [[nodiscard]] static constexpr Word indirect_jump_high_address(Word pointer) noexcept;
          [[nodiscard]] static constexpr std::pair<Byte, bool> add_with_overflow(Byte left, Byte right) noexcept;
          [[nodiscard]] static constexpr std::pair<Byte, SignedByte> add_with_overflow(Byte left, SignedByte right) noexcept;
          // ---
 
          Memory& memory_;
+         Core core_{ Core::CYCLE_STEPPED };
 
          Cycle cycle_{};
+         Cycle cycle_limit_{};
+         StopPredicate stop_predicate_{};
          Accumulator accumulator_{};
          Index x_{};
          Index y_{};
          StackPointer stack_pointer_{ 0xFF };
          ProcessorStatus processor_status_{};
+         Byte zero_and_negative_source_{};
+         bool zero_and_negative_pending_{};
 
          Opcode current_opcode_{};
-         std::optional<Instruction> current_instruction_{ RST() };
+         FramePool frame_pool_{};
+         BlockCache block_cache_{ memory_ };
+         Recompiler recompiler_{ memory_, block_cache_ };
+         Instruction current_instruction_{ RST() };
+         MicrocodeState microcode_state_{};
+         Profiler* profiler_{};
+         bool fusion_{};
+         std::size_t fusions_{};
+         HookRegistry* hooks_{};
+         StaticTranslation* static_translation_{};
+         std::optional<Verification> verification_{};
+         std::size_t elided_reads_{};
+         std::optional<HaltReason> halt_reason_{};
    };
+
+   constexpr Processor::BranchOperation Processor::branch_operation(std::string_view const mnemonic) noexcept
+   {
+      if (mnemonic == "BPL")
+         return &Processor::BPL;
+      if (mnemonic == "BMI")
+         return &Processor::BMI;
+      if (mnemonic == "BVC")
+         return &Processor::BVC;
+      if (mnemonic == "BVS")
+         return &Processor::BVS;
+      if (mnemonic == "BCC")
+         return &Processor::BCC;
+      if (mnemonic == "BCS")
+         return &Processor::BCS;
+      if (mnemonic == "BNE")
+         return &Processor::BNE;
+      if (mnemonic == "BEQ")
+         return &Processor::BEQ;
+
+      return nullptr;
+   }
+
+   constexpr Processor::ReadOperation Processor::read_operation(std::string_view const mnemonic) noexcept
+   {
+      if (mnemonic == "ORA")
+         return &Processor::ORA;
+      if (mnemonic == "AND")
+         return &Processor::AND;
+      if (mnemonic == "BIT")
+         return &Processor::BIT;
+      if (mnemonic == "EOR")
+         return &Processor::EOR;
+      if (mnemonic == "ADC")
+         return &Processor::ADC;
+      if (mnemonic == "LDY")
+         return &Processor::LDY;
+      if (mnemonic == "LDA")
+         return &Processor::LDA;
+      if (mnemonic == "LDX")
+         return &Processor::LDX;
+      if (mnemonic == "CPY")
+         return &Processor::CPY;
+      if (mnemonic == "CMP")
+         return &Processor::CMP;
+      if (mnemonic == "CPX")
+         return &Processor::CPX;
+      if (mnemonic == "SBC")
+         return &Processor::SBC;
+
+      return nullptr;
+   }
+
+   constexpr Processor::ModifyOperation Processor::modify_operation(std::string_view const mnemonic) noexcept
+   {
+      if (mnemonic == "ASL")
+         return &Processor::ASL;
+      if (mnemonic == "ROL")
+         return &Processor::ROL;
+      if (mnemonic == "LSR")
+         return &Processor::LSR;
+      if (mnemonic == "ROR")
+         return &Processor::ROR;
+      if (mnemonic == "DEC")
+         return &Processor::DEC;
+      if (mnemonic == "INC")
+         return &Processor::INC;
+
+      return nullptr;
+   }
+
+   constexpr Processor::WriteOperation Processor::write_operation(std::string_view const mnemonic) noexcept
+   {
+      if (mnemonic == "STA")
+         return &Processor::STA;
+      if (mnemonic == "STY")
+         return &Processor::STY;
+      if (mnemonic == "STX")
+         return &Processor::STX;
+
+      return nullptr;
+   }
+
+   constexpr Byte Processor::low_byte(Word const source) noexcept
+   {
+      return static_cast<Byte>(source);
+   }
+
+   constexpr Byte Processor::high_byte(Word const source) noexcept
+   {
+      return source >> 8;
+   }
+
+   constexpr Word Processor::assemble_word(Byte const high, Byte const low) noexcept
+   {
+      return high << 8 | low;
+   }
+
+   constexpr Word Processor::assign_low_byte(Word const target, Byte const value) noexcept
+   {
+      return assemble_word(high_byte(target), value);
+   }
+
+   constexpr Word Processor::assign_high_byte(Word const target, Byte const value) noexcept
+   {
+      return assemble_word(value, low_byte(target));
+   }
+
+   constexpr Word Processor::indirect_jump_high_address(Word const pointer) noexcept
+   {
+      if constexpr (Variant::INDIRECT_JUMP_WRAPS)
+         return assign_low_byte(pointer, low_byte(pointer) + 1);
+      else
+         return pointer + 1;
+   }
+
+   constexpr std::pair<Byte, bool> Processor::add_with_overflow(Byte const left, Byte const right) noexcept
+   {
+      auto const result{ static_cast<Byte>(left + right) };
+      return { result, result < left };
+   }
+
+   constexpr std::pair<Byte, SignedByte> Processor::add_with_overflow(Byte const left, SignedByte const right) noexcept
+   {
+      auto const result{ static_cast<Byte>(left + right) };
+
+      SignedByte overflow;
+      if (right < 0)
+         overflow = result > left ? -1 : 0;
+      else
+         overflow = result < left ? 1 : 0;
+
+      return { result, overflow };
+   }
 }
 
 #endif
\ No newline at end of file
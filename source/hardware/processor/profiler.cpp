@@ -0,0 +1,68 @@
+#include "profiler.hpp"
+#include "opcode_info.hpp"
+
+namespace nes
+{
+   void Profiler::record(Byte const opcode) noexcept
+   {
+      ++counts_[opcode];
+      if (previous_)
+         ++pair_counts_[*previous_ << 8 | opcode];
+
+      previous_ = opcode;
+   }
+
+   void Profiler::clear() noexcept
+   {
+      counts_.fill(0);
+      std::ranges::fill(pair_counts_, 0);
+      previous_.reset();
+   }
+
+   std::size_t Profiler::count(Byte const opcode) const noexcept
+   {
+      return counts_[opcode];
+   }
+
+   std::size_t Profiler::count(Byte const first, Byte const second) const noexcept
+   {
+      return pair_counts_[first << 8 | second];
+   }
+
+   std::vector<Profiler::Entry> Profiler::report() const
+   {
+      std::vector<Entry> entries{};
+      for (std::size_t opcode{}; opcode < counts_.size(); ++opcode)
+      {
+         if (not counts_[opcode])
+            continue;
+
+         OpcodeInfo const& info{ OPCODE_INFOS[opcode] };
+         entries.push_back({
+            .opcode{ static_cast<Byte>(opcode) },
+            .mnemonic{ info.mnemonic },
+            .mode{ info.mode },
+            .count{ counts_[opcode] },
+            .cycles{ counts_[opcode] * info.cycles }
+         });
+      }
+
+      std::ranges::stable_sort(entries, std::ranges::greater{}, &Entry::count);
+      return entries;
+   }
+
+   std::vector<Profiler::Pair> Profiler::pair_report() const
+   {
+      std::vector<Pair> pairs{};
+      for (std::size_t pair{}; pair < pair_counts_.size(); ++pair)
+         if (pair_counts_[pair])
+            pairs.push_back({
+               .first{ static_cast<Byte>(pair >> 8) },
+               .second{ static_cast<Byte>(pair) },
+               .count{ pair_counts_[pair] }
+            });
+
+      std::ranges::stable_sort(pairs, std::ranges::greater{}, &Pair::count);
+      return pairs;
+   }
+}
\ No newline at end of file
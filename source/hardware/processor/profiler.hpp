@@ -0,0 +1,59 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include "addressing_mode.hpp"
+#include "hardware/types.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   // Counts the instructions a processor starts, by opcode and by pairs of opcodes started one after the other.
+   // Attached to a processor, it sees everything the interpreting cores execute; blocks that run as recompiled code
+   // are not counted.
+   class Profiler final
+   {
+      public:
+         struct Entry final
+         {
+            Byte opcode;
+            std::string_view mnemonic;
+            AddressingMode mode;
+            std::size_t count;
+            // lower bound, page crossings and taken branches are not seen by the profiler
+            Cycle cycles;
+         };
+
+         struct Pair final
+         {
+            Byte first;
+            Byte second;
+            std::size_t count;
+         };
+
+         Profiler() = default;
+         Profiler(Profiler const&) = delete;
+         Profiler(Profiler&&) = delete;
+
+         ~Profiler() noexcept = default;
+
+         Profiler& operator=(Profiler const&) = delete;
+         Profiler& operator=(Profiler&&) = delete;
+
+         void record(Byte opcode) noexcept;
+         void clear() noexcept;
+
+         [[nodiscard]] std::size_t count(Byte opcode) const noexcept;
+         [[nodiscard]] std::size_t count(Byte first, Byte second) const noexcept;
+         // the opcodes executed so far, most frequent first
+         [[nodiscard]] std::vector<Entry> report() const;
+         // the pairs of opcodes executed so far, most frequent first
+         [[nodiscard]] std::vector<Pair> pair_report() const;
+
+      private:
+         std::array<std::size_t, 256> counts_{};
+         std::vector<std::size_t> pair_counts_ = std::vector<std::size_t>(256 * 256);
+         std::optional<Byte> previous_{};
+   };
+}
+
+#endif
\ No newline at end of file
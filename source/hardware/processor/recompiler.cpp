@@ -0,0 +1,1127 @@
+#include "recompiler.hpp"
+#include "opcode_info.hpp"
+#include "processor.hpp"
+
+namespace nes
+{
+   Recompiler::Recompiler(Memory& memory, BlockCache const& block_cache) noexcept
+      : block_cache_{ block_cache }
+   {
+      context_.memory = memory.data_.data();
+      context_.pages = memory.pages_.data();
+      context_.watchers_by_address = memory.write_watchers_by_address_.data();
+      context_.dirty_pages = memory.dirty_pages_.data();
+      context_.read_side_effects = memory.read_side_effects_.data();
+      context_.bus = &memory;
+      context_.block_cache = &block_cache;
+
+      auto const cast{
+         [](Processor::ProcessorStatusFlag const flag)
+         {
+            return static_cast<std::underlying_type_t<Processor::ProcessorStatusFlag>>(flag);
+         }
+      };
+
+      for (std::size_t value{}; value < context_.zero_and_negative.size(); ++value)
+         context_.zero_and_negative[value] = static_cast<Byte>(
+            (value ? 0 : cast(Processor::ProcessorStatusFlag::Z)) | (value & cast(Processor::ProcessorStatusFlag::N)));
+   }
+
+   Recompiler::~Recompiler() noexcept
+   {
+      unmap_code_buffer();
+   }
+
+   void Recompiler::map_code_buffer() noexcept
+   {
+      #if defined(__linux__) and defined(__x86_64__)
+      if (code_buffer_)
+         return;
+
+      // writable until translations are put into it, page by page
+      void* const code_buffer{
+         mmap(nullptr, CODE_BUFFER_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)
+      };
+      if (code_buffer not_eq MAP_FAILED)
+         code_buffer_ = static_cast<std::uint8_t*>(code_buffer);
+      #endif
+   }
+
+   void Recompiler::unmap_code_buffer() noexcept
+   {
+      #if defined(__linux__) and defined(__x86_64__)
+      if (code_buffer_)
+         munmap(code_buffer_, CODE_BUFFER_SIZE);
+      #endif
+
+      code_buffer_ = nullptr;
+      code_size_ = 0;
+      translations_.clear();
+   }
+
+   bool Recompiler::run(BlockCache::Block const& block, Processor& processor, Cycle const budget)
+   {
+      if (not code_buffer_)
+         return false;
+
+      // translations addressing the RAM directly only stand in for memory with nothing else mapped
+      bool const direct{ context_.bus->flat() };
+      auto const [entry, inserted]{ translations_.try_emplace(block.first) };
+      Translation& translation{ entry->second };
+      if (inserted or translation.serial not_eq block.serial or translation.direct not_eq direct)
+         translation = { .serial{ block.serial }, .runs{}, .code{}, .worst_case_cycles{}, .direct{ direct } };
+
+      if (not translation.code)
+      {
+         // a block is translated once, when it becomes hot; blocks that could not be translated stay interpreted
+         if (++translation.runs not_eq HOT_BLOCK_THRESHOLD)
+            return false;
+
+         if (code_size_ + MAX_TRANSLATION_SIZE > CODE_BUFFER_SIZE)
+         {
+            // out of code space, start over; what is still hot gets translated again soon enough
+            translations_.clear();
+            code_size_ = 0;
+            return false;
+         }
+
+         // failing to protect the code buffer drops it, and with it every translation
+         direct_ = direct;
+         Translation const translated{ translate_protected(block) };
+         if (not code_buffer_)
+            return false;
+
+         translation = translated;
+         if (not translation.code)
+            return false;
+      }
+
+      if (translation.worst_case_cycles > budget)
+         return false;
+
+      context_.generation = block_cache_.generation();
+      context_.cycle = processor.cycle_;
+      context_.accumulator = processor.accumulator_;
+      context_.x = processor.x_;
+      context_.y = processor.y_;
+      context_.stack_pointer = processor.stack_pointer_;
+      processor.resolve_processor_status();
+      context_.processor_status = processor.processor_status_;
+      context_.elided_reads = 0;
+
+      translation.code(&context_);
+
+      processor.cycle_ = context_.cycle;
+      processor.program_counter = static_cast<Word>(context_.program_counter);
+      processor.accumulator_ = static_cast<Byte>(context_.accumulator);
+      processor.x_ = static_cast<Byte>(context_.x);
+      processor.y_ = static_cast<Byte>(context_.y);
+      processor.stack_pointer_ = static_cast<Byte>(context_.stack_pointer);
+      processor.processor_status_ = static_cast<Byte>(context_.processor_status);
+      processor.elided_reads_ += context_.elided_reads;
+      ++native_runs_;
+      return true;
+   }
+
+   std::size_t Recompiler::translations() const noexcept
+   {
+      return translated_blocks_;
+   }
+
+   std::size_t Recompiler::native_runs() const noexcept
+   {
+      return native_runs_;
+   }
+
+   Recompiler::Translation Recompiler::translate_protected(BlockCache::Block const& block) noexcept
+   {
+      #if defined(__linux__) and defined(__x86_64__)
+      // the pages may hold the end of the translation before, which cannot run while they are writable
+      auto const page_size{ static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) };
+      std::size_t const first{ code_size_ / page_size * page_size };
+      std::size_t const last{ std::min((code_size_ + MAX_TRANSLATION_SIZE + page_size - 1) / page_size * page_size,
+         CODE_BUFFER_SIZE) };
+      std::span const pages{ code_buffer_ + first, last - first };
+      if (not protect(pages, true))
+         return { .serial{ block.serial }, .runs{}, .code{}, .worst_case_cycles{}, .direct{ direct_ } };
+
+      Translation const translation{ translate(block) };
+
+      // translations that cannot be made executable are of no use, nor are those sharing their pages
+      if (not protect(pages, false))
+      {
+         unmap_code_buffer();
+         return { .serial{ block.serial }, .runs{}, .code{}, .worst_case_cycles{}, .direct{ direct_ } };
+      }
+
+      return translation;
+      #else
+      return translate(block);
+      #endif
+   }
+
+   bool Recompiler::protect(std::span<std::uint8_t> const pages, bool const writable) noexcept
+   {
+      #if defined(__linux__) and defined(__x86_64__)
+      return mprotect(pages.data(), pages.size(), writable ? PROT_READ | PROT_WRITE : PROT_READ | PROT_EXEC) == 0;
+      #else
+      std::ignore = pages;
+      std::ignore = writable;
+      return false;
+      #endif
+   }
+
+   Recompiler::Translation Recompiler::translate(BlockCache::Block const& block) noexcept
+   {
+      cursor_ = code_buffer_ + code_size_;
+      auto const code{ reinterpret_cast<Code>(cursor_) };
+      emit_prologue();
+
+      Cycle cycles{};
+      Cycle worst_case_cycles{};
+      Word address{ block.first };
+      bool exited{};
+      auto const flag{
+         [](Processor::ProcessorStatusFlag const flag)
+         {
+            return static_cast<std::underlying_type_t<Processor::ProcessorStatusFlag>>(flag);
+         }
+      };
+
+      for (PredecodedInstruction const& instruction : block.instructions)
+      {
+         auto const decoded{ decode(instruction.opcode) };
+         if (not decoded)
+            break;
+
+         auto const [operation, mode]{ *decoded };
+         OpcodeInfo const& info{ OPCODE_INFOS[instruction.opcode] };
+         auto const next{ static_cast<Word>(address + instruction.length) };
+         if (operation == Operation::JMP)
+         {
+            emit_exit(instruction.operand, cycles + info.cycles);
+            worst_case_cycles += info.cycles;
+            exited = true;
+            break;
+         }
+
+         if (mode == AddressingMode::RELATIVE)
+         {
+            auto const target{ static_cast<Word>(next + static_cast<SignedByte>(instruction.operand)) };
+            switch (operation)
+            {
+               case Operation::BPL:
+                  emit_branch(flag(Processor::ProcessorStatusFlag::N), false, next, target, cycles);
+                  break;
+
+               case Operation::BMI:
+                  emit_branch(flag(Processor::ProcessorStatusFlag::N), true, next, target, cycles);
+                  break;
+
+               case Operation::BVC:
+                  emit_branch(flag(Processor::ProcessorStatusFlag::V), false, next, target, cycles);
+                  break;
+
+               case Operation::BVS:
+                  emit_branch(flag(Processor::ProcessorStatusFlag::V), true, next, target, cycles);
+                  break;
+
+               case Operation::BCC:
+                  emit_branch(flag(Processor::ProcessorStatusFlag::C), false, next, target, cycles);
+                  break;
+
+               case Operation::BCS:
+                  emit_branch(flag(Processor::ProcessorStatusFlag::C), true, next, target, cycles);
+                  break;
+
+               case Operation::BNE:
+                  emit_branch(flag(Processor::ProcessorStatusFlag::Z), false, next, target, cycles);
+                  break;
+
+               default:
+                  emit_branch(flag(Processor::ProcessorStatusFlag::Z), true, next, target, cycles);
+                  break;
+            }
+
+            worst_case_cycles += info.predicted_cycles(true, true);
+            exited = true;
+            break;
+         }
+
+         if constexpr (Variant::DECIMAL_MODE)
+            if (operation == Operation::ADC or operation == Operation::SBC)
+            {
+               // decimal arithmetic is left to the interpreter, which a block starting with it is left to entirely
+               if (address == block.first)
+                  break;
+
+               test(PROCESSOR_STATUS, std::uint32_t{ flag(Processor::ProcessorStatusFlag::D) });
+               std::size_t const binary{ jump(EQUAL) };
+               emit_exit(address, cycles);
+               land(binary);
+            }
+
+         translate(operation, mode, instruction.operand, next, cycles + info.cycles);
+         cycles += info.cycles;
+         worst_case_cycles += info.predicted_cycles(true);
+         address = next;
+      }
+
+      // nothing worth translating, leave the block to the interpreter
+      if (not exited and address == block.first)
+         return {
+            .serial{ block.serial },
+            .runs{ HOT_BLOCK_THRESHOLD },
+            .code{},
+            .worst_case_cycles{},
+            .direct{ direct_ }
+         };
+
+      if (not exited)
+         emit_exit(address, cycles);
+
+      code_size_ = static_cast<std::size_t>(cursor_ - code_buffer_);
+      ++translated_blocks_;
+      return {
+         .serial{ block.serial },
+         .runs{ HOT_BLOCK_THRESHOLD },
+         .code{ code },
+         .worst_case_cycles{ worst_case_cycles },
+         .direct{ direct_ }
+      };
+   }
+
+   void Recompiler::translate(Operation const operation, AddressingMode const mode, Word const operand, Word const next,
+      Cycle const cycles) noexcept
+   {
+      auto const flag{
+         [](Processor::ProcessorStatusFlag const flag)
+         {
+            return static_cast<std::underlying_type_t<Processor::ProcessorStatusFlag>>(flag);
+         }
+      };
+
+      switch (operation)
+      {
+         case Operation::LDA:
+            emit_read(mode, operand);
+            mov(ACCUMULATOR, RCX);
+            return emit_zero_and_negative(ACCUMULATOR);
+
+         case Operation::LDX:
+            emit_read(mode, operand);
+            mov(X, RCX);
+            return emit_zero_and_negative(X);
+
+         case Operation::LDY:
+            emit_read(mode, operand);
+            mov(Y, RCX);
+            return emit_zero_and_negative(Y);
+
+         case Operation::STA:
+            emit_effective_address(mode, operand, false);
+            mov(RCX, ACCUMULATOR);
+            return emit_write(next, cycles);
+
+         case Operation::STX:
+            emit_effective_address(mode, operand, false);
+            mov(RCX, X);
+            return emit_write(next, cycles);
+
+         case Operation::STY:
+            emit_effective_address(mode, operand, false);
+            mov(RCX, Y);
+            return emit_write(next, cycles);
+
+         case Operation::ORA:
+            emit_read(mode, operand);
+            arithmetic(OR, ACCUMULATOR, RCX);
+            return emit_zero_and_negative(ACCUMULATOR);
+
+         case Operation::AND:
+            emit_read(mode, operand);
+            arithmetic(AND, ACCUMULATOR, RCX);
+            return emit_zero_and_negative(ACCUMULATOR);
+
+         case Operation::EOR:
+            emit_read(mode, operand);
+            arithmetic(XOR, ACCUMULATOR, RCX);
+            return emit_zero_and_negative(ACCUMULATOR);
+
+         case Operation::ADC:
+            emit_read(mode, operand);
+            return emit_add_with_carry();
+
+         case Operation::SBC:
+            // subtracting is adding the one's complement
+            emit_read(mode, operand);
+            arithmetic(XOR, RCX, 0xFFu);
+            return emit_add_with_carry();
+
+         case Operation::CMP:
+            emit_read(mode, operand);
+            return emit_compare(ACCUMULATOR);
+
+         case Operation::CPX:
+            emit_read(mode, operand);
+            return emit_compare(X);
+
+         case Operation::CPY:
+            emit_read(mode, operand);
+            return emit_compare(Y);
+
+         case Operation::BIT:
+         {
+            // N and V are copied from the value, Z is set if value AND accumulator is zero
+            emit_read(mode, operand);
+            mov(RDX, RCX);
+            arithmetic(AND, RDX, 0xC0u);
+            emit_flags(flag(Processor::ProcessorStatusFlag::N) | flag(Processor::ProcessorStatusFlag::V)
+               | flag(Processor::ProcessorStatusFlag::Z), RDX);
+            test(ACCUMULATOR, RCX);
+            set(EQUAL, RDX);
+            shift(SHL, RDX, 1);
+            return arithmetic(OR, PROCESSOR_STATUS, RDX);
+         }
+
+         case Operation::ASL:
+         case Operation::LSR:
+         case Operation::ROL:
+         case Operation::ROR:
+            if (mode == AddressingMode::ACCUMULATOR)
+            {
+               mov(RCX, ACCUMULATOR);
+               emit_shift(operation);
+               return mov(ACCUMULATOR, RCX);
+            }
+
+            emit_effective_address(mode, operand, false);
+            emit_load(RCX, RAX, 0);
+            mov(R10, RCX);
+            emit_shift(operation);
+            emit_write_back(next, cycles);
+            return emit_write(next, cycles);
+
+         case Operation::INC:
+         case Operation::DEC:
+            emit_effective_address(mode, operand, false);
+            emit_load(RCX, RAX, 0);
+            mov(R10, RCX);
+            arithmetic(operation == Operation::INC ? ADD : SUB, RCX, 1u);
+            arithmetic(AND, RCX, 0xFFu);
+            emit_zero_and_negative(RCX);
+            emit_write_back(next, cycles);
+            return emit_write(next, cycles);
+
+         case Operation::INX:
+         case Operation::INY:
+         case Operation::DEX:
+         case Operation::DEY:
+         {
+            Register const target{ operation == Operation::INX or operation == Operation::DEX ? X : Y };
+            arithmetic(operation == Operation::INX or operation == Operation::INY ? ADD : SUB, target, 1u);
+            arithmetic(AND, target, 0xFFu);
+            return emit_zero_and_negative(target);
+         }
+
+         case Operation::TAX:
+            mov(X, ACCUMULATOR);
+            return emit_zero_and_negative(X);
+
+         case Operation::TAY:
+            mov(Y, ACCUMULATOR);
+            return emit_zero_and_negative(Y);
+
+         case Operation::TXA:
+            mov(ACCUMULATOR, X);
+            return emit_zero_and_negative(ACCUMULATOR);
+
+         case Operation::TYA:
+            mov(ACCUMULATOR, Y);
+            return emit_zero_and_negative(ACCUMULATOR);
+
+         case Operation::TSX:
+            load(X, offsetof(Context, stack_pointer));
+            return emit_zero_and_negative(X);
+
+         case Operation::TXS:
+            return store(offsetof(Context, stack_pointer), X);
+
+         case Operation::CLC:
+            return arithmetic(AND, PROCESSOR_STATUS, ~std::uint32_t{ flag(Processor::ProcessorStatusFlag::C) });
+
+         case Operation::SEC:
+            return arithmetic(OR, PROCESSOR_STATUS, std::uint32_t{ flag(Processor::ProcessorStatusFlag::C) });
+
+         case Operation::CLI:
+            return arithmetic(AND, PROCESSOR_STATUS, ~std::uint32_t{ flag(Processor::ProcessorStatusFlag::I) });
+
+         case Operation::SEI:
+            return arithmetic(OR, PROCESSOR_STATUS, std::uint32_t{ flag(Processor::ProcessorStatusFlag::I) });
+
+         case Operation::CLV:
+            return arithmetic(AND, PROCESSOR_STATUS, ~std::uint32_t{ flag(Processor::ProcessorStatusFlag::V) });
+
+         case Operation::CLD:
+            return arithmetic(AND, PROCESSOR_STATUS, ~std::uint32_t{ flag(Processor::ProcessorStatusFlag::D) });
+
+         case Operation::SED:
+            return arithmetic(OR, PROCESSOR_STATUS, std::uint32_t{ flag(Processor::ProcessorStatusFlag::D) });
+
+         case Operation::PHA:
+            emit_dummy_read({}, next);
+            return emit_push(ACCUMULATOR, next, cycles);
+
+         case Operation::PHP:
+            emit_dummy_read({}, next);
+            arithmetic(OR, PROCESSOR_STATUS,
+               std::uint32_t{ flag(Processor::ProcessorStatusFlag::B) | flag(Processor::ProcessorStatusFlag::_) });
+            return emit_push(PROCESSOR_STATUS, next, cycles);
+
+         case Operation::PLA:
+            emit_dummy_read({}, next);
+            emit_pull();
+            mov(ACCUMULATOR, RCX);
+            return emit_zero_and_negative(ACCUMULATOR);
+
+         case Operation::PLP:
+            emit_dummy_read({}, next);
+            emit_pull();
+            arithmetic(AND, PROCESSOR_STATUS,
+               std::uint32_t{ flag(Processor::ProcessorStatusFlag::B) | flag(Processor::ProcessorStatusFlag::_) });
+            return arithmetic(OR, PROCESSOR_STATUS, RCX);
+
+         default:
+            return;
+      }
+   }
+
+   std::uint32_t Recompiler::read(Context* const context, std::uint32_t const address) noexcept
+   {
+      return context->bus->read(static_cast<Word>(address));
+   }
+
+   bool Recompiler::write(Context* const context, std::uint32_t const address, std::uint32_t const value) noexcept
+   {
+      context->bus->write(static_cast<Word>(address), static_cast<Byte>(value));
+      return context->block_cache->generation() not_eq context->generation;
+   }
+
+   void Recompiler::emit_prologue() noexcept
+   {
+      // save the callee-saved registers, keeping the stack 16-byte aligned for calls into Memory
+      for (Register const saved : { RBX, RBP, R12, R13, R14, R15 })
+         push(saved);
+
+      emit_register_operand({ 0x81 }, static_cast<Register>(SUB), RSP, true);
+      emit_32(8);
+
+      mov(CONTEXT, RDI, true);
+      load(MEMORY, offsetof(Context, memory), true);
+      load(ACCUMULATOR, offsetof(Context, accumulator));
+      load(X, offsetof(Context, x));
+      load(Y, offsetof(Context, y));
+      load(PROCESSOR_STATUS, offsetof(Context, processor_status));
+   }
+
+   void Recompiler::emit_exit(Word const program_counter, Cycle const cycles) noexcept
+   {
+      add_cycles(cycles);
+      store_immediate(offsetof(Context, program_counter), program_counter);
+      store(offsetof(Context, accumulator), ACCUMULATOR);
+      store(offsetof(Context, x), X);
+      store(offsetof(Context, y), Y);
+      store(offsetof(Context, processor_status), PROCESSOR_STATUS);
+
+      emit_register_operand({ 0x81 }, static_cast<Register>(ADD), RSP, true);
+      emit_32(8);
+      for (Register const saved : { R15, R14, R13, R12, RBP, RBX })
+         pop(saved);
+
+      emit({ 0xC3 });
+   }
+
+   void Recompiler::emit_branch(Byte const flag, bool const taken_if_set, Word const next, Word const target,
+      Cycle const cycles) noexcept
+   {
+      // a taken branch costs a cycle more reading the opcode after it, and another one reading the opcode at the
+      // unfixed target if it lands on a different page
+      bool const crosses_page{ static_cast<bool>((next ^ target) >> 8) };
+      test(PROCESSOR_STATUS, std::uint32_t{ flag });
+      std::size_t const not_taken{ jump(taken_if_set ? EQUAL : NOT_EQUAL) };
+      emit_dummy_read({}, next);
+      if (crosses_page)
+         emit_dummy_read({}, (next & 0xFF'00) | (target & 0xFF));
+
+      emit_exit(target, cycles + 3 + crosses_page);
+      land(not_taken);
+      emit_exit(next, cycles + 2);
+   }
+
+   void Recompiler::emit_effective_address(AddressingMode const mode, Word const operand,
+      bool const page_crossing_costs) noexcept
+   {
+      // the instructions whose timing does not count crossing a page always read from the unfixed address
+      auto const operand_low{ static_cast<Byte>(operand) };
+      switch (mode)
+      {
+         case AddressingMode::ZERO_PAGE_X:
+         case AddressingMode::ZERO_PAGE_Y:
+            // the processor reads the zero page address while it adds the index to it
+            emit_dummy_read({}, operand_low);
+            mov(RAX, mode == AddressingMode::ZERO_PAGE_X ? X : Y);
+            arithmetic(ADD, RAX, std::uint32_t{ operand_low });
+            return arithmetic(AND, RAX, 0xFFu);
+
+         case AddressingMode::ABSOLUTE_X:
+         case AddressingMode::ABSOLUTE_Y:
+         {
+            Register const index{ mode == AddressingMode::ABSOLUTE_X ? X : Y };
+            std::optional<std::size_t> same_page{};
+            if (page_crossing_costs)
+            {
+               // the index overflowing the low byte of the address crosses a page (+)
+               arithmetic(CMP, index, std::uint32_t{ 0xFFu - operand_low });
+               same_page = jump(BELOW_OR_EQUAL);
+               add_cycles(1);
+            }
+
+            mov(RDX, index);
+            arithmetic(ADD, RDX, std::uint32_t{ operand_low });
+            arithmetic(AND, RDX, 0xFFu);
+            arithmetic(OR, RDX, std::uint32_t{ operand & 0xFF'00u });
+            emit_dummy_read(RDX, 0);
+            if (same_page)
+               land(*same_page);
+
+            mov(RAX, index);
+            arithmetic(ADD, RAX, std::uint32_t{ operand });
+            return arithmetic(AND, RAX, 0xFF'FFu);
+         }
+
+         case AddressingMode::X_INDIRECT:
+            // the processor reads the pointer address while it adds X to it
+            emit_dummy_read({}, operand_low);
+            mov(RCX, X);
+            arithmetic(ADD, RCX, std::uint32_t{ operand_low });
+            arithmetic(AND, RCX, 0xFFu);
+            emit_load(RAX, RCX, 0);
+            arithmetic(ADD, RCX, 1u);
+            arithmetic(AND, RCX, 0xFFu);
+            emit_load(RCX, RCX, 0);
+            shift(SHL, RCX, 8);
+            return arithmetic(OR, RAX, RCX);
+
+         case AddressingMode::INDIRECT_Y:
+         {
+            emit_load(RAX, {}, operand_low);
+            emit_load(RCX, {}, static_cast<Byte>(operand_low + 1));
+            mov(RDX, RAX);
+            arithmetic(ADD, RDX, Y);
+            std::optional<std::size_t> same_page{};
+            if (page_crossing_costs)
+            {
+               // the index overflowing the low byte of the address crosses a page (+)
+               arithmetic(CMP, RDX, 0xFFu);
+               same_page = jump(BELOW_OR_EQUAL);
+               add_cycles(1);
+            }
+
+            arithmetic(AND, RDX, 0xFFu);
+            mov(RSI, RCX);
+            shift(SHL, RSI, 8);
+            arithmetic(OR, RDX, RSI);
+            emit_dummy_read(RDX, 0);
+            if (same_page)
+               land(*same_page);
+
+            shift(SHL, RCX, 8);
+            arithmetic(OR, RAX, RCX);
+            arithmetic(ADD, RAX, Y);
+            return arithmetic(AND, RAX, 0xFF'FFu);
+         }
+
+         default:
+            return mov_immediate(RAX, operand);
+      }
+   }
+
+   void Recompiler::emit_read(AddressingMode const mode, Word const operand) noexcept
+   {
+      if (mode == AddressingMode::IMMEDIATE)
+         return mov_immediate(RCX, static_cast<Byte>(operand));
+
+      if (mode == AddressingMode::ZERO_PAGE or mode == AddressingMode::ABSOLUTE)
+         return emit_load(RCX, {}, operand);
+
+      emit_effective_address(mode, operand, true);
+      emit_load(RCX, RAX, 0);
+   }
+
+   void Recompiler::emit_load(Register const target, std::optional<Register> const address,
+      std::int32_t const displacement) noexcept
+   {
+      if (direct_)
+         return load_byte(target, MEMORY, address, displacement);
+
+      // like Memory::read, RSI holding the address and RDI the memory behind its page
+      if (address)
+      {
+         mov(RSI, *address);
+         if (displacement)
+            arithmetic(ADD, RSI, static_cast<std::uint32_t>(displacement));
+      }
+      else
+         mov_immediate(RSI, static_cast<std::uint32_t>(displacement));
+
+      emit_page_entry(RDI, RSI, offsetof(Memory::Page, read));
+      emit_register_operand({ 0x85 }, RDI, RDI, true); // test rdi, rdi
+      std::size_t const device{ jump(EQUAL) };
+      mov(R9, RSI);
+      arithmetic(AND, R9, 0xFFu);
+      load_byte(target, RDI, R9, 0);
+      std::size_t const loaded{ jump({}) };
+
+      // let Memory read the device
+      land(device);
+      emit_read_call();
+      mov(target, R8);
+
+      land(loaded);
+   }
+
+   void Recompiler::emit_dummy_read(std::optional<Register> const address, std::int32_t const displacement) noexcept
+   {
+      // like Processor::dummy_read, counting the reads memory says can be left out
+      if (address)
+      {
+         mov(RSI, *address);
+         if (displacement)
+            arithmetic(ADD, RSI, static_cast<std::uint32_t>(displacement));
+      }
+      else
+         mov_immediate(RSI, static_cast<std::uint32_t>(displacement));
+
+      mov(R9, RSI);
+      shift(SHR, R9, 8);
+      load(R8, offsetof(Context, read_side_effects), true);
+      emit_memory_operand({ 0x80 }, static_cast<Register>(CMP), R8, R9, 0);
+      emit({ 0x00 });
+      std::size_t const side_effects{ jump(NOT_EQUAL) };
+      emit_memory_operand({ 0x83 }, static_cast<Register>(ADD), CONTEXT, {},
+         static_cast<std::int32_t>(offsetof(Context, elided_reads)), true);
+      emit({ 0x01 });
+      std::size_t const elided{ jump({}) };
+
+      land(side_effects);
+      emit_read_call();
+      land(elided);
+   }
+
+   void Recompiler::emit_read_call() noexcept
+   {
+      for (Register const saved : { RAX, RCX, RDX, RSI })
+         push(saved);
+      mov(RDI, CONTEXT, true);
+      mov_address(RAX, reinterpret_cast<std::uintptr_t>(&Recompiler::read));
+      call(RAX);
+      mov(R8, RAX);
+      for (Register const saved : { RSI, RDX, RCX, RAX })
+         pop(saved);
+   }
+
+   void Recompiler::emit_page_entry(Register const target, Register const address, std::size_t const field) noexcept
+   {
+      mov(target, address);
+      shift(SHR, target, 8);
+      emit_register_operand({ 0x6B }, target, target, true); // imul target, target, sizeof(Memory::Page)
+      emit({ sizeof(Memory::Page) });
+      load(R8, offsetof(Context, pages), true);
+      emit_memory_operand({ 0x8B }, target, R8, target, static_cast<std::int32_t>(field), true);
+   }
+
+   void Recompiler::emit_write(Word const next, Cycle const cycles) noexcept
+   {
+      // the value in RCX goes to the address in RAX, straight to memory unless a watcher is interested in it
+      load(RDX, offsetof(Context, watchers_by_address), true);
+      emit_memory_operand({ 0x80 }, static_cast<Register>(CMP), RDX, RAX, 0);
+      emit({ 0x00 });
+      std::size_t const watched{ jump(NOT_EQUAL) };
+      std::optional<std::size_t> device{};
+      if (direct_)
+         store_byte(MEMORY, RAX, RCX);
+      else
+      {
+         // like Memory::write, through the page table, leaving the pages without memory to write to Memory
+         emit_page_entry(RDI, RAX, offsetof(Memory::Page, write));
+         emit_register_operand({ 0x85 }, RDI, RDI, true); // test rdi, rdi
+         device = jump(EQUAL);
+         mov(RSI, RAX);
+         arithmetic(AND, RSI, 0xFFu);
+         store_byte(RDI, RSI, RCX);
+      }
+
+      // like Memory::write, set the bit of the page written
+      mov(RDX, RAX);
+      shift(SHR, RDX, 8);
+      load(RSI, offsetof(Context, dirty_pages), true);
+      emit_memory_operand({ 0x0F, 0xAB }, RDX, RSI, {}, 0); // bts [rsi], edx
+      std::size_t const written{ jump({}) };
+
+      // let Memory notify the watchers or the device and leave the block if that dropped any block
+      land(watched);
+      if (device)
+         land(*device);
+      mov(RDI, CONTEXT, true);
+      mov(RSI, RAX);
+      mov(RDX, RCX);
+      mov_address(RAX, reinterpret_cast<std::uintptr_t>(&Recompiler::write));
+      call(RAX);
+      emit_register_operand({ 0x84 }, RAX, RAX); // test al, al
+      std::size_t const kept{ jump(EQUAL) };
+      emit_exit(next, cycles);
+
+      land(kept);
+      land(written);
+   }
+
+   void Recompiler::emit_write_back(Word const next, Cycle const cycles) noexcept
+   {
+      // rewriting RAM only matters to the watchers of the address, which Memory notifies like devices
+      load(RDX, offsetof(Context, watchers_by_address), true);
+      emit_memory_operand({ 0x80 }, static_cast<Register>(CMP), RDX, RAX, 0);
+      emit({ 0x00 });
+      std::size_t const watched{ jump(NOT_EQUAL) };
+      std::optional<std::size_t> ram{};
+      if (direct_)
+         ram = jump({});
+      else
+      {
+         emit_page_entry(RDI, RAX, offsetof(Memory::Page, write));
+         emit_register_operand({ 0x85 }, RDI, RDI, true); // test rdi, rdi
+         ram = jump(NOT_EQUAL);
+      }
+
+      land(watched);
+      push(RAX);
+      push(RCX);
+      mov(RDI, CONTEXT, true);
+      mov(RSI, RAX);
+      mov(RDX, R10);
+      mov_address(RAX, reinterpret_cast<std::uintptr_t>(&Recompiler::write));
+      call(RAX);
+      mov(R8, RAX);
+      pop(RCX);
+      pop(RAX);
+      emit_register_operand({ 0x84 }, R8, R8); // test r8b, r8b
+      std::size_t const kept{ jump(EQUAL) };
+
+      // the device dropped blocks, so the new value is left to Memory as well before leaving the block
+      mov(RDI, CONTEXT, true);
+      mov(RSI, RAX);
+      mov(RDX, RCX);
+      mov_address(RAX, reinterpret_cast<std::uintptr_t>(&Recompiler::write));
+      call(RAX);
+      emit_exit(next, cycles);
+
+      land(kept);
+      land(*ram);
+   }
+
+   void Recompiler::emit_push(Register const value, Word const next, Cycle const cycles) noexcept
+   {
+      // the stack pointer is decremented before the write, which may leave the block
+      load(RAX, offsetof(Context, stack_pointer));
+      mov(RDX, RAX);
+      arithmetic(SUB, RDX, 1u);
+      arithmetic(AND, RDX, 0xFFu);
+      store(offsetof(Context, stack_pointer), RDX);
+      arithmetic(OR, RAX, 0x01'00u);
+      mov(RCX, value);
+      emit_write(next, cycles);
+   }
+
+   void Recompiler::emit_pull() noexcept
+   {
+      load(RAX, offsetof(Context, stack_pointer));
+      arithmetic(ADD, RAX, 1u);
+      arithmetic(AND, RAX, 0xFFu);
+      store(offsetof(Context, stack_pointer), RAX);
+      emit_load(RCX, RAX, 0x01'00);
+   }
+
+   void Recompiler::emit_zero_and_negative(Register const value) noexcept
+   {
+      arithmetic(AND, PROCESSOR_STATUS, ~0x82u);
+      load_byte(RDX, CONTEXT, value, offsetof(Context, zero_and_negative));
+      arithmetic(OR, PROCESSOR_STATUS, RDX);
+   }
+
+   void Recompiler::emit_flags(Byte const cleared, Register const set) noexcept
+   {
+      arithmetic(AND, PROCESSOR_STATUS, ~std::uint32_t{ cleared });
+      arithmetic(OR, PROCESSOR_STATUS, set);
+   }
+
+   void Recompiler::emit_add_with_carry() noexcept
+   {
+      // RAX = accumulator + value + C
+      mov(RAX, PROCESSOR_STATUS);
+      arithmetic(AND, RAX, 1u);
+      arithmetic(ADD, RAX, ACCUMULATOR);
+      arithmetic(ADD, RAX, RCX);
+
+      // V set if the sign of the result differs from the signs of both operands
+      mov(RDX, ACCUMULATOR);
+      arithmetic(XOR, RDX, RAX);
+      arithmetic(XOR, RCX, RAX);
+      arithmetic(AND, RDX, RCX);
+      arithmetic(AND, RDX, 0x80u);
+      shift(SHR, RDX, 1);
+      emit_flags(0b11'00'00'11, RDX);
+
+      // C set if there was a carry-out
+      mov(RDX, RAX);
+      shift(SHR, RDX, 8);
+      arithmetic(OR, PROCESSOR_STATUS, RDX);
+
+      mov(ACCUMULATOR, RAX);
+      arithmetic(AND, ACCUMULATOR, 0xFFu);
+      emit_zero_and_negative(ACCUMULATOR);
+   }
+
+   void Recompiler::emit_compare(Register const value) noexcept
+   {
+      // C set if the register is not below the value
+      mov(RAX, value);
+      arithmetic(SUB, RAX, RCX);
+      set(ABOVE_OR_EQUAL, RDX);
+      emit_flags(0b10'00'00'11, RDX);
+      arithmetic(AND, RAX, 0xFFu);
+      emit_zero_and_negative(RAX);
+   }
+
+   void Recompiler::emit_shift(Operation const operation) noexcept
+   {
+      // shifts the value in RCX, collecting the new C in RDX
+      if (operation == Operation::ROL or operation == Operation::ROR)
+      {
+         mov(RSI, PROCESSOR_STATUS);
+         arithmetic(AND, RSI, 1u);
+         if (operation == Operation::ROR)
+            shift(SHL, RSI, 7);
+      }
+
+      mov(RDX, RCX);
+      if (operation == Operation::ASL or operation == Operation::ROL)
+      {
+         shift(SHR, RDX, 7);
+         shift(SHL, RCX, 1);
+      }
+      else
+      {
+         arithmetic(AND, RDX, 1u);
+         shift(SHR, RCX, 1);
+      }
+
+      if (operation == Operation::ROL or operation == Operation::ROR)
+         arithmetic(OR, RCX, RSI);
+
+      arithmetic(AND, RCX, 0xFFu);
+      emit_flags(0b00'00'00'01, RDX);
+      emit_zero_and_negative(RCX);
+   }
+
+   void Recompiler::emit(std::initializer_list<std::uint8_t> const bytes) noexcept
+   {
+      for (std::uint8_t const byte : bytes)
+         *cursor_++ = byte;
+   }
+
+   void Recompiler::emit_32(std::uint32_t const value) noexcept
+   {
+      std::memcpy(cursor_, &value, sizeof value);
+      cursor_ += sizeof value;
+   }
+
+   void Recompiler::emit_64(std::uint64_t const value) noexcept
+   {
+      std::memcpy(cursor_, &value, sizeof value);
+      cursor_ += sizeof value;
+   }
+
+   void Recompiler::emit_register_operand(std::initializer_list<std::uint8_t> const opcode, Register const reg,
+      Register const rm, bool const wide) noexcept
+   {
+      auto const rex{ static_cast<std::uint8_t>(0x40 | wide << 3 | (reg >> 3) << 2 | rm >> 3) };
+      if (rex not_eq 0x40)
+         emit({ rex });
+
+      emit(opcode);
+      emit({ static_cast<std::uint8_t>(0b11'000'000 | (reg & 7) << 3 | (rm & 7)) });
+   }
+
+   void Recompiler::emit_memory_operand(std::initializer_list<std::uint8_t> const opcode, Register const reg,
+      Register const base, std::optional<Register> const index, std::int32_t const displacement,
+      bool const wide) noexcept
+   {
+      // always [base + index + disp32] through a SIB byte, an index of RSP meaning no index
+      Register const index_register{ index.value_or(RSP) };
+      auto const rex{
+         static_cast<std::uint8_t>(0x40 | wide << 3 | (reg >> 3) << 2 | (index_register >> 3) << 1 | base >> 3)
+      };
+      if (rex not_eq 0x40)
+         emit({ rex });
+
+      emit(opcode);
+      emit({ static_cast<std::uint8_t>(0b10'000'100 | (reg & 7) << 3) });
+      emit({ static_cast<std::uint8_t>((index_register & 7) << 3 | (base & 7)) });
+      emit_32(static_cast<std::uint32_t>(displacement));
+   }
+
+   void Recompiler::mov(Register const target, Register const source, bool const wide) noexcept
+   {
+      emit_register_operand({ 0x89 }, source, target, wide);
+   }
+
+   void Recompiler::mov_immediate(Register const target, std::uint32_t const value) noexcept
+   {
+      if (target >= R8)
+         emit({ 0x41 });
+      emit({ static_cast<std::uint8_t>(0xB8 + (target & 7)) });
+      emit_32(value);
+   }
+
+   void Recompiler::mov_address(Register const target, std::uintptr_t const address) noexcept
+   {
+      emit({ static_cast<std::uint8_t>(0x48 | target >> 3), static_cast<std::uint8_t>(0xB8 + (target & 7)) });
+      emit_64(address);
+   }
+
+   void Recompiler::load(Register const target, std::size_t const offset, bool const wide) noexcept
+   {
+      emit_memory_operand({ 0x8B }, target, CONTEXT, {}, static_cast<std::int32_t>(offset), wide);
+   }
+
+   void Recompiler::store(std::size_t const offset, Register const source) noexcept
+   {
+      emit_memory_operand({ 0x89 }, source, CONTEXT, {}, static_cast<std::int32_t>(offset));
+   }
+
+   void Recompiler::store_immediate(std::size_t const offset, std::uint32_t const value) noexcept
+   {
+      emit_memory_operand({ 0xC7 }, RAX, CONTEXT, {}, static_cast<std::int32_t>(offset));
+      emit_32(value);
+   }
+
+   void Recompiler::add_cycles(Cycle const cycles) noexcept
+   {
+      if (not cycles)
+         return;
+
+      emit_memory_operand({ 0x81 }, static_cast<Register>(ADD), CONTEXT, {}, offsetof(Context, cycle), true);
+      emit_32(static_cast<std::uint32_t>(cycles));
+   }
+
+   void Recompiler::load_byte(Register const target, Register const base, std::optional<Register> const index,
+      std::int32_t const displacement) noexcept
+   {
+      emit_memory_operand({ 0x0F, 0xB6 }, target, base, index, displacement);
+   }
+
+   void Recompiler::store_byte(Register const base, Register const index, Register const source) noexcept
+   {
+      emit_memory_operand({ 0x88 }, source, base, index, 0);
+   }
+
+   void Recompiler::arithmetic(Arithmetic const operation, Register const target, std::uint32_t const value) noexcept
+   {
+      emit_register_operand({ 0x81 }, static_cast<Register>(operation), target);
+      emit_32(value);
+   }
+
+   void Recompiler::arithmetic(Arithmetic const operation, Register const target, Register const source) noexcept
+   {
+      emit_register_operand({ static_cast<std::uint8_t>(operation << 3 | 1) }, source, target);
+   }
+
+   void Recompiler::shift(Shift const operation, Register const target, Byte const count) noexcept
+   {
+      emit_register_operand({ 0xC1 }, static_cast<Register>(operation), target);
+      emit({ count });
+   }
+
+   void Recompiler::test(Register const left, Register const right) noexcept
+   {
+      emit_register_operand({ 0x85 }, right, left);
+   }
+
+   void Recompiler::test(Register const left, std::uint32_t const right) noexcept
+   {
+      emit_register_operand({ 0xF7 }, RAX, left);
+      emit_32(right);
+   }
+
+   void Recompiler::set(Condition const condition, Register const target) noexcept
+   {
+      // setcc only writes the low byte, so zero extend it
+      emit_register_operand({ 0x0F, static_cast<std::uint8_t>(0x90 + condition) }, RAX, target);
+      emit_register_operand({ 0x0F, 0xB6 }, target, target);
+   }
+
+   void Recompiler::call(Register const target) noexcept
+   {
+      emit_register_operand({ 0xFF }, static_cast<Register>(2), target);
+   }
+
+   void Recompiler::push(Register const source) noexcept
+   {
+      if (source >= R8)
+         emit({ 0x41 });
+      emit({ static_cast<std::uint8_t>(0x50 + (source & 7)) });
+   }
+
+   void Recompiler::pop(Register const target) noexcept
+   {
+      if (target >= R8)
+         emit({ 0x41 });
+      emit({ static_cast<std::uint8_t>(0x58 + (target & 7)) });
+   }
+
+   std::size_t Recompiler::jump(std::optional<Condition> const condition) noexcept
+   {
+      if (condition)
+         emit({ 0x0F, static_cast<std::uint8_t>(0x80 + *condition) });
+      else
+         emit({ 0xE9 });
+
+      auto const displacement{ static_cast<std::size_t>(cursor_ - code_buffer_) };
+      emit_32(0);
+      return displacement;
+   }
+
+   void Recompiler::land(std::size_t const jump) noexcept
+   {
+      auto const target{ static_cast<std::int32_t>(cursor_ - code_buffer_ - static_cast<std::ptrdiff_t>(jump) - 4) };
+      std::memcpy(code_buffer_ + jump, &target, sizeof target);
+   }
+
+   std::optional<std::pair<Recompiler::Operation, AddressingMode>> Recompiler::decode(Byte const opcode) noexcept
+   {
+      // in the order of the operations; BRK, JSR, RTI, RTS and JMP (indirect) are left to the interpreter, as are the
+      // unsupported opcodes
+      std::array<std::string_view, 52> constexpr MNEMONICS{
+         "LDA", "LDX", "LDY", "STA", "STX", "STY", "ORA", "AND", "EOR", "ADC", "SBC", "CMP", "CPX", "CPY",
+         "BIT", "ASL", "LSR", "ROL", "ROR", "INC", "DEC", "INX", "INY", "DEX", "DEY", "TAX", "TAY", "TXA",
+         "TYA", "TSX", "TXS", "CLC", "SEC", "CLI", "SEI", "CLV", "CLD", "SED", "NOP", "PHA", "PLA", "PHP",
+         "PLP", "JMP", "BPL", "BMI", "BVC", "BVS", "BCC", "BCS", "BNE", "BEQ"
+      };
+
+      OpcodeInfo const& info{ OPCODE_INFOS[opcode] };
+      auto const mnemonic{ std::ranges::find(MNEMONICS, info.mnemonic) };
+      if (not info.official or mnemonic == MNEMONICS.end() or info.mode == AddressingMode::INDIRECT)
+         return std::nullopt;
+
+      return std::pair{ static_cast<Operation>(mnemonic - MNEMONICS.begin()), info.mode };
+   }
+}
\ No newline at end of file
@@ -0,0 +1,220 @@
+#ifndef RECOMPILER_HPP
+#define RECOMPILER_HPP
+
+#include "addressing_mode.hpp"
+#include "block_cache.hpp"
+#include "hardware/memory/memory.hpp"
+#include "pch.hpp"
+#include "utility/constants.hpp"
+
+namespace nes
+{
+   class Processor;
+
+   // Translates hot blocks of the block cache into x86-64 code. A/X/Y/P live in host registers while a translation
+   // runs; S stays in the context, as only the stack instructions touch it and they go to memory anyway. While memory
+   // is flat, accesses go straight to the RAM. Otherwise they go through the page table like Memory's own, and call
+   // back into Memory for the pages attached to devices, which see the same accesses as under the interpreter: the
+   // dummy reads of pages with read side effects, and the value a read-modify-write instruction writes back. Writes
+   // also call back when a watcher is interested in the written address. Cycles are accounted at the block exits.
+   // Blocks are only translated up to the first instruction the recompiler does not handle, which is left to the
+   // interpreter, as is everything on hosts other than Linux x86-64. The code buffer is only mapped once the
+   // recompiled core is selected, and none of its pages is ever writable and executable at once.
+   class Recompiler final
+   {
+      public:
+         static bool constexpr SUPPORTED{ LINUX_X86_64 };
+         static std::size_t constexpr HOT_BLOCK_THRESHOLD{ 16 };
+         static std::size_t constexpr CODE_BUFFER_SIZE{ 4 * 1024 * 1024 };
+
+         Recompiler(Memory& memory, BlockCache const& block_cache) noexcept;
+         Recompiler(Recompiler const&) = delete;
+         Recompiler(Recompiler&&) = delete;
+
+         ~Recompiler() noexcept;
+
+         Recompiler& operator=(Recompiler const&) = delete;
+         Recompiler& operator=(Recompiler&&) = delete;
+
+         // maps the code buffer unless it already is; without one, every block is left to the interpreter
+         void map_code_buffer() noexcept;
+         // runs the translation of the block, provided the block is hot, was translatable and cannot exceed the budget
+         [[nodiscard]] bool run(BlockCache::Block const& block, Processor& processor, Cycle budget);
+
+         [[nodiscard]] std::size_t translations() const noexcept;
+         [[nodiscard]] std::size_t native_runs() const noexcept;
+
+      private:
+         // everything translated code touches, addressed relative to the context register
+         struct Context final
+         {
+            Byte* memory;
+            Memory::Page const* pages;
+            std::uint8_t const* watchers_by_address;
+            std::uint64_t* dirty_pages;
+         bool const* read_side_effects;
+            Memory* bus;
+            BlockCache const* block_cache;
+            std::size_t generation;
+            Cycle cycle;
+            std::uint32_t program_counter;
+            std::uint32_t accumulator;
+            std::uint32_t x;
+            std::uint32_t y;
+            std::uint32_t stack_pointer;
+            std::uint32_t processor_status;
+            std::size_t elided_reads;
+            std::array<Byte, 256> zero_and_negative;
+         };
+
+         using Code = void(*)(Context* context);
+
+         struct Translation final
+         {
+            std::size_t serial;
+            std::size_t runs;
+            Code code;
+            Cycle worst_case_cycles;
+            // whether the translation addresses the RAM directly, which only holds while memory is flat
+            bool direct;
+         };
+
+         enum class Operation
+         {
+            LDA, LDX, LDY, STA, STX, STY,
+            ORA, AND, EOR, ADC, SBC, CMP, CPX, CPY, BIT,
+            ASL, LSR, ROL, ROR, INC, DEC,
+            INX, INY, DEX, DEY, TAX, TAY, TXA, TYA, TSX, TXS,
+            CLC, SEC, CLI, SEI, CLV, CLD, SED, NOP,
+            PHA, PLA, PHP, PLP,
+            JMP, BPL, BMI, BVC, BVS, BCC, BCS, BNE, BEQ
+         };
+
+         enum Register : std::uint8_t
+         {
+            RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI,
+            R8, R9, R10, R11, R12, R13, R14, R15
+         };
+
+         enum Arithmetic : std::uint8_t
+         {
+            ADD = 0,
+            OR = 1,
+            AND = 4,
+            SUB = 5,
+            XOR = 6,
+            CMP = 7
+         };
+
+         enum Shift : std::uint8_t
+         {
+            SHL = 4,
+            SHR = 5
+         };
+
+         enum Condition : std::uint8_t
+         {
+            BELOW = 0x2,
+            ABOVE_OR_EQUAL = 0x3,
+            EQUAL = 0x4,
+            NOT_EQUAL = 0x5,
+            BELOW_OR_EQUAL = 0x6
+         };
+
+         static Register constexpr CONTEXT{ RBX };
+         static Register constexpr MEMORY{ RBP };
+         static Register constexpr ACCUMULATOR{ R12 };
+         static Register constexpr X{ R13 };
+         static Register constexpr Y{ R14 };
+         static Register constexpr PROCESSOR_STATUS{ R15 };
+
+         // generous bound on the code a single block can be translated into
+         static std::size_t constexpr MAX_TRANSLATION_SIZE{ 16 * 1024 };
+
+         // translates the block with the pages it may take writable for as long as that takes, and executable after
+         [[nodiscard]] Translation translate_protected(BlockCache::Block const& block) noexcept;
+         [[nodiscard]] Translation translate(BlockCache::Block const& block) noexcept;
+         [[nodiscard]] static bool protect(std::span<std::uint8_t> pages, bool writable) noexcept;
+         void unmap_code_buffer() noexcept;
+         void translate(Operation operation, AddressingMode mode, Word operand, Word next, Cycle cycles) noexcept;
+
+         static std::uint32_t read(Context* context, std::uint32_t address) noexcept;
+         static bool write(Context* context, std::uint32_t address, std::uint32_t value) noexcept;
+
+         // Code generation
+         void emit_prologue() noexcept;
+         void emit_exit(Word program_counter, Cycle cycles) noexcept;
+         void emit_branch(Byte flag, bool taken_if_set, Word next, Word target, Cycle cycles) noexcept;
+         void emit_effective_address(AddressingMode mode, Word operand, bool page_crossing_costs) noexcept;
+         void emit_read(AddressingMode mode, Word operand) noexcept;
+         // reads the byte at the address, the register plus the displacement, into the target
+         void emit_load(Register target, std::optional<Register> address, std::int32_t displacement) noexcept;
+         // reads the byte at the address and throws it away, unless memory says that has no side effects
+         void emit_dummy_read(std::optional<Register> address, std::int32_t displacement) noexcept;
+         // calls back into Memory to read the address in RSI into R8, keeping the registers the translation is in the
+         // middle of using
+         void emit_read_call() noexcept;
+         // loads the field of the page table entry of the address into the target
+         void emit_page_entry(Register target, Register address, std::size_t field) noexcept;
+         void emit_write(Word next, Cycle cycles) noexcept;
+         // writes the value read, in R10, back to the address in RAX before the new value in RCX goes there, as
+         // read-modify-write instructions do; only devices and watchers notice, so RAM is otherwise left alone
+         void emit_write_back(Word next, Cycle cycles) noexcept;
+         void emit_push(Register value, Word next, Cycle cycles) noexcept;
+         void emit_pull() noexcept;
+         void emit_zero_and_negative(Register value) noexcept;
+         void emit_flags(Byte cleared, Register set) noexcept;
+         void emit_add_with_carry() noexcept;
+         void emit_compare(Register value) noexcept;
+         void emit_shift(Operation operation) noexcept;
+         // ---
+
+         // Instruction encoding
+         void emit(std::initializer_list<std::uint8_t> bytes) noexcept;
+         void emit_32(std::uint32_t value) noexcept;
+         void emit_64(std::uint64_t value) noexcept;
+         void emit_register_operand(std::initializer_list<std::uint8_t> opcode, Register reg, Register rm,
+            bool wide = false) noexcept;
+         void emit_memory_operand(std::initializer_list<std::uint8_t> opcode, Register reg, Register base,
+            std::optional<Register> index, std::int32_t displacement, bool wide = false) noexcept;
+
+         void mov(Register target, Register source, bool wide = false) noexcept;
+         void mov_immediate(Register target, std::uint32_t value) noexcept;
+         void mov_address(Register target, std::uintptr_t address) noexcept;
+         void load(Register target, std::size_t offset, bool wide = false) noexcept;
+         void store(std::size_t offset, Register source) noexcept;
+         void store_immediate(std::size_t offset, std::uint32_t value) noexcept;
+         void add_cycles(Cycle cycles) noexcept;
+         void load_byte(Register target, Register base, std::optional<Register> index,
+            std::int32_t displacement) noexcept;
+         void store_byte(Register base, Register index, Register source) noexcept;
+         void arithmetic(Arithmetic operation, Register target, std::uint32_t value) noexcept;
+         void arithmetic(Arithmetic operation, Register target, Register source) noexcept;
+         void shift(Shift operation, Register target, Byte count) noexcept;
+         void test(Register left, Register right) noexcept;
+         void test(Register left, std::uint32_t right) noexcept;
+         void set(Condition condition, Register target) noexcept;
+         void call(Register target) noexcept;
+         void push(Register source) noexcept;
+         void pop(Register target) noexcept;
+         [[nodiscard]] std::size_t jump(std::optional<Condition> condition) noexcept;
+         void land(std::size_t jump) noexcept;
+         // ---
+
+         [[nodiscard]] static std::optional<std::pair<Operation, AddressingMode>> decode(Byte opcode) noexcept;
+
+         BlockCache const& block_cache_;
+         Context context_{};
+
+         std::unordered_map<Word, Translation> translations_{};
+         std::uint8_t* code_buffer_{};
+         std::size_t code_size_{};
+         std::uint8_t* cursor_{};
+         bool direct_{};
+
+         std::size_t translated_blocks_{};
+         std::size_t native_runs_{};
+   };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,558 @@
+#include "static_recompiler.hpp"
+#include "disassembler.hpp"
+#include "hook_registry.hpp"
+
+namespace nes
+{
+   namespace
+   {
+      // what every generated translation unit starts with: the state of a block and the operations its
+      // instructions share
+      std::string_view constexpr PRELUDE{
+         R"(#include "hardware/processor/binary.hpp"
+#include "hardware/processor/decimal.hpp"
+#include "hardware/processor/static_translation.hpp"
+
+namespace
+{
+   using namespace nes;
+
+   using Context = StaticTranslation::Context;
+
+   struct Registers final
+   {
+      Byte a;
+      Byte x;
+      Byte y;
+      Byte s;
+      Byte p;
+   };
+
+   enum Flag : Byte
+   {
+      C = 0b00'00'00'01,
+      Z = 0b00'00'00'10,
+      I = 0b00'00'01'00,
+      D = 0b00'00'10'00,
+      B = 0b00'01'00'00,
+      _ = 0b00'10'00'00,
+      V = 0b01'00'00'00,
+      N = 0b10'00'00'00
+   };
+
+   [[maybe_unused]] Registers enter(Context const& context)
+   {
+      return { context.accumulator, context.x, context.y, context.stack_pointer, context.processor_status };
+   }
+
+   [[maybe_unused]] void leave(Context& context, Registers const& r, Word const program_counter, Cycle const cycles)
+   {
+      context.cycles = cycles;
+      context.program_counter = program_counter;
+      context.accumulator = r.a;
+      context.x = r.x;
+      context.y = r.y;
+      context.stack_pointer = r.s;
+      context.processor_status = r.p;
+   }
+
+   [[maybe_unused]] void change(Registers& r, Flag const flag, bool const set)
+   {
+      r.p = static_cast<Byte>(set ? r.p | flag : r.p & ~flag);
+   }
+
+   [[maybe_unused]] Byte zero_and_negative(Registers& r, Byte const value)
+   {
+      change(r, Z, not value);
+      change(r, N, value & N);
+      return value;
+   }
+
+   // a pointer in the zero page, whose high byte wraps around to the start of the page
+   [[maybe_unused]] Word pointer(Memory const& memory, Byte const address)
+   {
+      Byte const low{ memory.read(address) };
+      return static_cast<Word>(memory.read(static_cast<Byte>(address + 1)) << 8 | low);
+   }
+
+   [[maybe_unused]] void push(Memory& memory, Registers& r, Byte const value)
+   {
+      memory.write(static_cast<Word>(0x01'00 | r.s), value);
+      --r.s;
+   }
+
+   [[maybe_unused]] Byte pull(Memory const& memory, Registers& r)
+   {
+      ++r.s;
+      return memory.read(static_cast<Word>(0x01'00 | r.s));
+   }
+
+   [[maybe_unused]] void apply(Registers& r, BinaryResult const& binary)
+   {
+      change(r, C, binary.carry);
+      change(r, V, binary.overflow);
+      r.a = zero_and_negative(r, binary.result);
+   }
+
+   [[maybe_unused]] void apply(Registers& r, DecimalResult const& decimal)
+   {
+      change(r, C, decimal.carry);
+      change(r, V, decimal.overflow);
+      change(r, Z, decimal.zero);
+      change(r, N, decimal.negative);
+      r.a = decimal.result;
+   }
+
+   [[maybe_unused]] void adc(Registers& r, Byte const value)
+   {
+      if constexpr (Variant::DECIMAL_MODE)
+         if (r.p & D)
+            return apply(r, add_decimal(r.a, value, r.p & C));
+
+      apply(r, add_binary(r.a, value, r.p & C));
+   }
+
+   [[maybe_unused]] void sbc(Registers& r, Byte const value)
+   {
+      if constexpr (Variant::DECIMAL_MODE)
+         if (r.p & D)
+            return apply(r, subtract_decimal(r.a, value, r.p & C));
+
+      apply(r, subtract_binary(r.a, value, r.p & C));
+   }
+
+   [[maybe_unused]] void compare(Registers& r, Byte const left, Byte const right)
+   {
+      BinaryResult const binary{ compare_binary(left, right) };
+      change(r, C, binary.carry);
+      zero_and_negative(r, binary.result);
+   }
+
+   [[maybe_unused]] void bit(Registers& r, Byte const value)
+   {
+      change(r, N, value & N);
+      change(r, V, value & V);
+      change(r, Z, not(value & r.a));
+   }
+
+   // what a shift or rotate leaves behind, the bit shifted out going to C
+   [[maybe_unused]] Byte shifted(Registers& r, BinaryResult const& binary)
+   {
+      change(r, C, binary.carry);
+      return zero_and_negative(r, binary.result);
+   }
+)"
+      };
+
+      // the flag a branch tests and the value it branches on
+      std::unordered_map<std::string_view, std::pair<std::string_view, bool>> const BRANCHES{
+         { "BPL", { "N", false } },
+         { "BMI", { "N", true } },
+         { "BVC", { "V", false } },
+         { "BVS", { "V", true } },
+         { "BCC", { "C", false } },
+         { "BCS", { "C", true } },
+         { "BNE", { "Z", false } },
+         { "BEQ", { "Z", true } }
+      };
+
+      // what the instructions that only read their operand do with it
+      std::unordered_map<std::string_view, std::string_view> const READS{
+         { "LDA", "r.a = zero_and_negative(r, {});" },
+         { "LDX", "r.x = zero_and_negative(r, {});" },
+         { "LDY", "r.y = zero_and_negative(r, {});" },
+         { "ORA", "r.a = zero_and_negative(r, static_cast<Byte>(r.a | {}));" },
+         { "AND", "r.a = zero_and_negative(r, static_cast<Byte>(r.a & {}));" },
+         { "EOR", "r.a = zero_and_negative(r, static_cast<Byte>(r.a ^ {}));" },
+         { "ADC", "adc(r, {});" },
+         { "SBC", "sbc(r, {});" },
+         { "CMP", "compare(r, r.a, {});" },
+         { "CPX", "compare(r, r.x, {});" },
+         { "CPY", "compare(r, r.y, {});" },
+         { "BIT", "bit(r, {});" }
+      };
+
+      std::unordered_map<std::string_view, std::string_view> const WRITES{
+         { "STA", "r.a" },
+         { "STX", "r.x" },
+         { "STY", "r.y" }
+      };
+
+      std::unordered_map<std::string_view, std::string_view> const MODIFIES{
+         { "ASL", "shifted(r, shift_left({}, false))" },
+         { "LSR", "shifted(r, shift_right({}, false))" },
+         { "ROL", "shifted(r, shift_left({}, r.p & C))" },
+         { "ROR", "shifted(r, shift_right({}, r.p & C))" },
+         { "INC", "zero_and_negative(r, static_cast<Byte>({} + 1))" },
+         { "DEC", "zero_and_negative(r, static_cast<Byte>({} - 1))" }
+      };
+
+      std::unordered_map<std::string_view, std::string_view> const IMPLIED{
+         { "INX", "r.x = zero_and_negative(r, static_cast<Byte>(r.x + 1));" },
+         { "INY", "r.y = zero_and_negative(r, static_cast<Byte>(r.y + 1));" },
+         { "DEX", "r.x = zero_and_negative(r, static_cast<Byte>(r.x - 1));" },
+         { "DEY", "r.y = zero_and_negative(r, static_cast<Byte>(r.y - 1));" },
+         { "TAX", "r.x = zero_and_negative(r, r.a);" },
+         { "TAY", "r.y = zero_and_negative(r, r.a);" },
+         { "TXA", "r.a = zero_and_negative(r, r.x);" },
+         { "TYA", "r.a = zero_and_negative(r, r.y);" },
+         { "TSX", "r.x = zero_and_negative(r, r.s);" },
+         { "TXS", "r.s = r.x;" },
+         { "CLC", "change(r, C, false);" },
+         { "SEC", "change(r, C, true);" },
+         { "CLI", "change(r, I, false);" },
+         { "SEI", "change(r, I, true);" },
+         { "CLV", "change(r, V, false);" },
+         { "CLD", "change(r, D, false);" },
+         { "SED", "change(r, D, true);" },
+         { "NOP", "" },
+         { "PHA", "push(memory, r, r.a);" },
+         { "PHP", "r.p |= B | _;\n         push(memory, r, r.p);" },
+         { "PLA", "r.a = zero_and_negative(r, pull(memory, r));" },
+         { "PLP", "r.p = static_cast<Byte>((r.p & (B | _)) | pull(memory, r));" }
+      };
+
+      // the unofficial opcodes that write the memory they address, which the interpreter still runs
+      std::array<std::string_view, 11> constexpr UNOFFICIAL_WRITES{
+         "SLO", "RLA", "SRE", "RRA", "SAX", "DCP", "ISC", "SHA", "SHX", "SHY", "TAS"
+      };
+   }
+
+   StaticRecompiler::StaticRecompiler(Memory& memory)
+      : memory_{ memory }
+      , index_{ memory }
+   {
+   }
+
+   void StaticRecompiler::trace(Word const entry_point)
+   {
+      entry_points_.push_back(entry_point);
+      index_.trace(entry_point);
+
+      // what the index traced so far is gone through again, as tracing may have made leaders of traced instructions
+      leaders_.assign(leaders_.size(), false);
+      written_.assign(written_.size(), false);
+      for (std::size_t address{}; address < leaders_.size(); ++address)
+      {
+         if (not index_.instruction(static_cast<Word>(address)))
+            continue;
+
+         OpcodeInfo const& info{ OPCODE_INFOS[memory_.read(static_cast<Word>(address))] };
+         note_writes(info, operand(static_cast<Word>(address)));
+         if (index_.leader(static_cast<Word>(address)))
+            leaders_[address] = true;
+
+         // the interpreter runs what is not translated, after which translated code can take over again
+         if (not translatable(info))
+            leaders_[static_cast<Word>(address + info.length)] = true;
+      }
+   }
+
+   std::vector<StaticRecompiler::Block> StaticRecompiler::blocks() const
+   {
+      std::vector<Block> blocks{};
+      for (std::size_t address{}; address < leaders_.size(); ++address)
+         if (leaders_[address])
+            if (std::optional block{ this->block(static_cast<Word>(address)) })
+               blocks.push_back(std::move(*block));
+
+      return blocks;
+   }
+
+   std::size_t StaticRecompiler::traced_instructions() const noexcept
+   {
+      return index_.instructions();
+   }
+
+   std::string StaticRecompiler::generate(std::string_view const name) const
+   {
+      std::vector const blocks{ this->blocks() };
+
+      std::string source{ "// Generated by the static recompiler, traced from" };
+      for (Word const entry_point : entry_points_)
+         source += std::format(" ${:04X}", entry_point);
+
+      source += std::format("; {} blocks out of {} traced instructions. Do not edit.\n", blocks.size(),
+         traced_instructions());
+      source += PRELUDE;
+
+      for (Block const& block : blocks)
+      {
+         source += std::format("\n   void block_{:04X}(Context& context)\n   {{\n", block.first);
+         source += "      [[maybe_unused]] Memory& memory{ context.memory };\n";
+         source += "      Registers r{ enter(context) };\n";
+         source += "      Cycle cycles{};\n";
+
+         for (std::size_t index{}; index < block.instructions.size(); ++index)
+            source += translate(block.instructions[index], index + 1 == block.instructions.size());
+
+         if (not ends_block(OPCODE_INFOS[memory_.read(block.instructions.back())]))
+            source += std::format("\n      leave(context, r, 0x{:04X}, cycles);\n", block.exit);
+
+         source += "   }\n";
+      }
+
+      source += std::format("\n   std::array<StaticTranslation::Block, {}> constexpr BLOCKS{{ {{\n", blocks.size());
+      for (Block const& block : blocks)
+      {
+         std::size_t const length{ static_cast<std::size_t>(block.last - block.first) + 1 };
+         source += std::format("      {{ 0x{:04X}, 0x{:04X}, 0x{:08X}, {}, &block_{:04X} }},\n", block.first,
+            block.last, HookRegistry::fingerprint(memory_, block.first, length), block.worst_case_cycles,
+            block.first);
+      }
+
+      source += "   } };\n}\n\nnamespace nes\n{\n";
+      source += std::format("   extern std::span<StaticTranslation::Block const> const {};\n", name);
+      source += std::format("   std::span<StaticTranslation::Block const> const {}{{ BLOCKS }};\n}}\n", name);
+      return source;
+   }
+
+   std::optional<StaticRecompiler::Block> StaticRecompiler::block(Word const first) const
+   {
+      Block block{ .first{ first }, .last{ first }, .instructions{}, .exit{ first }, .worst_case_cycles{} };
+      Word address{ first };
+      do
+      {
+         OpcodeInfo const& info{ OPCODE_INFOS[memory_.read(address)] };
+         if (not translatable(info) or address + info.length - 1 > std::numeric_limits<Word>::max())
+            break;
+
+         block.instructions.push_back(address);
+         block.last = static_cast<Word>(address + info.length - 1);
+         block.worst_case_cycles += info.mode == AddressingMode::RELATIVE
+            ? info.predicted_cycles(true, true)
+            : info.predicted_cycles(true);
+
+         address = static_cast<Word>(address + info.length);
+         if (ends_block(info))
+            break;
+      }
+      while (not leaders_[address] and address not_eq first);
+
+      block.exit = address;
+      if (block.instructions.empty())
+         return std::nullopt;
+
+      // a trap (or a branch that waits for a flag to change) is left to the interpreter, which recognises it
+      OpcodeInfo const& head{ OPCODE_INFOS[memory_.read(first)] };
+      Word const target{
+         head.mode == AddressingMode::RELATIVE
+            ? static_cast<Word>(first + 2 + static_cast<SignedByte>(operand(first)))
+            : operand(first)
+      };
+
+      if ((head.mode == AddressingMode::RELATIVE or head.mnemonic == "JMP") and target == first)
+         return std::nullopt;
+
+      for (std::size_t byte{ block.first }; byte <= block.last; ++byte)
+         if (written_[byte])
+            return std::nullopt;
+
+      return block;
+   }
+
+   std::string StaticRecompiler::translate(Word const address, bool const last) const
+   {
+      OpcodeInfo const& info{ OPCODE_INFOS[memory_.read(address)] };
+      Word const operand{ this->operand(address) };
+      auto const next{ static_cast<Word>(address + info.length) };
+
+      std::string source{
+         std::format("\n      // {:04X}: {}\n", address, Disassembler::disassemble(memory_, address)) };
+      auto const line{ [&source](std::string_view const text) { source += std::format("         {}\n", text); } };
+      auto const leave_at{
+         [](Word const program_counter) { return std::format("return leave(context, r, 0x{:04X}, cycles);",
+            program_counter); }
+      };
+
+      if (auto const branch{ BRANCHES.find(info.mnemonic) }; branch not_eq BRANCHES.end())
+      {
+         auto const target{ static_cast<Word>(next + static_cast<SignedByte>(operand)) };
+         auto const& [flag, set]{ branch->second };
+         source += std::format("      if ({}(r.p & {}))\n      {{\n", set ? "" : "not ", flag);
+         line(std::format("cycles += {};", info.predicted_cycles(target >> 8 not_eq next >> 8, true)));
+         line(leave_at(target));
+         source += std::format("      }}\n\n      cycles += {};\n", info.cycles);
+         source += std::format("      {}\n", leave_at(next));
+         return source;
+      }
+
+      source += "      {\n";
+      line(std::format("cycles += {};", info.cycles));
+      if (info.mnemonic == "JMP")
+         line(leave_at(operand));
+      else if (info.mnemonic == "JSR")
+      {
+         auto const return_address{ static_cast<Word>(next - 1) };
+         line(std::format("push(memory, r, 0x{:02X});", return_address >> 8));
+         line(std::format("push(memory, r, 0x{:02X});", return_address & 0xFF));
+         line(leave_at(operand));
+      }
+      else if (info.mnemonic == "RTS" or info.mnemonic == "RTI")
+      {
+         if (info.mnemonic == "RTI")
+            line("r.p = static_cast<Byte>((r.p & (B | _)) | pull(memory, r));");
+
+         line("Byte const low{ pull(memory, r) };");
+         line("Byte const high{ pull(memory, r) };");
+         line(std::format("return leave(context, r, static_cast<Word>((high << 8 | low){}), cycles);",
+            info.mnemonic == "RTS" ? " + 1" : ""));
+      }
+      else if (auto const implied{ IMPLIED.find(info.mnemonic) };
+         implied not_eq IMPLIED.end() and info.mode == AddressingMode::IMPLIED)
+      {
+         if (not implied->second.empty())
+            line(implied->second);
+      }
+      else if (auto const modify{ MODIFIES.find(info.mnemonic) };
+         modify not_eq MODIFIES.end() and info.mode == AddressingMode::ACCUMULATOR)
+         line(std::format("r.a = {};", std::vformat(modify->second, std::make_format_args("r.a"))));
+      else if (info.mode == AddressingMode::IMMEDIATE)
+      {
+         std::string const value{ std::format("0x{:02X}", operand) };
+         line(std::vformat(READS.at(info.mnemonic), std::make_format_args(value)));
+      }
+      else
+      {
+         // the effective address, and whether forming it crosses a page
+         std::string effective_address{};
+         std::string page_crossing{};
+         switch (info.mode)
+         {
+            case AddressingMode::ZERO_PAGE:
+            case AddressingMode::ABSOLUTE:
+               effective_address = std::format("0x{:04X}", operand);
+               break;
+
+            case AddressingMode::ZERO_PAGE_X:
+            case AddressingMode::ZERO_PAGE_Y:
+               effective_address = std::format("static_cast<Byte>(0x{:02X} + r.{})", operand,
+                  info.mode == AddressingMode::ZERO_PAGE_X ? 'x' : 'y');
+               break;
+
+            case AddressingMode::ABSOLUTE_X:
+            case AddressingMode::ABSOLUTE_Y:
+            {
+               char const index{ info.mode == AddressingMode::ABSOLUTE_X ? 'x' : 'y' };
+               effective_address = std::format("static_cast<Word>(0x{:04X} + r.{})", operand, index);
+               page_crossing = std::format("0x{:02X} + r.{} > 0xFF", operand & 0xFF, index);
+               break;
+            }
+
+            case AddressingMode::X_INDIRECT:
+               effective_address = std::format("pointer(memory, static_cast<Byte>(0x{:02X} + r.x))", operand);
+               break;
+
+            case AddressingMode::INDIRECT_Y:
+               line(std::format("Word const base{{ pointer(memory, 0x{:02X}) }};", operand));
+               effective_address = "static_cast<Word>(base + r.y)";
+               page_crossing = "(base & 0xFF) + r.y > 0xFF";
+               break;
+
+            default:
+               break;
+         }
+
+         line(std::format("Word const address{{ {} }};", effective_address));
+         if (info.page_crossing)
+            line(std::format("cycles += {};", page_crossing));
+
+         if (auto const read{ READS.find(info.mnemonic) }; read not_eq READS.end())
+            line(std::vformat(read->second, std::make_format_args("memory.read(address)")));
+         else if (auto const write{ WRITES.find(info.mnemonic) }; write not_eq WRITES.end())
+            line(std::format("memory.write(address, {});", write->second));
+         else
+         {
+            // like the processor, a read-modify-write writes the unmodified value back first
+            line("Byte const value{ memory.read(address) };");
+            line("memory.write(address, value);");
+            line(std::format("memory.write(address, {});",
+               std::vformat(MODIFIES.at(info.mnemonic), std::make_format_args("value"))));
+         }
+      }
+
+      bool const writes{
+         WRITES.contains(info.mnemonic)
+         or (MODIFIES.contains(info.mnemonic) and info.mode not_eq AddressingMode::ACCUMULATOR)
+         or info.mnemonic == "PHA" or info.mnemonic == "PHP"
+      };
+
+      // a write to translated code ends the block, which the interpreter picks up after the writing instruction
+      if (writes and not last)
+      {
+         line("if (context.invalidated)");
+         line(std::format("   {}", leave_at(next)));
+      }
+
+      source += "      }\n";
+      return source;
+   }
+
+   void StaticRecompiler::note_writes(OpcodeInfo const& info, Word const operand) noexcept
+   {
+      auto const mark{
+         [this](Word const first, std::size_t const count)
+         {
+            for (std::size_t offset{}; offset < count; ++offset)
+               written_[static_cast<Word>(first + offset)] = true;
+         }
+      };
+
+      if (info.mnemonic == "PHA" or info.mnemonic == "PHP" or info.mnemonic == "JSR" or info.mnemonic == "BRK")
+         return mark(0x01'00, 0x01'00);
+
+      bool const writes{
+         WRITES.contains(info.mnemonic) or MODIFIES.contains(info.mnemonic)
+         or std::ranges::find(UNOFFICIAL_WRITES, info.mnemonic) not_eq UNOFFICIAL_WRITES.end()
+      };
+
+      if (not writes)
+         return;
+
+      // writes through a pointer only show up as they happen, to the watchers of the translation
+      switch (info.mode)
+      {
+         case AddressingMode::ZERO_PAGE:
+         case AddressingMode::ABSOLUTE:
+            return mark(operand, 1);
+
+         case AddressingMode::ZERO_PAGE_X:
+         case AddressingMode::ZERO_PAGE_Y:
+            return mark(0x00'00, 0x01'00);
+
+         case AddressingMode::ABSOLUTE_X:
+         case AddressingMode::ABSOLUTE_Y:
+            return mark(operand, 0x01'00);
+
+         default:
+            return;
+      }
+   }
+
+   Word StaticRecompiler::operand(Word const address) const noexcept
+   {
+      OpcodeInfo const& info{ OPCODE_INFOS[memory_.read(address)] };
+      Byte const low{ memory_.read(static_cast<Word>(address + 1)) };
+      if (info.length < 3)
+         return low;
+
+      return static_cast<Word>(memory_.read(static_cast<Word>(address + 2)) << 8 | low);
+   }
+
+   Word StaticRecompiler::read_word(Word const low_address, Word const high_address) const noexcept
+   {
+      return static_cast<Word>(memory_.read(high_address) << 8 | memory_.read(low_address));
+   }
+
+   bool StaticRecompiler::translatable(OpcodeInfo const& info) noexcept
+   {
+      // JMP (indirect) goes somewhere the trace does not know of; BRK through the interrupt vector
+      return info.official and info.mnemonic not_eq "BRK" and info.mode not_eq AddressingMode::INDIRECT;
+   }
+
+   bool StaticRecompiler::ends_block(OpcodeInfo const& info) noexcept
+   {
+      return info.mode == AddressingMode::RELATIVE or info.mnemonic == "JMP" or info.mnemonic == "JSR"
+         or info.mnemonic == "RTS" or info.mnemonic == "RTI";
+   }
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#ifndef STATIC_RECOMPILER_HPP
+#define STATIC_RECOMPILER_HPP
+
+#include "hardware/memory/memory.hpp"
+#include "hardware/types.hpp"
+#include "opcode_info.hpp"
+#include "pch.hpp"
+#include "predecode_index.hpp"
+#include "variant.hpp"
+
+namespace nes
+{
+   // Translates a program ahead of time into C++, one function per basic block, for programs that are run over and
+   // over. The code is found by a PredecodeIndex tracing the control flow from entry points, which follows indirect
+   // jumps and BRK through the pointers the program holds when it is translated, and the blocks start where the index
+   // has them start. The index takes a free watcher of the memory. JMP (indirect) and BRK themselves stay with the
+   // interpreter, as do the unofficial opcodes, traps and the blocks that a write in the traced code may modify.
+   // Translated code reads and writes through Memory but, like the recompiler, skips the dummy reads. The generated
+   // source defines the blocks for a StaticTranslation.
+   class StaticRecompiler final
+   {
+      public:
+         struct Block final
+         {
+            Word first;
+            Word last;
+            std::vector<Word> instructions;
+            // where the block carries on when its last instruction does not jump or branch
+            Word exit;
+            Cycle worst_case_cycles;
+         };
+
+         explicit StaticRecompiler(Memory& memory);
+         StaticRecompiler(StaticRecompiler const&) = delete;
+         StaticRecompiler(StaticRecompiler&&) = delete;
+
+         ~StaticRecompiler() noexcept = default;
+
+         StaticRecompiler& operator=(StaticRecompiler const&) = delete;
+         StaticRecompiler& operator=(StaticRecompiler&&) = delete;
+
+         // follows the control flow from the entry point, adding to what earlier traces found
+         void trace(Word entry_point);
+
+         // the blocks found so far that get translated
+         [[nodiscard]] std::vector<Block> blocks() const;
+         [[nodiscard]] std::size_t traced_instructions() const noexcept;
+         // a translation unit defining the blocks as a std::span<StaticTranslation::Block const> in namespace nes
+         [[nodiscard]] std::string generate(std::string_view name) const;
+
+      private:
+         [[nodiscard]] std::optional<Block> block(Word first) const;
+         [[nodiscard]] std::string translate(Word address, bool last) const;
+         void note_writes(OpcodeInfo const& info, Word operand) noexcept;
+         [[nodiscard]] Word operand(Word address) const noexcept;
+         [[nodiscard]] Word read_word(Word low_address, Word high_address) const noexcept;
+
+         [[nodiscard]] static bool translatable(OpcodeInfo const& info) noexcept;
+         [[nodiscard]] static bool ends_block(OpcodeInfo const& info) noexcept;
+
+         Memory const& memory_;
+         PredecodeIndex index_;
+
+         std::vector<bool> leaders_ = std::vector<bool>(std::numeric_limits<ProgramCounter>::max() + 1);
+         // what the traced code writes to at addresses known ahead of time
+         std::vector<bool> written_ = std::vector<bool>(std::numeric_limits<ProgramCounter>::max() + 1);
+         std::vector<Word> entry_points_{};
+   };
+}
+
+#endif
\ No newline at end of file
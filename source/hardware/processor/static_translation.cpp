@@ -0,0 +1,112 @@
+#include "static_translation.hpp"
+#include "hook_registry.hpp"
+#include "processor.hpp"
+
+namespace nes
+{
+   StaticTranslation::StaticTranslation(Memory& memory, std::span<Block const> const blocks)
+      : memory_{ memory }
+      , watcher_{ memory.add_watcher(std::bind_front(&StaticTranslation::invalidate, this)) }
+      , context_{
+         .memory{ memory },
+         .cycles{},
+         .program_counter{},
+         .accumulator{},
+         .x{},
+         .y{},
+         .stack_pointer{},
+         .processor_status{},
+         .invalidated{}
+      }
+   {
+      if (not watcher_)
+         return;
+
+      for (Block const& block : blocks)
+      {
+         // a translation made from another program (or another version of it) must not run
+         std::size_t const length{ static_cast<std::size_t>(block.last - block.first) + 1 };
+         if (HookRegistry::fingerprint(memory_, block.first, length) not_eq block.fingerprint)
+            continue;
+
+         blocks_by_address_[block.first] = &block;
+         for (std::size_t page{ page_of(block.first) }; page <= page_of(block.last); ++page)
+            blocks_by_page_[page].push_back(&block);
+
+         memory_.watch(*watcher_, block.first, block.last, true);
+         ++valid_blocks_;
+      }
+   }
+
+   StaticTranslation::~StaticTranslation() noexcept
+   {
+      if (watcher_)
+         memory_.remove_watcher(*watcher_);
+   }
+
+   bool StaticTranslation::run(Processor& processor, Cycle const budget) noexcept
+   {
+      Block const* const block{ blocks_by_address_[processor.program_counter] };
+      if (not block or block->worst_case_cycles > budget)
+         return false;
+
+      processor.resolve_processor_status();
+      context_.cycles = 0;
+      context_.program_counter = processor.program_counter;
+      context_.accumulator = processor.accumulator_;
+      context_.x = processor.x_;
+      context_.y = processor.y_;
+      context_.stack_pointer = processor.stack_pointer_;
+      context_.processor_status = processor.processor_status_;
+      context_.invalidated = false;
+
+      block->function(context_);
+
+      processor.cycle_ += context_.cycles;
+      processor.program_counter = context_.program_counter;
+      processor.accumulator_ = context_.accumulator;
+      processor.x_ = context_.x;
+      processor.y_ = context_.y;
+      processor.stack_pointer_ = context_.stack_pointer;
+      processor.processor_status_ = context_.processor_status;
+      ++runs_;
+      return true;
+   }
+
+   std::size_t StaticTranslation::valid_blocks() const noexcept
+   {
+      return valid_blocks_;
+   }
+
+   std::size_t StaticTranslation::runs() const noexcept
+   {
+      return runs_;
+   }
+
+   std::size_t StaticTranslation::invalidations() const noexcept
+   {
+      return invalidations_;
+   }
+
+   void StaticTranslation::invalidate(Word const first, Word const last) noexcept
+   {
+      // only translated code is watched, so a block that is running has to stop
+      context_.invalidated = true;
+
+      for (std::size_t page{ page_of(first) }; page <= page_of(last); ++page)
+         for (Block const* const block : blocks_by_page_[page])
+         {
+            if (block->last < first or block->first > last or blocks_by_address_[block->first] not_eq block)
+               continue;
+
+            blocks_by_address_[block->first] = nullptr;
+            --valid_blocks_;
+            ++invalidations_;
+         }
+   }
+
+   std::size_t StaticTranslation::page_of(Word const address) noexcept
+   {
+      return address >> 8u;
+   }
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef STATIC_TRANSLATION_HPP
+#define STATIC_TRANSLATION_HPP
+
+#include "hardware/memory/memory.hpp"
+#include "hardware/types.hpp"
+#include "pch.hpp"
+
+namespace nes
+{
+   class Processor;
+
+   // Runs the blocks the static recompiler translated a program into ahead of time, for a processor it is set on.
+   // Blocks whose code in memory differs from what was translated are left to the interpreter, and so is every block
+   // a write touches from then on, the translation watching the code of its blocks like the block cache does. Without
+   // a free watcher of the memory, every block is left to the interpreter.
+   class StaticTranslation final
+   {
+      public:
+         // what a translated block works on, the registers being copied in and out around it
+         struct Context final
+         {
+            Memory& memory;
+            Cycle cycles;
+            ProgramCounter program_counter;
+            Accumulator accumulator;
+            Index x;
+            Index y;
+            StackPointer stack_pointer;
+            ProcessorStatus processor_status;
+            // set once a write touches translated code, upon which the block returns before its next instruction
+            bool invalidated;
+         };
+
+         using Function = void(*)(Context& context);
+
+         struct Block final
+         {
+            Word first;
+            Word last;
+            std::uint32_t fingerprint;
+            Cycle worst_case_cycles;
+            Function function;
+         };
+
+         StaticTranslation(Memory& memory, std::span<Block const> blocks);
+         StaticTranslation(StaticTranslation const&) = delete;
+         StaticTranslation(StaticTranslation&&) = delete;
+
+         ~StaticTranslation() noexcept;
+
+         StaticTranslation& operator=(StaticTranslation const&) = delete;
+         StaticTranslation& operator=(StaticTranslation&&) = delete;
+
+         // runs the block at the program counter, provided there is a valid one that cannot exceed the budget
+         [[nodiscard]] bool run(Processor& processor, Cycle budget) noexcept;
+
+         [[nodiscard]] std::size_t valid_blocks() const noexcept;
+         [[nodiscard]] std::size_t runs() const noexcept;
+         [[nodiscard]] std::size_t invalidations() const noexcept;
+
+      private:
+         void invalidate(Word first, Word last) noexcept;
+         [[nodiscard]] static std::size_t page_of(Word address) noexcept;
+
+         Memory& memory_;
+         std::optional<Memory::WatcherId> const watcher_;
+
+         std::vector<Block const*> blocks_by_address_ =
+            std::vector<Block const*>(std::numeric_limits<ProgramCounter>::max() + 1);
+         std::array<std::vector<Block const*>, 256> blocks_by_page_{};
+         Context context_;
+
+         std::size_t valid_blocks_{};
+         std::size_t runs_{};
+         std::size_t invalidations_{};
+   };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef VARIANT_HPP
+#define VARIANT_HPP
+
+namespace nes
+{
+   // The members of the 6502 family the processor can model, told apart by what the cores resolve at compile time.
+   // A build models one of them, picked through the FRONES_CPU_VARIANT CMake option.
+   struct Nmos6502 final
+   {
+      // ADC and SBC honour the D flag
+      static bool constexpr DECIMAL_MODE{ true };
+      // N, V and Z of decimal arithmetic come from the binary operation rather than the decimal result
+      static bool constexpr DECIMAL_FLAGS_FROM_BINARY{ true };
+      // JMP (indirect) reads the high byte of its target from the start of the page the pointer ends
+      static bool constexpr INDIRECT_JUMP_WRAPS{ true };
+      // the JAM opcodes lock the processor up
+      static bool constexpr JAMS{ true };
+   };
+
+   struct Ricoh2A03 final
+   {
+      // the decimal adjust circuitry is cut, D is stored but ignored
+      static bool constexpr DECIMAL_MODE{ false };
+      static bool constexpr DECIMAL_FLAGS_FROM_BINARY{ true };
+      static bool constexpr INDIRECT_JUMP_WRAPS{ true };
+      static bool constexpr JAMS{ true };
+   };
+
+   // Partial: only the behaviour the NMOS opcodes change is modelled. None of the opcodes the 65C02 adds (BRA, PHX,
+   // STZ, TRB, TSB, the zero page indirect mode and so on) exist, they halt as unsupported ones like the NMOS
+   // illegal opcodes they replace.
+   struct Wdc65C02 final
+   {
+      static bool constexpr DECIMAL_MODE{ true };
+      static bool constexpr DECIMAL_FLAGS_FROM_BINARY{ false };
+      static bool constexpr INDIRECT_JUMP_WRAPS{ false };
+      // the opcodes are NOPs here; those are not modelled, so they halt as unsupported ones
+      static bool constexpr JAMS{ false };
+   };
+
+   #if defined(FRONES_RICOH_2A03)
+   using Variant = Ricoh2A03;
+   #elif defined(FRONES_WDC_65C02)
+   using Variant = Wdc65C02;
+   #else
+   using Variant = Nmos6502;
+   #endif
+}
+
+#endif
\ No newline at end of file
@@ -3,27 +3,39 @@
 
 #include <algorithm>
 #include <array>
+#include <barrier>
+#include <bit>
+#include <bitset>
+#include <charconv>
 #include <chrono>
 #include <cmath>
 #include <condition_variable>
 #include <coroutine>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <exception>
+#include <expected>
 #include <filesystem>
 #include <format>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <mutex>
 #include <optional>
 #include <print>
 #include <queue>
 #include <source_location>
+#include <span>
 #include <string_view>
 #include <thread>
 #include <typeindex>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <imgui.h>
 #include <imgui_impl_sdl3.h>
@@ -36,4 +48,11 @@
 #include <nfd.hpp>
 #endif
 
+#if (defined(__unix__) or defined(__APPLE__)) and not defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #endif
\ No newline at end of file
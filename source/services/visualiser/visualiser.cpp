@@ -1,4 +1,5 @@
 #include "visualiser.hpp"
+#include "hardware/processor/disassembler.hpp"
 
 namespace nes
 {
@@ -48,7 +49,7 @@ namespace nes
       #endif
    }
 
-   bool Visualiser::update(Memory const& memory, Processor& processor) noexcept
+   bool Visualiser::update(Memory const& memory, Processor& processor, PredecodeIndex const& predecode_index) noexcept
    {
       ImGui_ImplSDLRenderer3_NewFrame();
       ImGui_ImplSDL3_NewFrame();
@@ -119,7 +120,10 @@ namespace nes
                if (ImGui::Button("Select program"))
                {
                   NFD::UniquePath program_path;
-                  std::array constexpr filters{ nfdu8filteritem_t{ "Binaries", "bin" } };
+                  std::array constexpr filters{
+                     nfdu8filteritem_t{ "Binaries", "bin" },
+                     nfdu8filteritem_t{ "NES cartridges", "nes" }
+                  };
                   switch (OpenDialog(program_path, filters.data(), static_cast<nfdfiltersize_t>(filters.size())))
                   {
                      case NFD_OKAY:
@@ -154,11 +158,25 @@ namespace nes
             ImGui::Begin("CPU", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoCollapse);
             {
                ImGui::Text("Cycle: %llu", processor.cycle());
+               ImGui::Text("Heap allocations: %zu", processor.heap_allocations());
+               ImGui::Text("Elided dummy reads: %zu", processor.elided_reads());
+               ImGui::Text("Fused sequences: %zu", processor.fusions());
+               ImGui::Text("Block cache: %zu hits, %zu misses, %zu invalidations", processor.block_cache().hits(),
+                  processor.block_cache().misses(), processor.block_cache().invalidations());
+               ImGui::Text("Recompiler: %zu translations, %zu native runs", processor.recompiler().translations(),
+                  processor.recompiler().native_runs());
                ImGui::Text("Program counter:");
                ImGui::SameLine();
                ImGui::SetNextItemWidth(50.0f);
                ImGui::InputScalar("##hidden", ImGuiDataType_U16, &processor.program_counter,
                   nullptr, nullptr, "%04X", ImGuiInputTextFlags_CharsHexadecimal | ImGuiInputTextFlags_CharsUppercase);
+               ImGui::Text("Instruction: %s", Disassembler::disassemble(memory, processor.program_counter).c_str());
+               if (predecode_index.instruction(processor.program_counter))
+                  ImGui::Text("Indexed: %s", predecode_index.leader(processor.program_counter)
+                     ? "starts a block" : "inside a block");
+               if (auto const& halt_reason{ processor.halt_reason() })
+                  ImGui::Text("%s", std::format("Halted: {} (0x{:02X}) at 0x{:04X}", halt_reason->description(),
+                     halt_reason->opcode, halt_reason->program_counter).c_str());
                ImGui::Text("A: %02X", processor.accumulator());
                ImGui::Text("X: %02X", processor.x());
                ImGui::Text("Y: %02X", processor.y());
@@ -1,6 +1,7 @@
 #ifndef VISUALISER_HPP
 #define VISUALISER_HPP
 
+#include "hardware/processor/predecode_index.hpp"
 #include "hardware/processor/processor.hpp"
 #include "pch.hpp"
 #include "utility/runtime_assert.hpp"
@@ -50,7 +51,8 @@ namespace nes
          Visualiser& operator=(Visualiser const&) = delete;
          Visualiser& operator=(Visualiser&&) = delete;
 
-         [[nodiscard]] bool update(Memory const& memory, Processor& processor) noexcept;
+         [[nodiscard]] bool update(Memory const& memory, Processor& processor,
+            PredecodeIndex const& predecode_index) noexcept;
 
          [[nodiscard]] bool tick_repeatedly() const noexcept;
          [[nodiscard]] bool tick_once() const noexcept;
@@ -14,6 +14,12 @@ namespace nes
    #else
    auto constexpr MINGW{ false };
    #endif
+
+   #if defined(__linux__) and defined(__x86_64__)
+   auto constexpr LINUX_X86_64{ true };
+   #else
+   auto constexpr LINUX_X86_64{ false };
+   #endif
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include "hardware/memory/memory.hpp"
+#include "hardware/processor/processor.hpp"
+#include "services/locator.hpp"
+#include "services/logger/logger.hpp"
+
+namespace
+{
+   std::size_t constexpr REPETITIONS{ 5 };
+   std::size_t constexpr WRITES{ 1 << 26 };
+
+   // runs the writes and reports the fastest of the repetitions in nanoseconds per write
+   template <typename Write>
+   void benchmark(std::string_view const name, std::span<nes::Word const> const addresses, Write&& write)
+   {
+      std::chrono::duration<double> fastest{ std::numeric_limits<double>::max() };
+      for (std::size_t repetition{}; repetition < REPETITIONS; ++repetition)
+      {
+         auto const start{ std::chrono::steady_clock::now() };
+         for (std::size_t pass{}; pass < WRITES / addresses.size(); ++pass)
+            for (nes::Word const address : addresses)
+               write(address, static_cast<nes::Byte>(pass));
+
+         fastest = std::min<std::chrono::duration<double>>(fastest, std::chrono::steady_clock::now() - start);
+      }
+
+      std::println("{:<34}{:>7.3f} ns/write", name, fastest.count() * 1'000'000'000 / WRITES);
+   }
+
+   void benchmark_writes(std::string_view const pattern, std::span<nes::Word const> const addresses)
+   {
+      std::println("{} writes", pattern);
+
+      // the write path of the memory without and with the bit it sets, on a page table of its own
+      auto const ram{ std::make_unique<std::array<nes::Byte, 0x1'00'00>>() };
+      std::array<nes::Byte*, nes::Memory::PAGES> pages{};
+      for (std::size_t page{}; page < pages.size(); ++page)
+         pages[page] = ram->data() + page * nes::Memory::PAGE_SIZE;
+
+      std::array<std::uint64_t, nes::Memory::PAGES / 64> dirty_pages{};
+      benchmark("  page table store", addresses,
+         [&pages](nes::Word const address, nes::Byte const data)
+         {
+            pages[address / nes::Memory::PAGE_SIZE][address % nes::Memory::PAGE_SIZE] = data;
+         });
+
+      benchmark("  page table store and dirty bit", addresses,
+         [&pages, &dirty_pages](nes::Word const address, nes::Byte const data)
+         {
+            pages[address / nes::Memory::PAGE_SIZE][address % nes::Memory::PAGE_SIZE] = data;
+            dirty_pages[address / nes::Memory::PAGE_SIZE / 64] |=
+               std::uint64_t{ 1 } << address / nes::Memory::PAGE_SIZE % 64;
+         });
+
+      auto const memory{ std::make_unique<nes::Memory>() };
+      benchmark("  Memory::write", addresses,
+         [&memory](nes::Word const address, nes::Byte const data)
+         {
+            memory->write(address, data);
+         });
+
+      // keeps the stores from being optimised away
+      std::uint64_t checksum{};
+      for (std::size_t address{}; address < ram->size(); ++address)
+         checksum += (*ram)[address] + memory->read(static_cast<nes::Word>(address));
+
+      for (std::uint64_t const word : dirty_pages)
+         checksum += static_cast<std::uint64_t>(std::popcount(word));
+
+      std::println("  (checksum {:016X})", checksum);
+   }
+
+   // what taking a cursor costs, which grows with the number of cursors the writes are handed to
+   void benchmark_taking()
+   {
+      std::println("taking");
+      for (std::size_t const cursors : { std::size_t{ 1 }, nes::Memory::MAX_DIRTY_CURSORS })
+      {
+         auto const memory{ std::make_unique<nes::Memory>() };
+         std::vector<nes::Memory::DirtyCursorId> ids{};
+         for (std::size_t cursor{}; cursor < cursors; ++cursor)
+            ids.push_back(*memory->add_dirty_cursor());
+
+         std::size_t constexpr TAKES{ 1 << 20 };
+         std::size_t dirty{};
+         auto const start{ std::chrono::steady_clock::now() };
+         for (std::size_t take{}; take < TAKES; ++take)
+         {
+            memory->write(static_cast<nes::Word>(take * 0x01'01), 0xFF);
+            dirty += memory->take_dirty_pages(ids[take % ids.size()]).count();
+         }
+
+         std::chrono::duration<double> const duration{ std::chrono::steady_clock::now() - start };
+         std::println("  {} cursor(s){:>20.3f} ns/take ({} dirty pages seen)", cursors,
+            duration.count() * 1'000'000'000 / TAKES, dirty);
+      }
+   }
+
+   // runs the functional test from its start to the trap it ends in, end to end with every write tracked
+   void benchmark_functional_test(std::filesystem::path const& program)
+   {
+      std::println("functional test");
+      for (auto const& [name, core] : {
+         std::pair{ "instruction-stepped", nes::Processor::Core::INSTRUCTION_STEPPED },
+         std::pair{ "recompiled", nes::Processor::Core::RECOMPILED }
+      })
+      {
+         auto const memory{ std::make_unique<nes::Memory>() };
+         memory->load_program(program, 0x00'0A);
+         nes::Memory::DirtyCursorId const cursor{ *memory->add_dirty_cursor() };
+
+         nes::Processor processor{ *memory, core };
+         while (not processor.tick().value())
+            ;
+
+         std::ignore = memory->take_dirty_pages(cursor);
+         processor.program_counter = 0x04'00;
+         auto const start{ std::chrono::steady_clock::now() };
+         while (processor.run(1'000'000))
+            ;
+
+         std::chrono::duration<double> const duration{ std::chrono::steady_clock::now() - start };
+         std::println("  {:<22}{:>7.1f} MHz, {} pages dirtied, trapped at ${:04X}", name,
+            processor.cycle() / duration.count() / 1'000'000, memory->take_dirty_pages(cursor).count(),
+            processor.halt_reason()->program_counter);
+      }
+   }
+}
+
+// Measures what tracking dirty pages adds to a write, what taking them costs and how the processor runs with it
+int main(int const argc, char** const argv)
+{
+   std::filesystem::path const program{ argc > 1 ? argv[1] : FRONES_FUNCTIONAL_TEST };
+   if (not exists(program))
+   {
+      std::println(std::cerr, "usage: {} [functional test binary]", argv[0]);
+      return EXIT_FAILURE;
+   }
+
+   nes::Locator::provide<nes::Logger>();
+
+   std::vector<nes::Word> addresses(nes::Memory::PAGES * nes::Memory::PAGE_SIZE);
+   for (std::size_t index{}; index < addresses.size(); ++index)
+      addresses[index] = static_cast<nes::Word>(index);
+   benchmark_writes("sequential", addresses);
+
+   // scattered over the address space like the writes of a program are, without paying for the generator
+   std::uint32_t state{ 0x2545'F491 };
+   for (nes::Word& address : addresses)
+   {
+      state ^= state << 13;
+      state ^= state >> 17;
+      state ^= state << 5;
+      address = static_cast<nes::Word>(state);
+   }
+   benchmark_writes("scattered", addresses);
+
+   benchmark_taking();
+   benchmark_functional_test(program);
+
+   nes::Locator::remove_providers();
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,121 @@
+#include "hardware/host/host.hpp"
+#include "hardware/memory/memory.hpp"
+#include "hardware/processor/processor.hpp"
+#include "services/locator.hpp"
+#include "services/logger/logger.hpp"
+
+namespace
+{
+   std::size_t constexpr REPETITIONS{ 3 };
+   nes::Word constexpr START{ 0x04'00 };
+   // short of the cycles the functional test takes to reach its final trap, so every processor works all along
+   nes::Cycle constexpr BUDGET{ 50'000'000 };
+   // the host rounds it up to whole quanta
+   nes::Cycle constexpr BUDGET_PER_RUN{ 1'000'000 };
+
+   // what a processor left behind, which has to be the same however many run beside it
+   struct Outcome final
+   {
+      nes::Word program_counter;
+      nes::Byte accumulator;
+      nes::Byte x;
+      nes::Byte y;
+      std::vector<nes::Byte> memory;
+
+      bool operator==(Outcome const&) const = default;
+   };
+
+   struct Measurement final
+   {
+      double seconds;
+      nes::Cycle cycles;
+      std::size_t halted;
+      std::vector<Outcome> outcomes;
+   };
+
+   // the fastest of the repetitions of running the functional test in as many processors, each on a memory of its
+   // own so the host runs them on threads of their own
+   Measurement measure(std::vector<nes::Byte> const& functional_test, std::size_t const processors)
+   {
+      Measurement measurement{ .seconds{ std::numeric_limits<double>::max() }, .cycles{}, .halted{}, .outcomes{} };
+      for (std::size_t repetition{}; repetition < REPETITIONS; ++repetition)
+      {
+         std::vector<std::unique_ptr<nes::Memory>> memories{};
+         nes::Host host{};
+         for (std::size_t index{}; index < processors; ++index)
+         {
+            auto& memory{ *memories.emplace_back(std::make_unique<nes::Memory>()) };
+            for (std::size_t offset{}; offset < functional_test.size() and offset + 0x0A < 0x1'00'00; ++offset)
+               memory.write(static_cast<nes::Word>(offset + 0x0A), functional_test[offset]);
+
+            nes::Processor& processor{ *host.add_processor(memory, nes::Processor::Core::INSTRUCTION_STEPPED) };
+            while (not processor.tick().value())
+               ;
+
+            processor.program_counter = START;
+         }
+
+         measurement.halted = 0;
+         auto const start{ std::chrono::steady_clock::now() };
+         while (host.cycle() < BUDGET)
+            measurement.halted = static_cast<std::size_t>(std::ranges::count_if(host.run(BUDGET_PER_RUN),
+               [](nes::Host::ProcessorResult const& result) { return result.halt_reason.has_value(); }));
+
+         std::chrono::duration<double> const elapsed{ std::chrono::steady_clock::now() - start };
+         measurement.seconds = std::min(measurement.seconds, elapsed.count());
+         measurement.cycles = host.cycle();
+
+         measurement.outcomes.clear();
+         for (std::size_t index{}; index < processors; ++index)
+         {
+            nes::Processor const& processor{ host.processor(index) };
+            Outcome& outcome{
+               measurement.outcomes.emplace_back(Outcome{
+                  .program_counter{ processor.program_counter },
+                  .accumulator{ processor.accumulator() },
+                  .x{ processor.x() },
+                  .y{ processor.y() },
+                  .memory{}
+               })
+            };
+
+            for (std::size_t address{}; address < 0x1'00'00; ++address)
+               outcome.memory.push_back(memories[index]->read(static_cast<nes::Word>(address)));
+         }
+      }
+
+      return measurement;
+   }
+}
+
+// Measures how the throughput of the host scales with the processors it runs on threads of their own, each one
+// running the functional test on the instruction-stepped core, and checks they all end up where one running alone
+// does
+int main(int const argc, char** const argv)
+{
+   std::filesystem::path const program{ argc > 1 ? argv[1] : FRONES_FUNCTIONAL_TEST };
+   std::ifstream file{ program, std::ios::binary };
+   if (not file)
+   {
+      std::println(std::cerr, "usage: {} [functional test binary]", argv[0]);
+      return EXIT_FAILURE;
+   }
+
+   std::vector<nes::Byte> const functional_test{ std::istreambuf_iterator<char>{ file }, {} };
+   nes::Locator::provide<nes::Logger>();
+
+   std::size_t const threads{ std::max<std::size_t>(std::thread::hardware_concurrency(), 1) };
+   std::println("instruction-stepped core, {} hardware threads", threads);
+   Measurement const alone{ measure(functional_test, 1) };
+   for (std::size_t processors{ 1 }; processors <= threads; processors *= 2)
+   {
+      Measurement const measurement{ processors == 1 ? alone : measure(functional_test, processors) };
+      std::println("  {:>3} processors{:>10.1f} MHz, {:.2f}x, {} halted, {} of {} matching alone", processors,
+         static_cast<double>(processors * measurement.cycles) / measurement.seconds / 1'000'000,
+         alone.seconds * static_cast<double>(processors) / measurement.seconds, measurement.halted,
+         std::ranges::count(measurement.outcomes, alone.outcomes.front()), processors);
+   }
+
+   nes::Locator::remove_providers();
+   return EXIT_SUCCESS;
+}
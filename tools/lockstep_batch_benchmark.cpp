@@ -0,0 +1,202 @@
+#include "hardware/memory/memory.hpp"
+#include "hardware/processor/lockstep_batch.hpp"
+#include "hardware/processor/processor.hpp"
+#include "services/locator.hpp"
+#include "services/logger/logger.hpp"
+
+namespace
+{
+   std::size_t constexpr REPETITIONS{ 3 };
+   nes::Word constexpr START{ 0x04'00 };
+
+   // CRC-8 over the 256 bytes at $0200, with the sum of the CRCs kept beside it, for as many passes as $12 says; the
+   // branch on each shifted out bit makes lanes with different data diverge
+   std::array<nes::Byte, 38> constexpr CRC_PROGRAM{
+      0xA9, 0x00,       // LDA #$00
+      0x85, 0x10,       // STA $10
+      0xA0, 0x00,       // LDY #$00
+      0xA5, 0x10,       // LDA $10
+      0x59, 0x00, 0x02, // EOR $0200,Y
+      0xA2, 0x08,       // LDX #$08
+      0x0A,             // ASL A
+      0x90, 0x02,       // BCC +2
+      0x49, 0x07,       // EOR #$07
+      0xCA,             // DEX
+      0xD0, 0xF8,       // BNE -8
+      0x85, 0x10,       // STA $10
+      0x18,             // CLC
+      0x65, 0x11,       // ADC $11
+      0x85, 0x11,       // STA $11
+      0xC8,             // INY
+      0xD0, 0xE7,       // BNE -25
+      0xC6, 0x12,       // DEC $12
+      0xD0, 0xE1,       // BNE -31
+      0x4C, 0x23, 0x04  // JMP $0423
+   };
+   nes::Byte constexpr PASSES{ 0xFF };
+
+   struct Workload final
+   {
+      std::string_view name;
+      // fills the memory of the lane, starting at START
+      std::function<void(std::size_t lane, std::span<nes::Byte, nes::LockstepBatch::MEMORY_SIZE> memory)> load;
+   };
+
+   struct Outcome final
+   {
+      nes::Word trap;
+      nes::Byte accumulator;
+      nes::Byte crc;
+      nes::Byte sum;
+   };
+
+   // the fastest of the repetitions in seconds, with what the last one left behind in each lane
+   template <typename Run>
+   std::pair<double, std::array<Outcome, nes::LockstepBatch::LANES>> measure(Run&& run)
+   {
+      std::chrono::duration<double> fastest{ std::numeric_limits<double>::max() };
+      std::array<Outcome, nes::LockstepBatch::LANES> outcomes{};
+      for (std::size_t repetition{}; repetition < REPETITIONS; ++repetition)
+      {
+         auto const start{ std::chrono::steady_clock::now() };
+         outcomes = run();
+         fastest = std::min<std::chrono::duration<double>>(fastest, std::chrono::steady_clock::now() - start);
+      }
+
+      return { fastest.count(), outcomes };
+   }
+
+   // the workload in 16 processors on the instruction-stepped core, which the batch times its lanes like, one after
+   // the other, against the batch running it in its lanes
+   void benchmark(Workload const& workload)
+   {
+      std::println("{}", workload.name);
+      auto const [processors_time, processors]{
+         measure([&workload]
+            {
+               std::array<Outcome, nes::LockstepBatch::LANES> outcomes{};
+               for (std::size_t lane{}; lane < outcomes.size(); ++lane)
+               {
+                  auto const memory{ std::make_unique<nes::Memory>() };
+                  std::vector<nes::Byte> image(nes::LockstepBatch::MEMORY_SIZE);
+                  workload.load(lane, std::span<nes::Byte, nes::LockstepBatch::MEMORY_SIZE>{ image });
+                  for (std::size_t address{}; address < image.size(); ++address)
+                     memory->write(static_cast<nes::Word>(address), image[address]);
+
+                  nes::Processor processor{ *memory, nes::Processor::Core::INSTRUCTION_STEPPED };
+                  while (not processor.tick().value())
+                     ;
+
+                  processor.program_counter = START;
+                  while (processor.run(1'000'000))
+                     ;
+
+                  outcomes[lane] = {
+                     .trap{ processor.halt_reason()->program_counter },
+                     .accumulator{ processor.accumulator() },
+                     .crc{ memory->read(0x00'10) },
+                     .sum{ memory->read(0x00'11) }
+                  };
+               }
+
+               return outcomes;
+            })
+      };
+
+      // the processors spend what is left of their budget once they find the trap, so only the lanes count cycles
+      nes::Cycle cycles{};
+      std::size_t steps{};
+      std::size_t instructions{};
+      auto const [batch_time, lanes]{
+         measure([&workload, &cycles, &steps, &instructions]
+            {
+               auto const batch{ std::make_unique<nes::LockstepBatch>() };
+               for (std::size_t lane{}; lane < nes::LockstepBatch::LANES; ++lane)
+               {
+                  workload.load(lane, batch->memory(lane));
+                  batch->load(lane, { .program_counter{ START } });
+               }
+
+               while (std::ranges::any_of(batch->run(1'000'000),
+                  [](nes::LockstepBatch::LaneResult const& result) { return not result.halt_reason; }))
+                  ;
+
+               cycles = 0;
+               std::array<Outcome, nes::LockstepBatch::LANES> outcomes{};
+               for (std::size_t lane{}; lane < outcomes.size(); ++lane)
+               {
+                  cycles += batch->cycle(lane);
+                  outcomes[lane] = {
+                     .trap{ batch->halt_reason(lane)->program_counter },
+                     .accumulator{ batch->state(lane).accumulator },
+                     .crc{ batch->memory(lane)[0x00'10] },
+                     .sum{ batch->memory(lane)[0x00'11] }
+                  };
+               }
+
+               steps = batch->steps();
+               instructions = batch->instructions();
+               return outcomes;
+            })
+      };
+
+      std::size_t matching{};
+      for (std::size_t lane{}; lane < nes::LockstepBatch::LANES; ++lane)
+         matching += processors[lane].trap == lanes[lane].trap
+            and processors[lane].accumulator == lanes[lane].accumulator and processors[lane].crc == lanes[lane].crc
+            and processors[lane].sum == lanes[lane].sum;
+
+      std::println("  16 processors{:>10.1f} MHz", cycles / processors_time / 1'000'000);
+      std::println("  batch        {:>10.1f} MHz, {:.2f} lanes per step, {} of 16 lanes matching", cycles / batch_time
+         / 1'000'000, static_cast<double>(instructions) / static_cast<double>(steps), matching);
+   }
+}
+
+// Measures the lockstep batch against as many processors run one after the other, with every lane running the same
+// instructions and with the lanes diverging on their data
+int main(int const argc, char** const argv)
+{
+   std::filesystem::path const program{ argc > 1 ? argv[1] : FRONES_FUNCTIONAL_TEST };
+   std::ifstream file{ program, std::ios::binary };
+   if (not file)
+   {
+      std::println(std::cerr, "usage: {} [functional test binary]", argv[0]);
+      return EXIT_FAILURE;
+   }
+
+   std::vector<nes::Byte> const functional_test{ std::istreambuf_iterator<char>{ file }, {} };
+   nes::Locator::provide<nes::Logger>();
+
+   benchmark({
+      .name{ "functional test, the same in every lane" },
+      .load{
+         [&functional_test](std::size_t, std::span<nes::Byte, nes::LockstepBatch::MEMORY_SIZE> const memory)
+         {
+            std::size_t const size{ std::min(functional_test.size(), memory.size() - 0x00'0A) };
+            std::ranges::copy(std::span{ functional_test }.first(size), memory.begin() + 0x00'0A);
+         }
+      }
+   });
+
+   benchmark({
+      .name{ "CRC-8, different data in every lane" },
+      .load{
+         [](std::size_t const lane, std::span<nes::Byte, nes::LockstepBatch::MEMORY_SIZE> const memory)
+         {
+            std::ranges::copy(CRC_PROGRAM, memory.begin() + START);
+            memory[0x00'12] = PASSES;
+            std::uint32_t state{ static_cast<std::uint32_t>(0x2545'F491 + lane * 0x9E37'79B9) };
+            for (nes::Byte& byte : memory.subspan(0x02'00, 0x01'00))
+            {
+               state ^= state << 13;
+               state ^= state >> 17;
+               state ^= state << 5;
+               byte = static_cast<nes::Byte>(state);
+            }
+         }
+      }
+   });
+
+   nes::Locator::remove_providers();
+   return EXIT_SUCCESS;
+}
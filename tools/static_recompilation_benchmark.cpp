@@ -0,0 +1,131 @@
+#include "hardware/memory/memory.hpp"
+#include "hardware/processor/opcode_info.hpp"
+#include "hardware/processor/processor.hpp"
+#include "hardware/processor/profiler.hpp"
+#include "hardware/processor/static_translation.hpp"
+#include "services/locator.hpp"
+#include "services/logger/logger.hpp"
+
+namespace nes
+{
+   // generated by the static recompiler from the functional test at build time
+   extern std::span<StaticTranslation::Block const> const functional_test;
+}
+
+namespace
+{
+   struct Configuration final
+   {
+      std::string_view name;
+      nes::Processor::Core core;
+      bool translated;
+      bool fused;
+   };
+
+   std::size_t constexpr REPETITIONS{ 3 };
+   std::size_t constexpr REPORTED_PAIRS{ 10 };
+
+   // runs the functional test from its start to the trap it ends in, which is at $336D when it succeeds, and reports
+   // the fastest of the repetitions
+   void benchmark(Configuration const& configuration, std::filesystem::path const& program)
+   {
+      std::chrono::duration<double> fastest{ std::numeric_limits<double>::max() };
+      for (std::size_t repetition{}; repetition < REPETITIONS; ++repetition)
+      {
+         auto const memory{ std::make_unique<nes::Memory>() };
+         memory->load_program(program, 0x00'0A);
+
+         nes::Processor processor{ *memory, configuration.core };
+         processor.set_fusion(configuration.fused);
+         while (not processor.tick().value())
+            ;
+
+         std::optional<nes::StaticTranslation> translation{};
+         if (configuration.translated)
+            processor.set_static_translation(&translation.emplace(*memory, nes::functional_test));
+
+         processor.program_counter = 0x04'00;
+         auto const start{ std::chrono::steady_clock::now() };
+         while (processor.run(1'000'000))
+            ;
+
+         fastest = std::min<std::chrono::duration<double>>(fastest, std::chrono::steady_clock::now() - start);
+         if (repetition + 1 < REPETITIONS)
+            continue;
+
+         std::println("{:<22}{:>10} cycles {:>7.3f} s {:>7.1f} MHz", configuration.name, processor.cycle(),
+            fastest.count(), processor.cycle() / fastest.count() / 1'000'000);
+         std::println("{:<22}trapped at ${:04X}, A={:02X} X={:02X} Y={:02X} P={:02X}", "",
+            processor.halt_reason()->program_counter, processor.accumulator(), processor.x(), processor.y(),
+            processor.processor_status());
+
+         if (translation)
+            std::println("{:<22}{} of {} blocks valid, {} runs, {} invalidations", "", translation->valid_blocks(),
+               nes::functional_test.size(), translation->runs(), translation->invalidations());
+
+         if (configuration.fused)
+            std::println("{:<22}{} fused sequences", "", processor.fusions());
+      }
+   }
+
+   // runs the functional test on the instruction-stepped core with a profiler attached, and reports the pairs of
+   // instructions that fusion has the most to gain on
+   void profile(std::filesystem::path const& program)
+   {
+      auto const memory{ std::make_unique<nes::Memory>() };
+      memory->load_program(program, 0x00'0A);
+
+      nes::Processor processor{ *memory, nes::Processor::Core::INSTRUCTION_STEPPED };
+      while (not processor.tick().value())
+         ;
+
+      nes::Profiler profiler{};
+      processor.attach(&profiler);
+      processor.program_counter = 0x04'00;
+      while (processor.run(1'000'000))
+         ;
+
+      processor.attach(nullptr);
+      std::size_t instructions{};
+      for (nes::Profiler::Entry const& entry : profiler.report())
+         instructions += entry.count;
+
+      std::vector<nes::Profiler::Pair> const pairs{ profiler.pair_report() };
+      std::println("most frequent pairs of {} instructions", instructions);
+      for (nes::Profiler::Pair const& pair : std::span{ pairs }.first(std::min(pairs.size(), REPORTED_PAIRS)))
+         std::println("  {} ${:02X}, {} ${:02X}{:>12} {:>5.1f}%", nes::OPCODE_INFOS[pair.first].mnemonic, pair.first,
+            nes::OPCODE_INFOS[pair.second].mnemonic, pair.second, pair.count,
+            100.0 * static_cast<double>(pair.count) / static_cast<double>(instructions));
+   }
+}
+
+// Compares how fast the functional test runs translated ahead of time with how fast the processor runs it otherwise,
+// with and without fusion, and reports the pairs of instructions it runs most
+int main(int const argc, char** const argv)
+{
+   std::filesystem::path const program{ argc > 1 ? argv[1] : FRONES_FUNCTIONAL_TEST };
+   if (not exists(program))
+   {
+      std::println(std::cerr, "usage: {} [functional test binary]", argv[0]);
+      return EXIT_FAILURE;
+   }
+
+   nes::Locator::provide<nes::Logger>();
+
+   std::array<Configuration, 6> constexpr CONFIGURATIONS{ {
+      { "instruction-stepped", nes::Processor::Core::INSTRUCTION_STEPPED, false, false },
+      { "predecoded", nes::Processor::Core::PREDECODED, false, false },
+      { "predecoded, fused", nes::Processor::Core::PREDECODED, false, true },
+      { "recompiled", nes::Processor::Core::RECOMPILED, false, false },
+      { "recompiled, fused", nes::Processor::Core::RECOMPILED, false, true },
+      { "statically translated", nes::Processor::Core::PREDECODED, true, false }
+   } };
+
+   for (Configuration const& configuration : CONFIGURATIONS)
+      benchmark(configuration, program);
+
+   profile(program);
+
+   nes::Locator::remove_providers();
+   return EXIT_SUCCESS;
+}
\ No newline at end of file
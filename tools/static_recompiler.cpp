@@ -0,0 +1,67 @@
+#include "hardware/memory/memory.hpp"
+#include "hardware/processor/static_recompiler.hpp"
+#include "services/locator.hpp"
+#include "services/logger/logger.hpp"
+
+// Translates a program ahead of time into a C++ translation unit for a StaticTranslation:
+// static_recompiler <program> <load address> <name> <output> <entry point>..., the addresses being hexadecimal
+int main(int const argc, char** const argv)
+{
+   if (argc < 6)
+   {
+      std::println(std::cerr, "usage: {} <program> <load address> <name> <output> <entry point>...", argv[0]);
+      return EXIT_FAILURE;
+   }
+
+   auto const parse_address{
+      [](std::string_view const text) -> std::optional<nes::Word>
+      {
+         nes::Word address{};
+         auto const [end, error]{ std::from_chars(text.data(), text.data() + text.size(), address, 16) };
+         if (error not_eq std::errc{} or end not_eq text.data() + text.size())
+            return std::nullopt;
+
+         return address;
+      }
+   };
+
+   std::filesystem::path const program{ argv[1] };
+   std::optional const load_address{ parse_address(argv[2]) };
+   if (not exists(program) or not load_address)
+   {
+      std::println(std::cerr, "cannot load {} at {}", program.string(), argv[2]);
+      return EXIT_FAILURE;
+   }
+
+   nes::Locator::provide<nes::Logger>();
+
+   auto const memory{ std::make_unique<nes::Memory>() };
+   memory->load_program(program, *load_address);
+
+   nes::StaticRecompiler recompiler{ *memory };
+   for (int argument{ 5 }; argument < argc; ++argument)
+   {
+      std::optional const entry_point{ parse_address(argv[argument]) };
+      if (not entry_point)
+      {
+         std::println(std::cerr, "{} is not an address", argv[argument]);
+         return EXIT_FAILURE;
+      }
+
+      recompiler.trace(*entry_point);
+   }
+
+   std::ofstream output{ argv[4] };
+   output << recompiler.generate(argv[3]);
+   if (not output)
+   {
+      std::println(std::cerr, "cannot write {}", argv[4]);
+      return EXIT_FAILURE;
+   }
+
+   std::println("{}: {} blocks translated from {} traced instructions", argv[4], recompiler.blocks().size(),
+      recompiler.traced_instructions());
+
+   nes::Locator::remove_providers();
+   return EXIT_SUCCESS;
+}
\ No newline at end of file